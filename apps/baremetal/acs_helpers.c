@@ -22,6 +22,9 @@
 #include "val/include/acs_memory.h"
 #include "val/include/acs_dma.h"
 #include "acs.h"
+#ifdef ACS_UART_TX_IRQ
+#include "pal/baremetal/base/include/pal_pl011_uart.h"
+#endif
 
 void
 createIoVirtInfoTable(
@@ -98,6 +101,13 @@ createGicInfoTable(
 
     Status = val_gic_create_info_table(GicInfoTable);
 
+#ifdef ACS_UART_TX_IRQ
+    /* Drain the console TX ring from the UART TX interrupt once the GIC is up */
+    if ((Status == ACS_STATUS_PASS) && (UART_PL011_TX_INTID != 0) &&
+        (val_gic_install_isr(UART_PL011_TX_INTID, pal_uart_tx_isr) == 0))
+        pal_uart_tx_irq_enable(1);
+#endif
+
     return Status;
 }
 
@@ -169,6 +169,7 @@ acs_load_execution_policy_defaults(acs_execution_policy_t *policy)
       policy->timeout_pass = defaults->timeout_pass;
       policy->timeout_fail = defaults->timeout_fail;
       policy->timer_timeout_us = defaults->timer_timeout_us;
+      policy->timeout_scale = defaults->timeout_scale;
       policy->crypto_support = defaults->crypto_support;
       policy->sys_last_lvl_cache = defaults->sys_last_lvl_cache;
       policy->el1skiptrap_mask = defaults->el1skiptrap_mask;
@@ -192,6 +193,8 @@ acs_load_execution_policy_defaults(acs_execution_policy_t *policy)
       policy->timeout_fail = platform_defaults->timeout_fail;
   if (platform_defaults->timer_timeout_us != 0u)
       policy->timer_timeout_us = platform_defaults->timer_timeout_us;
+  if (platform_defaults->timeout_scale != 0u)
+      policy->timeout_scale = platform_defaults->timeout_scale;
 }
 
 void
@@ -420,6 +423,31 @@ acs_apply_compile_params(acs_run_request_t *ctx, acs_execution_policy_t *policy)
     policy->print_level = FATAL;
 #endif
 
+#ifdef ACS_PE_POOL
+  /*
+   * Compile-time opt-in to keep secondary PEs parked in WFE between test
+   * payloads instead of PSCI CPU_ON/CPU_OFF (via CMake `-DACS_PE_POOL=ON`).
+   */
+  policy->pe_pool = 1;
+#endif
+
+#ifdef ACS_RESUME
+  /*
+   * Compile-time opt-in to checkpoint progress in the platform checkpoint
+   * region and resume an interrupted run (via CMake `-DACS_RESUME=ON`).
+   */
+  policy->resume = 1;
+#endif
+
+#ifdef ACS_RESULT_SINK
+  /*
+   * Compile-time selection of the JSON-lines rule result stream
+   * (via CMake `-DACS_RESULT_SINK=<mem|uart>`): kept in memory, or written
+   * to the platform result UART (PLATFORM_RESULT_UART_BASE).
+   */
+  policy->result_sink = ACS_RESULT_SINK;
+#endif
+
   /*
    * Compile-time compliance level override (via CMake `-DACS_LEVEL=<n|fr>`):
    *
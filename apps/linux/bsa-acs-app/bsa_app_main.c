@@ -32,6 +32,9 @@
 /* Global extern for rule ID string map (defined in val/src/rule_enum_string_map.c) */
 extern char *rule_id_string[RULE_ID_SENTINEL];
 
+/* Rule name hash lookup (defined in val/src/rule_registry.c) */
+extern uint32_t rule_id_from_name(const char *name);
+
 /* Legacy numeric skip support kept inert for compatibility with other files */
 unsigned int  *g_skip_test_num;
 unsigned int  g_sw_view[3] = {1, 1, 1}; //Operating System, Hypervisor, Platform Security
@@ -41,37 +44,15 @@ static RULE_ID_e g_skip_rule_buf[BSA_RULE_ID_LIST_MAX];
 static unsigned int g_skip_rule_count;
 
 /*  Helpers for rule parsing  */
-static int sizeof_char_ptr(const char *tok)
-{
-  int i = 0;
-
-  if (tok)
-  {
-    while (tok[i] != '\0')
-      i++;
-  }
-  return i;
-
-}
-
 static int rule_id_from_string(const char *tok)
 {
     unsigned int rid;
-    int cmp_len;
 
     if (!tok || !*tok) return -1;
-    for (rid = 0; rid < RULE_ID_SENTINEL; rid++) {
-        if (!rule_id_string[rid])
-            continue;
-
-        cmp_len = sizeof_char_ptr(rule_id_string[rid]);
-        if (cmp_len < sizeof_char_ptr(tok))
-            cmp_len = sizeof_char_ptr(tok);
-
-        if (strncmp((const char *)rule_id_string[rid], tok, cmp_len) == 0)
-            return (int)rid;
-    }
-    return -1;
+    rid = rule_id_from_name(tok);
+    if (rid >= RULE_ID_SENTINEL)
+        return -1;
+    return (int)rid;
 }
 
 static void skip_list_append(RULE_ID_e rid)
@@ -91,6 +91,7 @@ uint32_t command_init(void);
 #ifndef EXCLUDE_RBX
 /* Extern declarations */
 extern SHELL_FILE_HANDLE g_acs_log_file_handle;
+extern SHELL_FILE_HANDLE g_acs_result_file_handle;
 extern SHELL_FILE_HANDLE g_dtb_log_file_handle;
 extern BOOLEAN    g_invalid_arg_seen;
 extern CONST SHELL_PARAM_ITEM ParamList[];
@@ -142,20 +142,18 @@ static VOID map_and_add_rule_token(
     for (i = 0; i < tlen; i++) wbuf[i] = start[i];
     wbuf[tlen] = L'\0';
 
-    /* Convert to ASCII for comparison with rule_id_string */
+    /* Convert to ASCII for lookup in the rule name hash */
     i = 0;
     for (; i < tlen && i < (sizeof(abuf) - 1); i++)
         abuf[i] = (CHAR8)(wbuf[i] & 0xFF);
     abuf[i] = '\0';
 
-    for (rid = 0; rid < RULE_ID_SENTINEL; rid++) {
-        if (rule_id_string[rid] &&
-                ascii_streq((CHAR8 *)rule_id_string[rid], abuf)) {
-            if (*count < capacity) {
-                list[(*count)++] = (RULE_ID_e)rid;
-            }
-            return;
+    rid = rule_id_from_name((const char *)abuf);
+    if (rid < RULE_ID_SENTINEL) {
+        if (*count < capacity) {
+            list[(*count)++] = (RULE_ID_e)rid;
         }
+        return;
     }
 
     /* Not found: print invalid once for visibility */
@@ -600,6 +598,16 @@ command_init (void)
               policy->timeout_pass, policy->timeout_fail);
     }
 
+    /* Scale of the wait deadlines, in percent */
+    CmdLineArg = ShellCommandLineGetValue(ParamPackage, L"-timeout_scale");
+    if (CmdLineArg != NULL) {
+        policy->timeout_scale = (UINT32)StrDecimalToUintn(CmdLineArg);
+        if (policy->timeout_scale == 0) {
+            Print(L"Invalid -timeout_scale: provide a percentage above 0\n");
+            return SHELL_INVALID_PARAMETER;
+        }
+    }
+
     /* Parse verbosity level */
     CmdLineArg  = ShellCommandLineGetValue (ParamPackage, L"-v");
     if (CmdLineArg == NULL) {
@@ -675,6 +683,70 @@ command_init (void)
     if ((ShellCommandLineGetFlag (ParamPackage, L"-no_crypto_ext")))
         policy->crypto_support = FALSE;
 
+    /* Keep secondary PEs parked between payloads */
+    if ((ShellCommandLineGetFlag (ParamPackage, L"-pepool")))
+        policy->pe_pool = 1;
+
+    /* -results file option, machine-readable rule result records */
+    CmdLineArg  = ShellCommandLineGetValue (ParamPackage, L"-results");
+    if (CmdLineArg == NULL) {
+        g_acs_result_file_handle = NULL;
+    } else {
+        Status = ShellOpenFileByName(CmdLineArg, &g_acs_result_file_handle,
+                            EFI_FILE_MODE_WRITE | EFI_FILE_MODE_READ | EFI_FILE_MODE_CREATE, 0x0);
+        if (EFI_ERROR(Status)) {
+            Print(L"Failed to open result file %s\n", CmdLineArg);
+            g_acs_result_file_handle = NULL;
+        } else {
+            policy->result_sink = ACS_RESULT_SINK_PAL;
+        }
+    }
+
+    /* Checkpoint progress and resume an interrupted run */
+    if ((ShellCommandLineGetFlag (ParamPackage, L"-resume")))
+        policy->resume = 1;
+
+    /* Quick run: time budget in seconds */
+    CmdLineArg = ShellCommandLineGetValue(ParamPackage, L"-budget");
+    if (CmdLineArg != NULL) {
+        ctx->time_budget_us = (UINT64)StrDecimalToUintn(CmdLineArg) * 1000000;
+        if (ctx->time_budget_us == 0) {
+            Print(L"Invalid -budget: provide the time budget in seconds\n");
+            return SHELL_INVALID_PARAMETER;
+        }
+    }
+
+    /* Rule cost profile for -budget, the log of an earlier run */
+    CmdLineArg = ShellCommandLineGetValue(ParamPackage, L"-profile");
+    if (CmdLineArg != NULL) {
+        rfile = NULL;
+        if (!try_open_readonly(CmdLineArg, &rfile)) {
+            Print(L"Failed to open profile file %s\n", CmdLineArg);
+            return SHELL_INVALID_PARAMETER;
+        }
+
+        raw = NULL;
+        raw_len = 0;
+        RS = read_all_bytes(rfile, &raw, &raw_len);
+        ShellCloseFile(&rfile);
+        if (EFI_ERROR(RS)) {
+            Print(L"Failed to read profile file %s\n", CmdLineArg);
+            return ACS_STATUS_ERR;
+        }
+
+        ctx->rule_cost_us = (UINT32 *)val_memory_calloc(RULE_ID_SENTINEL, sizeof(UINT32));
+        if (ctx->rule_cost_us == NULL) {
+            Print(L"Allocate memory for -profile failed\n");
+            gBS->FreePool(raw);
+            return ACS_STATUS_ERR;
+        }
+        ctx->rule_cost_owned = true;
+
+        if (rule_cost_profile_parse((CHAR8 *)raw, (UINT32)raw_len, ctx->rule_cost_us) == 0)
+            Print(L"No PROFILE,RULE entries found in %s\n", CmdLineArg);
+        gBS->FreePool(raw);
+    }
+
 
     /* Options with Values: -r <comma-separated rule IDs or rules file> */
     if (ShellCommandLineGetFlag(ParamPackage, L"-r")) {
@@ -29,6 +29,7 @@
 
 /* CLI parameter table for BSA ACS, for description refer HelpMsg */
 CONST SHELL_PARAM_ITEM ParamList[] = {
+    {L"-budget", TypeValue},
     {L"-cache", TypeFlag},
     {L"-dtb", TypeValue},
     {L"-el1skiptrap", TypeValue},
@@ -44,12 +45,17 @@ CONST SHELL_PARAM_ITEM ParamList[] = {
     {L"-only", TypeValue},
     {L"-os", TypeFlag},
     {L"-p2p", TypeFlag},
+    {L"-pepool", TypeFlag},
+    {L"-profile", TypeValue},
     {L"-ps", TypeFlag},
     {L"-r", TypeValue},
+    {L"-results", TypeValue},
+    {L"-resume", TypeFlag},
     {L"-skip", TypeValue},
     {L"-skip-dp-nic-ms", TypeFlag},
     {L"-skipmodule", TypeValue},
     {L"-timeout", TypeValue},
+    {L"-timeout_scale", TypeValue},
     {L"-v", TypeValue},
     {NULL, TypeMax}
 };
@@ -61,6 +67,9 @@ HelpMsg (VOID)
 {
     Print (L"\nUsage: Bsa.efi [options]\n"
         "Options:\n"
+        "-budget <seconds>\n"
+        "        Quick run: select the rules that fit in the time budget, cheapest\n"
+        "        first, and stop starting rules once it is used up. See -profile\n"
         "-cache  Pass this flag to indicate that if the test system supports\n"
         "        PCIe address translation cache\n"
         "-dtb    Pass this flag to dump DTB file (Device Tree Blob) \n"
@@ -88,10 +97,18 @@ HelpMsg (VOID)
         "        Pass -hyp to run BSA Hypervisior software view tests.\n"
         "        Pass -ps  to run BSA Platform security software view tests.\n"
         "-p2p    Pass this flag to indicate that PCIe Hierarchy Supports Peer-to-Peer\n"
+        "-pepool Keep secondary PEs parked between test payloads instead of\n"
+        "        PSCI CPU_ON/CPU_OFF for each payload\n"
+        "-profile <file>\n"
+        "        Rule costs for -budget, a log of an earlier run at -v 2\n"
         "-r      Run tests for passed comma-separated Rule IDs or a rules file\n"
         "        Examples: -r B_PE_01,B_PE_02,B_GIC_01\n"
         "                  -r rules.txt  (file may mix commas/newlines; lines \n"
         "                     starting with # are comments)\n"
+        "-results <file>\n"
+        "        Write one JSON result record per rule to the file, at any -v level\n"
+        "-resume Checkpoint progress after each rule and resume an interrupted run,\n"
+        "        marking the rule that did not complete as failed\n"
         "-skip   Rule ID(s) to be skipped (comma-separated, like -r)\n"
         "        Example: -skip B_PE_01,B_GIC_02\n"
         "-skip-dp-nic-ms \n"
@@ -102,6 +119,9 @@ HelpMsg (VOID)
         "-timeout <microseconds> \n"
         "        Set pass timeout (delay in microseconds) for wakeup & WD & timer tests (500us - 2sec)\n"
         "        Example: -timeout 2000 \n"
+        "-timeout_scale <percent>\n"
+        "        Scale the wait deadlines of tests, e.g. 1000 on slow models (default 100)\n"
+        "        Example: -timeout_scale 400\n"
         "-v <n>  Verbosity of the prints\n"
         "        1 prints all, 5 prints only the errors\n");
 }
@@ -234,6 +254,10 @@ exit_acs:
         ShellCloseFile(&g_acs_log_file_handle);
     }
 
+    if (g_acs_result_file_handle) {
+        ShellCloseFile(&g_acs_result_file_handle);
+    }
+
     if (g_stack_pointer) {
         val_pe_context_restore(AA64WriteSp(g_stack_pointer));
     }
@@ -30,6 +30,7 @@
 
 /* CLI parameter table for PCBSA ACS, for description refer HelpMsg */
 CONST SHELL_PARAM_ITEM ParamList[] = {
+    {L"-budget", TypeValue},
     {L"-el1skiptrap", TypeValue},
     {L"-f", TypeValue},
     {L"-fr", TypeValue},
@@ -39,11 +40,16 @@ CONST SHELL_PARAM_ITEM ParamList[] = {
     {L"-m", TypeValue},
     {L"-mmio", TypeFlag},
     {L"-only", TypeValue},
+    {L"-pepool", TypeFlag},
+    {L"-profile", TypeValue},
     {L"-r", TypeValue},
+    {L"-results", TypeValue},
+    {L"-resume", TypeFlag},
     {L"-skip", TypeValue},
     {L"-skip-dp-nic-ms", TypeFlag},
     {L"-skipmodule", TypeValue},
     {L"-timeout", TypeValue},
+    {L"-timeout_scale", TypeValue},
     {L"-v", TypeValue},
     {NULL, TypeMax}
 };
@@ -55,6 +61,9 @@ HelpMsg (VOID)
 {
     Print (L"\nUsage: PcBsa.efi [options]\n"
         "Options:\n"
+        "-budget <seconds>\n"
+        "        Quick run: select the rules that fit in the time budget, cheapest\n"
+        "        first, and stop starting rules once it is used up. See -profile\n"
         "-el1skiptrap <list>\n"
         "        Skip specific EL1 register reads known to trap by the hypervisor.\n"
         "        Tokens: cntpct, devmem, pmsidr\n"
@@ -74,6 +83,14 @@ HelpMsg (VOID)
         "                     starting with # are comments)\n"
         "-only <n> \n"
         "        Only run tests for rules at level <n> \n"
+        "-pepool Keep secondary PEs parked between test payloads instead of\n"
+        "        PSCI CPU_ON/CPU_OFF for each payload\n"
+        "-profile <file>\n"
+        "        Rule costs for -budget, a log of an earlier run at -v 2\n"
+        "-results <file>\n"
+        "        Write one JSON result record per rule to the file, at any -v level\n"
+        "-resume Checkpoint progress after each rule and resume an interrupted run,\n"
+        "        marking the rule that did not complete as failed\n"
         "-skip   Rule ID(s) to be skipped (comma-separated, like -r)\n"
         "        Example: -skip B_PE_01,B_GIC_02\n"
         "-skip-dp-nic-ms \n"
@@ -84,6 +101,9 @@ HelpMsg (VOID)
         "-timeout <microseconds> \n"
         "        Set pass timeout (delay in microseconds) for wakeup & WD & timer tests (500us - 2sec)\n"
         "        Example: -timeout 2000 \n"
+        "-timeout_scale <percent>\n"
+        "        Scale the wait deadlines of tests, e.g. 1000 on slow models (default 100)\n"
+        "        Example: -timeout_scale 400\n"
         "-v <n>  Verbosity of the prints\n"
         "        1 prints all, 5 prints only the errors\n");
 }
@@ -215,6 +235,10 @@ exit_acs:
         ShellCloseFile(&g_acs_log_file_handle);
     }
 
+    if (g_acs_result_file_handle) {
+        ShellCloseFile(&g_acs_result_file_handle);
+    }
+
     val_pe_context_restore(AA64WriteSp(g_stack_pointer));
     return ACS_STATUS_PASS;
 }
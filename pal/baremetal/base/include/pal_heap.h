@@ -0,0 +1,87 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#ifndef __PAL_HEAP_H_
+#define __PAL_HEAP_H_
+
+#include <stddef.h>
+#include "acs_stdint.h"
+
+#define MEM_BLOCK_SIGNATURE  0x4D424C4B  /* MBLK */
+#define MEM_FOOT_SIGNATURE   0x4D465452  /* MFTR */
+#define MEM_MIN_ALIGNMENT    sizeof(void *)
+#define HEAP_INIT_FAILED     0U
+#define HEAP_INIT_SUCCESS    1U
+#define HEAP_INITIALISED     0xDC
+
+/*
+ * Free blocks are kept in segregated lists, two-level as in TLSF: the first
+ * level is the power of two of the block size, the second level splits each
+ * power of two into HEAP_SL_COUNT equal classes. Sizes below
+ * HEAP_SMALL_BLOCK_SIZE share the first list in classes of
+ * HEAP_SMALL_BLOCK_SIZE / HEAP_SL_COUNT bytes.
+ */
+#define HEAP_SL_LOG2           4
+#define HEAP_SL_COUNT          (1U << HEAP_SL_LOG2)
+#define HEAP_FL_SHIFT          (HEAP_SL_LOG2 + 3)
+#define HEAP_SMALL_BLOCK_SIZE  ((size_t)1 << HEAP_FL_SHIFT)
+#define HEAP_FL_COUNT          34  /* blocks below 1TB */
+
+#define __ADDR_ALIGN_MASK(a, mask)  (((uintptr_t)(a) + (uintptr_t)(mask)) & \
+                                     ~((uintptr_t)(mask)))
+#define ADDR_ALIGN(a, b)            __ADDR_ALIGN_MASK(a, (uintptr_t)(b) - 1U)
+
+typedef struct mem_block_header {
+  uint32_t                 signature;
+  uint32_t                 is_free;
+  size_t                   size;
+  uintptr_t                payload;
+  struct mem_block_header  *prev_phys;
+  struct mem_block_header  *next_phys;
+  struct mem_block_header  *prev_free;
+  struct mem_block_header  *next_free;
+} MEM_BLOCK_HEADER;
+
+typedef struct {
+  uint32_t  signature;
+  uint32_t  reserved;
+  size_t    size;
+} MEM_BLOCK_FOOTER;
+
+#define MEM_MIN_BLOCK_SIZE          ADDR_ALIGN(sizeof(MEM_BLOCK_HEADER) + \
+                                               sizeof(MEM_BLOCK_HEADER *) + \
+                                               sizeof(MEM_BLOCK_FOOTER) + \
+                                               MEM_MIN_ALIGNMENT, \
+                                               MEM_MIN_ALIGNMENT)
+
+/* Heap statistics, sizes include the block metadata */
+typedef struct {
+  uint64_t heap_size;
+  uint64_t in_use;          /* bytes held by allocated blocks */
+  uint64_t peak_in_use;     /* high-water mark of in_use */
+  uint64_t largest_free;    /* largest free block */
+  uint32_t free_blocks;
+  uint32_t alloc_count;     /* allocations currently outstanding */
+  uint32_t alloc_failures;
+  uint32_t fragmentation;   /* percent of free bytes outside the largest free block */
+} PAL_HEAP_STATS;
+
+void *mem_alloc(size_t alignment, size_t size);
+void mem_free(void *ptr);
+uint32_t pal_mem_get_heap_stats(PAL_HEAP_STATS *stats);
+
+#endif /* __PAL_HEAP_H_ */
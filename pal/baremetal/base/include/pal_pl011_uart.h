@@ -54,6 +54,22 @@ typedef struct {
 #define UART_PL011_UARTCR_TX_EN_MASK       (0x1u << UART_PL011_UARTCR_TXE_OFF)
 #define UART_PL011_UARTFR_TX_FIFO_FULL_OFF 0x5u
 #define UART_PL011_UARTFR_TX_FIFO_FULL     (0x1u << UART_PL011_UARTFR_TX_FIFO_FULL_OFF)
+#define UART_PL011_UARTFR_BUSY_OFF         0x3u
+#define UART_PL011_UARTFR_BUSY             (0x1u << UART_PL011_UARTFR_BUSY_OFF)
+#define UART_PL011_UARTFR_TX_FIFO_EMPTY_OFF 0x7u
+#define UART_PL011_UARTFR_TX_FIFO_EMPTY    (0x1u << UART_PL011_UARTFR_TX_FIFO_EMPTY_OFF)
+/*
+ * TX FIFO entries, written in one burst once the FIFO reports empty with
+ * ACS_UART_TX_BUFFERED. 16 before PL011 r1p5, 32 from r1p5.
+ */
+#ifdef UART_TX_FIFO_DEPTH
+#define UART_PL011_TX_FIFO_DEPTH           UART_TX_FIFO_DEPTH
+#else
+#define UART_PL011_TX_FIFO_DEPTH           16
+#endif
+/* TX interrupt when the FIFO drains to 1/8 full */
+#define UART_PL011_UARTIFLS_TX_1_8         0x0u
+#define UART_PL011_UARTIFLS_TX_MASK        0x7u
 
 #define UART_PL011_INTR_TX_OFF             0x5u
 #define UART_PL011_TX_INTR_MASK            (0x1u << UART_PL011_INTR_TX_OFF)
@@ -66,9 +82,26 @@ typedef struct {
 #define PLATFORM_UART_BASE        BASE_ADDRESS_ADDRESS
 #define UART_PL011_CLK_IN_HZ      UART_CLK_IN_HZ
 #define UART_PL011_BAUDRATE       UART_BAUD_RATE_BPS
+#define UART_PL011_TX_INTID       UART_GLOBAL_SYSTEM_INTERRUPT
+
+/*
+ * Console TX ring (ACS_UART_TX_BUFFERED). Characters are queued and
+ * written to the FIFO in bursts, drained from the UART TX interrupt with
+ * ACS_UART_TX_IRQ, and pushed out by pal_print_flush().
+ */
+#ifndef ACS_UART_TX_RING_SIZE
+#define ACS_UART_TX_RING_SIZE     4096   /* power of two */
+#endif
+/* Flag register reads without FIFO progress before queued output is dropped */
+#define UART_PL011_TX_STALL_LIMIT 0x1000000u
 
 /* function prototypes */
 extern void pal_driver_uart_pl011_putc(int c);
 void pal_uart_putc(char c);
+void pal_driver_uart_pl011_write(uint64_t uart_base_addr, const char *buf, uint32_t len);
+void pal_uart_flush(void);
+void pal_uart_get_tx_stats(uint64_t *stalled, uint64_t *dropped);
+void pal_uart_tx_isr(void);
+void pal_uart_tx_irq_enable(uint32_t enable);
 
 #endif /* _PAL_UART_PL011_H_ */
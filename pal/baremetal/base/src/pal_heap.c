@@ -0,0 +1,564 @@
+/** @file
+ * Copyright (c) 2023-2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#include "acs_stdint.h"
+#include "pal_heap.h"
+#include "pal_status.h"
+#include "platform_image_def.h"
+
+/*
+ * Heap allocator overview:
+ * - The heap is represented as address-ordered blocks. Each block has a
+ *   header at the start and a footer at the end.
+ * - Free blocks are linked into segregated lists by size class (see
+ *   pal_heap.h). Two bitmaps record the non-empty lists, so a list holding
+ *   blocks large enough for a request is found with two bit scans, and
+ *   mem_alloc() and mem_free() take constant time whatever the heap state.
+ * - mem_alloc() searches the class above the request, so any block of that
+ *   list fits. The payload is placed after the header and hidden owner
+ *   pointer and aligned; when the alignment leaves room for a block in front
+ *   of it, that room is split off as a free block instead of being wasted.
+ *   Any usable remainder after the payload is split into a free block too.
+ * - mem_free() recovers the owning block from the hidden pointer stored before
+ *   the payload, validates header/footer metadata, marks the block free, then
+ *   coalesces adjacent free blocks before inserting the final block into its
+ *   list. Free blocks are therefore never adjacent.
+ */
+
+static MEM_BLOCK_HEADER *g_heap_free[HEAP_FL_COUNT][HEAP_SL_COUNT];
+static uint64_t          g_heap_fl_bitmap;
+static uint32_t          g_heap_sl_bitmap[HEAP_FL_COUNT];
+static uint64_t          heap_base;
+static uint64_t          heap_top;
+static uint8_t           heap_init_done;
+static PAL_HEAP_STATS    g_heap_stats;
+
+/**
+  @brief  Check whether a value is a power of two.
+
+  @param  value  Value to check.
+
+  @return 1 if value is a power of two, 0 otherwise.
+**/
+static uint32_t
+is_power_of_2(size_t value)
+{
+  return value && ((value & (value - 1)) == 0);
+}
+
+static inline uint32_t
+heap_fls(uint64_t value)
+{
+  return 63U - (uint32_t)__builtin_clzll(value);
+}
+
+static inline uint32_t
+heap_ffs(uint64_t value)
+{
+  return (uint32_t)__builtin_ctzll(value);
+}
+
+/**
+  @brief  Get the list of a free block size.
+
+  @param  size  Block size.
+  @param  fl    First level index.
+  @param  sl    Second level index.
+
+  @return None
+**/
+static void
+heap_mapping_insert(size_t size, uint32_t *fl, uint32_t *sl)
+{
+  uint32_t msb;
+
+  if (size < HEAP_SMALL_BLOCK_SIZE) {
+    *fl = 0;
+    *sl = (uint32_t)(size / (HEAP_SMALL_BLOCK_SIZE / HEAP_SL_COUNT));
+    return;
+  }
+
+  msb = heap_fls(size);
+  *fl = msb - (HEAP_FL_SHIFT - 1U);
+  *sl = (uint32_t)(size >> (msb - HEAP_SL_LOG2)) ^ HEAP_SL_COUNT;
+
+  /* Larger blocks than the lists cover all share the last list */
+  if (*fl >= HEAP_FL_COUNT) {
+    *fl = HEAP_FL_COUNT - 1U;
+    *sl = HEAP_SL_COUNT - 1U;
+  }
+}
+
+/**
+  @brief  Get the first list whose blocks are all at least size bytes.
+
+  @param  size  Requested block size.
+  @param  fl    First level index.
+  @param  sl    Second level index.
+
+  @return 1 if the lists cover the size, 0 otherwise.
+**/
+static uint32_t
+heap_mapping_search(size_t size, uint32_t *fl, uint32_t *sl)
+{
+  if (size >= HEAP_SMALL_BLOCK_SIZE) {
+    size += ((size_t)1 << (heap_fls(size) - HEAP_SL_LOG2)) - 1U;
+    if (heap_fls(size) - (HEAP_FL_SHIFT - 1U) >= HEAP_FL_COUNT) {
+      return 0;
+    }
+  }
+
+  heap_mapping_insert(size, fl, sl);
+  return 1;
+}
+
+/**
+  @brief  Add a free block to the head of its list.
+
+  @param  block  Free block.
+
+  @return None
+**/
+static void
+heap_insert_free(MEM_BLOCK_HEADER *block)
+{
+  uint32_t fl;
+  uint32_t sl;
+
+  heap_mapping_insert(block->size, &fl, &sl);
+
+  block->prev_free = NULL;
+  block->next_free = g_heap_free[fl][sl];
+  if (block->next_free != NULL) {
+    block->next_free->prev_free = block;
+  }
+  g_heap_free[fl][sl] = block;
+
+  g_heap_fl_bitmap |= (uint64_t)1 << fl;
+  g_heap_sl_bitmap[fl] |= 1U << sl;
+  g_heap_stats.free_blocks++;
+}
+
+/**
+  @brief  Remove a free block from its list.
+
+  @param  block  Free block.
+
+  @return None
+**/
+static void
+heap_remove_free(MEM_BLOCK_HEADER *block)
+{
+  uint32_t fl;
+  uint32_t sl;
+
+  heap_mapping_insert(block->size, &fl, &sl);
+
+  if (block->prev_free != NULL) {
+    block->prev_free->next_free = block->next_free;
+  } else {
+    g_heap_free[fl][sl] = block->next_free;
+    if (g_heap_free[fl][sl] == NULL) {
+      g_heap_sl_bitmap[fl] &= ~(1U << sl);
+      if (g_heap_sl_bitmap[fl] == 0) {
+        g_heap_fl_bitmap &= ~((uint64_t)1 << fl);
+      }
+    }
+  }
+
+  if (block->next_free != NULL) {
+    block->next_free->prev_free = block->prev_free;
+  }
+
+  block->prev_free = NULL;
+  block->next_free = NULL;
+  g_heap_stats.free_blocks--;
+}
+
+/**
+  @brief  Find a non-empty list at or above a size class.
+
+  @param  fl  First level index, updated to the list found.
+  @param  sl  Second level index, updated to the list found.
+
+  @return First block of the list, NULL if no list is large enough.
+**/
+static MEM_BLOCK_HEADER *
+heap_find_suitable(uint32_t *fl, uint32_t *sl)
+{
+  uint32_t sl_map;
+  uint64_t fl_map;
+
+  sl_map = g_heap_sl_bitmap[*fl] & (~0U << *sl);
+  if (sl_map == 0) {
+    fl_map = (*fl + 1U < 64U) ? (g_heap_fl_bitmap & (~(uint64_t)0 << (*fl + 1U))) : 0;
+    if (fl_map == 0) {
+      return NULL;
+    }
+
+    *fl = heap_ffs(fl_map);
+    sl_map = g_heap_sl_bitmap[*fl];
+  }
+
+  *sl = heap_ffs(sl_map);
+  return g_heap_free[*fl][*sl];
+}
+
+/**
+  @brief  Write the header fields and footer of a block.
+
+  @param  block    Block to set up.
+  @param  size     Block size.
+  @param  is_free  1 for a free block.
+
+  @return None
+**/
+static void
+heap_set_block(MEM_BLOCK_HEADER *block, size_t size, uint32_t is_free)
+{
+  MEM_BLOCK_FOOTER *footer;
+
+  block->signature = MEM_BLOCK_SIGNATURE;
+  block->is_free = is_free;
+  block->size = size;
+
+  /* Footer is used to validate and coalesce the block. */
+  footer = (MEM_BLOCK_FOOTER *)((uintptr_t)block + size - sizeof(MEM_BLOCK_FOOTER));
+  footer->signature = MEM_FOOT_SIGNATURE;
+  footer->reserved = 0;
+  footer->size = size;
+}
+
+/**
+  @brief  Split the tail of a block from offset on into a new free block.
+
+  @param  block   Block to split.
+  @param  offset  Size kept by block.
+
+  @return New free block.
+**/
+static MEM_BLOCK_HEADER *
+heap_split(MEM_BLOCK_HEADER *block, size_t offset)
+{
+  MEM_BLOCK_HEADER *tail;
+
+  tail = (MEM_BLOCK_HEADER *)((uintptr_t)block + offset);
+  heap_set_block(tail, block->size - offset, 1);
+  tail->payload = 0;
+  tail->prev_phys = block;
+  tail->next_phys = block->next_phys;
+  tail->prev_free = NULL;
+  tail->next_free = NULL;
+  if (tail->next_phys != NULL) {
+    tail->next_phys->prev_phys = tail;
+  }
+
+  heap_set_block(block, offset, block->is_free);
+  block->next_phys = tail;
+  return tail;
+}
+
+/**
+  @brief  Initialize the baremetal heap allocator state.
+
+  @param  None
+
+  @return 1 if heap initialization succeeds, 0 otherwise.
+**/
+static uint32_t mem_alloc_init(void)
+{
+  uintptr_t aligned_heap_base;
+  uintptr_t aligned_heap_top;
+  size_t    heap_size;
+  MEM_BLOCK_HEADER *block;
+  uint32_t  fl;
+
+  aligned_heap_base = ADDR_ALIGN(PLATFORM_HEAP_REGION_BASE, MEM_MIN_ALIGNMENT);
+  aligned_heap_top = (PLATFORM_HEAP_REGION_BASE + PLATFORM_HEAP_REGION_SIZE) &
+                     ~((uintptr_t)MEM_MIN_ALIGNMENT - 1U);
+
+  for (fl = 0; fl < HEAP_FL_COUNT; fl++) {
+    g_heap_sl_bitmap[fl] = 0;
+  }
+  g_heap_fl_bitmap = 0;
+  heap_base = aligned_heap_base;
+  heap_top = aligned_heap_top;
+
+  if (aligned_heap_top <= aligned_heap_base) {
+    return HEAP_INIT_FAILED;
+  }
+
+  heap_size = aligned_heap_top - aligned_heap_base;
+  if (heap_size < MEM_MIN_BLOCK_SIZE) {
+    return HEAP_INIT_FAILED;
+  }
+
+  g_heap_stats.heap_size = heap_size;
+  g_heap_stats.in_use = 0;
+  g_heap_stats.peak_in_use = 0;
+  g_heap_stats.free_blocks = 0;
+  g_heap_stats.alloc_count = 0;
+  g_heap_stats.alloc_failures = 0;
+
+  block = (MEM_BLOCK_HEADER *)aligned_heap_base;
+  heap_set_block(block, heap_size, 1);
+  block->payload = 0;
+  block->prev_phys = NULL;
+  block->next_phys = NULL;
+  heap_insert_free(block);
+
+  heap_init_done = HEAP_INITIALISED;
+  return HEAP_INIT_SUCCESS;
+}
+
+/**
+  @brief  Allocates contiguous memory of requested size and alignment.
+
+  @param  alignment  Alignment for the returned address. It must be a power of two.
+  @param  size       Size of the memory region to allocate. It must not be zero.
+
+  @return Allocated memory base address if successful, otherwise NULL.
+ **/
+void *mem_alloc(size_t alignment, size_t size)
+{
+  MEM_BLOCK_HEADER *block;
+  size_t           search_size;
+  size_t           lead_size;
+  size_t           alloc_size;
+  uintptr_t        payload_base;
+  uintptr_t        payload;
+  uint32_t         fl;
+  uint32_t         sl;
+
+  if ((size == 0) || !is_power_of_2(alignment)) {
+    return NULL;
+  }
+
+  if (alignment < MEM_MIN_ALIGNMENT) {
+    alignment = MEM_MIN_ALIGNMENT;
+  }
+
+  if ((size > (SIZE_MAX / 4)) || (alignment > (SIZE_MAX / 4))) {
+    return NULL;
+  }
+
+  if (heap_init_done != HEAP_INITIALISED) {
+    if (mem_alloc_init() != HEAP_INIT_SUCCESS) {
+      return NULL;
+    }
+  }
+
+  /*
+   * Block size with the payload right after the header and hidden back
+   * pointer, plus the worst case alignment offset of the payload.
+   */
+  search_size = ADDR_ALIGN(sizeof(MEM_BLOCK_HEADER) + sizeof(MEM_BLOCK_HEADER *) + size +
+                           sizeof(MEM_BLOCK_FOOTER), MEM_MIN_ALIGNMENT) +
+                (alignment - MEM_MIN_ALIGNMENT);
+  if (search_size < MEM_MIN_BLOCK_SIZE) {
+    search_size = MEM_MIN_BLOCK_SIZE;
+  }
+
+  block = NULL;
+  if (heap_mapping_search(search_size, &fl, &sl)) {
+    block = heap_find_suitable(&fl, &sl);
+  }
+
+  if (block == NULL) {
+    g_heap_stats.alloc_failures++;
+    return NULL;
+  }
+
+  /* The selected free block is now owned by this allocation. */
+  heap_remove_free(block);
+
+  /*
+   * Payload is placed after the block header and a hidden back pointer.
+   * mem_free() uses that back pointer to recover the owning block.
+   */
+  payload_base = (uintptr_t)block + sizeof(MEM_BLOCK_HEADER) + sizeof(MEM_BLOCK_HEADER *);
+  payload = ADDR_ALIGN(payload_base, alignment);
+
+  /* Return the room in front of an aligned payload as a free block. */
+  lead_size = payload - payload_base;
+  if (lead_size >= MEM_MIN_BLOCK_SIZE) {
+    block->is_free = 1;
+    block = heap_split(block, lead_size);
+    heap_insert_free(block->prev_phys);
+  }
+
+  alloc_size = ADDR_ALIGN(payload + size + sizeof(MEM_BLOCK_FOOTER), MEM_MIN_ALIGNMENT) -
+               (uintptr_t)block;
+
+  /* Keep the unused tail as a free block for later allocations. */
+  if ((block->size - alloc_size) >= MEM_MIN_BLOCK_SIZE) {
+    heap_insert_free(heap_split(block, alloc_size));
+  }
+
+  heap_set_block(block, block->size, 0);
+  block->payload = payload;
+  block->prev_free = NULL;
+  block->next_free = NULL;
+
+  g_heap_stats.in_use += block->size;
+  if (g_heap_stats.in_use > g_heap_stats.peak_in_use) {
+    g_heap_stats.peak_in_use = g_heap_stats.in_use;
+  }
+  g_heap_stats.alloc_count++;
+
+  /* Store owning block immediately before the returned payload. */
+  ((MEM_BLOCK_HEADER **)payload)[-1] = block;
+  return (void *)payload;
+}
+
+/**
+  @brief  Free memory allocated by mem_alloc.
+
+  @param  ptr  Pointer returned by mem_alloc.
+
+  @return None
+ **/
+void mem_free(void *ptr)
+{
+  MEM_BLOCK_HEADER *block;
+  MEM_BLOCK_HEADER *next;
+  MEM_BLOCK_HEADER *prev;
+  MEM_BLOCK_FOOTER *footer;
+  uintptr_t        ptr_addr;
+
+  if (ptr == NULL) {
+    return;
+  }
+
+  if (heap_init_done != HEAP_INITIALISED) {
+    return;
+  }
+
+  ptr_addr = (uintptr_t)ptr;
+
+  /* Reject invalid heap range or alignment before reading the back pointer. */
+  if ((ptr_addr < (heap_base + sizeof(MEM_BLOCK_HEADER *))) ||
+      (ptr_addr >= heap_top) ||
+      ((ptr_addr & (MEM_MIN_ALIGNMENT - 1U)) != 0)) {
+    return;
+  }
+
+  /* Recover and validate the block that produced this exact payload pointer. */
+  block = ((MEM_BLOCK_HEADER **)ptr)[-1];
+  if ((block == NULL) ||
+      ((uintptr_t)block < heap_base) ||
+      ((uintptr_t)block >= heap_top) ||
+      (block->signature != MEM_BLOCK_SIGNATURE) ||
+      (block->size < MEM_MIN_BLOCK_SIZE) ||
+      (block->size > (heap_top - (uintptr_t)block)) ||
+      (block->payload != ptr_addr)) {
+    return;
+  }
+
+  /* Header/footer agreement protects the free lists from stale/corrupt input. */
+  footer = (MEM_BLOCK_FOOTER *)((uintptr_t)block + block->size -
+                                sizeof(MEM_BLOCK_FOOTER));
+  if ((footer->signature != MEM_FOOT_SIGNATURE) ||
+      (footer->size != block->size)) {
+    return;
+  }
+
+  if (block->is_free) {
+    return;
+  }
+
+  g_heap_stats.in_use -= block->size;
+  g_heap_stats.alloc_count--;
+
+  block->payload = 0;
+  block->is_free = 1;
+
+  prev = block->prev_phys;
+  if ((prev != NULL) && prev->is_free) {
+    /* Remove previous block from its list before merging with it. */
+    heap_remove_free(prev);
+
+    prev->next_phys = block->next_phys;
+    if (prev->next_phys != NULL) {
+      prev->next_phys->prev_phys = prev;
+    }
+    heap_set_block(prev, prev->size + block->size, 1);
+    block = prev;
+  }
+
+  next = block->next_phys;
+  if ((next != NULL) && next->is_free) {
+    /* Remove next block from its list before merging with it. */
+    heap_remove_free(next);
+
+    block->next_phys = next->next_phys;
+    if (block->next_phys != NULL) {
+      block->next_phys->prev_phys = block;
+    }
+    heap_set_block(block, block->size + next->size, 1);
+  } else {
+    heap_set_block(block, block->size, 1);
+  }
+
+  heap_insert_free(block);
+}
+
+/**
+  @brief  Report the heap usage and fragmentation.
+
+  @param  stats  Heap statistics, filled on success.
+
+  @return PAL_STATUS_SUCCESS, or PAL_STATUS_INVALID_PARAM if stats is NULL.
+**/
+uint32_t
+pal_mem_get_heap_stats(PAL_HEAP_STATS *stats)
+{
+  MEM_BLOCK_HEADER *block;
+  uint64_t          free_bytes;
+  uint32_t          fl;
+  uint32_t          sl;
+
+  if (stats == NULL) {
+    return PAL_STATUS_INVALID_PARAM;
+  }
+
+  if (heap_init_done != HEAP_INITIALISED) {
+    (void)mem_alloc_init();
+  }
+
+  *stats = g_heap_stats;
+  stats->largest_free = 0;
+  stats->fragmentation = 0;
+
+  /* The largest free block is in the highest non-empty list */
+  if (g_heap_fl_bitmap != 0) {
+    fl = heap_fls(g_heap_fl_bitmap);
+    sl = heap_fls(g_heap_sl_bitmap[fl]);
+    for (block = g_heap_free[fl][sl]; block != NULL; block = block->next_free) {
+      if (block->size > stats->largest_free) {
+        stats->largest_free = block->size;
+      }
+    }
+  }
+
+  free_bytes = stats->heap_size - stats->in_use;
+  if (free_bytes != 0) {
+    stats->fragmentation = (uint32_t)(100 - (stats->largest_free * 100) / free_bytes);
+  }
+
+  return PAL_STATUS_SUCCESS;
+}
@@ -35,7 +35,7 @@ uint64_t  gMpidrMax;
 **/
 static PE_MMU_CONFIG gMmuConfig __attribute__((aligned(64)));
 
-#define SIZE_STACK_SECONDARY_PE  0x100          //256 bytes per core
+#define SIZE_STACK_SECONDARY_PE  0x400          //1KB per core, StackSize in ModuleEntryPoint.S
 #define UPDATE_AFF_MAX(src,dest,mask)  ((dest & mask) > (src & mask) ? (dest & mask) : (src & mask))
 
 /**
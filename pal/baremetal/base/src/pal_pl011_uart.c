@@ -17,57 +17,237 @@
 
 #include "pal_pl011_uart.h"
 
+/* Interrupt-driven draining works on the TX ring */
+#if defined(ACS_UART_TX_IRQ) && !defined(ACS_UART_TX_BUFFERED)
+#define ACS_UART_TX_BUFFERED
+#endif
+
 static volatile uint64_t g_uart = PLATFORM_UART_BASE;
 static uint8_t is_uart_init_done;
+static uint64_t g_result_uart_init_base;
+
+/* Characters that found the TX FIFO or the TX ring full */
+static uint64_t g_uart_tx_stalled;
+/* Characters given up after the FIFO made no progress */
+static uint64_t g_uart_tx_dropped;
+
+#ifdef ACS_UART_TX_BUFFERED
+/*
+ * Single producer, single consumer ring. Only the PE that printed first
+ * (the primary PE) queues characters and fills the FIFO, from its print
+ * calls or from the UART TX interrupt. Other PEs write the FIFO directly.
+ */
+typedef struct {
+    char              buf[ACS_UART_TX_RING_SIZE];
+    volatile uint32_t head;       /* next character queued */
+    volatile uint32_t tail;       /* next character sent to the FIFO */
+    volatile uint32_t draining;   /* FIFO being filled, the ISR backs off */
+    uint32_t          irq_enabled;
+    uint32_t          owner_valid;
+    uint64_t          owner_mpidr;
+} pal_uart_tx_ring_t;
+
+static pal_uart_tx_ring_t g_uart_tx;
+
+_Static_assert((ACS_UART_TX_RING_SIZE & (ACS_UART_TX_RING_SIZE - 1)) == 0,
+               "ACS_UART_TX_RING_SIZE must be a power of two");
+#endif
 
 /**
  *   @brief    - This function initializes the UART
  *   @param    - uart_base_addr: Base address of UART
  *   @return   - none
 **/
-static void pal_driver_uart_pl011_init(void)
+static void pal_driver_uart_pl011_init(uint64_t uart_base_addr)
 {
     uint32_t bauddiv = (UART_PL011_CLK_IN_HZ * 4) / UART_PL011_BAUDRATE;
 
     /* Disable uart before programming */
-    ((pal_uart_t *)g_uart)->uartcr &= ~UART_PL011_UARTCR_EN_MASK;
+    ((pal_uart_t *)uart_base_addr)->uartcr &= ~UART_PL011_UARTCR_EN_MASK;
 
     /* Write the IBRD */
-    ((pal_uart_t *)g_uart)->uartibrd = bauddiv >> 6;
+    ((pal_uart_t *)uart_base_addr)->uartibrd = bauddiv >> 6;
 
     /* Write the FBRD */
-    ((pal_uart_t *)g_uart)->uartfbrd = bauddiv & 0x3F;
+    ((pal_uart_t *)uart_base_addr)->uartfbrd = bauddiv & 0x3F;
 
     /* Set line of control */
-    ((pal_uart_t *)g_uart)->uartlcr_h = UART_PL011_LINE_CONTROL;
+    ((pal_uart_t *)uart_base_addr)->uartlcr_h = UART_PL011_LINE_CONTROL;
 
     /* Clear any pending errors */
-    ((pal_uart_t *)g_uart)->uartecr = 0;
+    ((pal_uart_t *)uart_base_addr)->uartecr = 0;
 
     /* Enable tx, rx, and uart overall */
-    ((pal_uart_t *)g_uart)->uartcr = UART_PL011_UARTCR_EN_MASK
+    ((pal_uart_t *)uart_base_addr)->uartcr = UART_PL011_UARTCR_EN_MASK
                             | UART_PL011_UARTCR_TX_EN_MASK;
 }
 
 /**
- *   @brief    - This function checks for empty TX FIFO
- *   @param    - none
- *   @return   - status
+ *   @brief    - This function returns how many characters can be written to
+ *               the TX FIFO without waiting. One character is written per
+ *               check, or with @p burst a FIFO reported empty takes
+ *               UART_PL011_TX_FIFO_DEPTH characters.
+ *   @param    - uart_base_addr: Base address of UART
+ *   @param    - burst: Only the TX ring owner may burst, other PEs could
+ *                      write the FIFO at the same time
+ *   @return   - number of characters, 0 if the FIFO is full or the UART or
+ *               its transmitter is disabled
 **/
-static int pal_driver_uart_pl011_is_tx_empty(void)
+static uint32_t pal_driver_uart_pl011_tx_room(uint64_t uart_base_addr, uint32_t burst)
 {
-    if ((((pal_uart_t *)g_uart)->uartcr & UART_PL011_UARTCR_EN_MASK) &&
-        /* UART is enabled */
-        (((pal_uart_t *)g_uart)->uartcr & UART_PL011_UARTCR_TX_EN_MASK) &&
-        /* Transmit is enabled */
-        ((((pal_uart_t *)g_uart)->uartfr & UART_PL011_UARTFR_TX_FIFO_FULL) == 0))
-    {
-        return 1;
-    } else
-    {
+    uint32_t uartcr = ((pal_uart_t *)uart_base_addr)->uartcr;
+    uint32_t uartfr = ((pal_uart_t *)uart_base_addr)->uartfr;
+
+    if (!(uartcr & UART_PL011_UARTCR_EN_MASK) || !(uartcr & UART_PL011_UARTCR_TX_EN_MASK))
+        return 0;
+
+    if (uartfr & UART_PL011_UARTFR_TX_FIFO_FULL)
         return 0;
+
+    if (burst && (uartfr & UART_PL011_UARTFR_TX_FIFO_EMPTY))
+        return UART_PL011_TX_FIFO_DEPTH;
+
+    return 1;
+}
+
+/**
+ *   @brief    - This function waits for room in the TX FIFO. A FIFO that
+ *               makes no progress, such as on a disabled UART, is given up
+ *               on instead of hanging the run.
+ *   @param    - uart_base_addr: Base address of UART
+ *   @param    - burst: Passed to pal_driver_uart_pl011_tx_room()
+ *   @return   - number of characters that can be written, 0 if given up
+**/
+static uint32_t pal_driver_uart_pl011_tx_wait(uint64_t uart_base_addr, uint32_t burst)
+{
+    uint32_t room = pal_driver_uart_pl011_tx_room(uart_base_addr, burst);
+    uint32_t polls = 0;
+
+    if (room != 0)
+        return room;
+
+    g_uart_tx_stalled++;
+    while (room == 0 && ++polls < UART_PL011_TX_STALL_LIMIT)
+        room = pal_driver_uart_pl011_tx_room(uart_base_addr, burst);
+
+    return room;
+}
+
+/**
+ *   @brief    - This function writes a buffer to the TX FIFO, checking for
+ *               room before each character
+ *   @param    - uart_base_addr: Base address of UART
+ *   @param    - buf: Data to be written
+ *   @param    - len: Number of bytes to write
+ *   @return   - none
+**/
+static void pal_driver_uart_pl011_tx(uint64_t uart_base_addr, const char *buf, uint32_t len)
+{
+    uint32_t room;
+
+    while (len != 0) {
+        room = pal_driver_uart_pl011_tx_wait(uart_base_addr, 0);
+        if (room == 0) {
+            g_uart_tx_dropped += len;
+            return;
+        }
+
+        /* write the data (upper 24 bits are reserved) */
+        ((pal_uart_t *)uart_base_addr)->uartdr = (uint8_t)*buf++;
+        len--;
+    }
+}
+
+#ifdef ACS_UART_TX_BUFFERED
+/**
+ *   @brief    - This function checks whether the calling PE owns the TX ring.
+ *               The first PE to print becomes the owner.
+ *   @return   - 1 if owner, 0 otherwise
+**/
+static uint32_t pal_uart_tx_is_owner(void)
+{
+    uint64_t mpidr;
+
+    __asm__ volatile("mrs %0, mpidr_el1" : "=r"(mpidr));
+    mpidr &= 0xFF00FFFFFFull;
+
+    if (!g_uart_tx.owner_valid) {
+        g_uart_tx.owner_mpidr = mpidr;
+        g_uart_tx.owner_valid = 1;
+    }
+
+    return (g_uart_tx.owner_mpidr == mpidr);
+}
+
+/**
+ *   @brief    - This function moves queued characters from the TX ring to the
+ *               FIFO. It only waits for the FIFO while more than @p keep
+ *               characters are queued.
+ *   @param    - keep: Characters that may stay queued, ACS_UART_TX_RING_SIZE
+ *                     to never wait, 0 to flush the ring
+ *   @return   - none
+**/
+static void pal_uart_tx_drain(uint32_t keep)
+{
+    pal_uart_t *uart = (pal_uart_t *)g_uart;
+    uint32_t tail = g_uart_tx.tail;
+    uint32_t room;
+
+    g_uart_tx.draining = 1;
+
+    while (tail != g_uart_tx.head) {
+        if ((g_uart_tx.head - tail) > keep)
+            room = pal_driver_uart_pl011_tx_wait(g_uart, 1);
+        else
+            room = pal_driver_uart_pl011_tx_room(g_uart, 1);
+
+        if (room == 0) {
+            /* The FIFO made no progress, drop the queue rather than hang */
+            if ((g_uart_tx.head - tail) > keep) {
+                g_uart_tx_dropped += g_uart_tx.head - tail;
+                tail = g_uart_tx.head;
+            }
+            break;
+        }
+
+        while (room-- && tail != g_uart_tx.head) {
+            uart->uartdr = (uint8_t)g_uart_tx.buf[tail & (ACS_UART_TX_RING_SIZE - 1)];
+            tail++;
+        }
+    }
+
+    g_uart_tx.tail = tail;
+    g_uart_tx.draining = 0;
+
+    /* The ISR masks the interrupt when it finds a drain in progress */
+    if (g_uart_tx.irq_enabled)
+        uart->uartimsc |= UART_PL011_TX_INTR_MASK;
+}
+
+/**
+ *   @brief    - This function queues a character in the TX ring, waiting for
+ *               one FIFO burst to go out when the ring is full
+ *   @param    - c: char to be queued
+ *   @return   - none
+**/
+static void pal_uart_tx_queue(char c)
+{
+    uint32_t queued = g_uart_tx.head - g_uart_tx.tail;
+
+    if (queued == ACS_UART_TX_RING_SIZE) {
+        g_uart_tx_stalled++;
+        pal_uart_tx_drain(ACS_UART_TX_RING_SIZE - UART_PL011_TX_FIFO_DEPTH);
     }
+
+    g_uart_tx.buf[g_uart_tx.head & (ACS_UART_TX_RING_SIZE - 1)] = c;
+    g_uart_tx.head++;
+    queued++;
+
+    /* Fill the FIFO once a burst is queued or a line ends, without waiting */
+    if (queued >= UART_PL011_TX_FIFO_DEPTH || c == '\n')
+        pal_uart_tx_drain(ACS_UART_TX_RING_SIZE);
 }
+#endif
 
 /**
  *   @brief    - This function checks for empty TX FIFO and writes to FIFO register
@@ -76,23 +256,136 @@ static int pal_driver_uart_pl011_is_tx_empty(void)
 **/
 void pal_driver_uart_pl011_putc(int c)
 {
-    const uint8_t pdata = (uint8_t)c;
+    const char pdata = (char)c;
 
     if (is_uart_init_done == 0)
     {
-        pal_driver_uart_pl011_init();
+        pal_driver_uart_pl011_init(g_uart);
         is_uart_init_done = 1;
     }
 
-    /* ensure TX buffer to be empty */
-    while (!pal_driver_uart_pl011_is_tx_empty())
-      ;
+#ifdef ACS_UART_TX_BUFFERED
+    if (pal_uart_tx_is_owner()) {
+        pal_uart_tx_queue(pdata);
+        return;
+    }
+#endif
 
-    /* write the data (upper 24 bits are reserved) */
-    ((pal_uart_t *)g_uart)->uartdr = pdata;
+    pal_driver_uart_pl011_tx(g_uart, &pdata, 1);
 }
 
 void pal_uart_putc(char c)
 {
     pal_driver_uart_pl011_putc((uint8_t)c);
 }
+
+/**
+ *   @brief    - Writes a buffer to a secondary PL011, such as the UART
+ *               carrying the rule result records
+ *   @param    - uart_base_addr: Base address of the secondary UART
+ *   @param    - buf: Data to be written
+ *   @param    - len: Number of bytes to write
+ *   @return   - none
+**/
+void pal_driver_uart_pl011_write(uint64_t uart_base_addr, const char *buf, uint32_t len)
+{
+    if (uart_base_addr == g_uart)
+    {
+        while (len--)
+            pal_driver_uart_pl011_putc(*buf++);
+        return;
+    }
+
+    if (g_result_uart_init_base != uart_base_addr)
+    {
+        pal_driver_uart_pl011_init(uart_base_addr);
+        g_result_uart_init_base = uart_base_addr;
+    }
+
+    pal_driver_uart_pl011_tx(uart_base_addr, buf, len);
+}
+
+/**
+ *   @brief    - Pushes out all queued console output and waits for the UART
+ *               to finish sending it. Called at rule boundaries, before
+ *               exiting and from exception paths.
+ *   @return   - none
+**/
+void pal_uart_flush(void)
+{
+    uint32_t polls = 0;
+
+    if (is_uart_init_done == 0)
+        return;
+
+#ifdef ACS_UART_TX_BUFFERED
+    /* Another PE cannot drain the ring safely, it only waits for the FIFO */
+    if (pal_uart_tx_is_owner())
+        pal_uart_tx_drain(0);
+#endif
+
+    while ((((pal_uart_t *)g_uart)->uartfr & UART_PL011_UARTFR_BUSY) &&
+           ++polls < UART_PL011_TX_STALL_LIMIT)
+        ;
+}
+
+/**
+ *   @brief    - Returns the console TX counters
+ *   @param    - stalled: Characters that waited for room in the FIFO or ring
+ *   @param    - dropped: Characters given up on a FIFO that made no progress
+ *   @return   - none
+**/
+void pal_uart_get_tx_stats(uint64_t *stalled, uint64_t *dropped)
+{
+    if (stalled)
+        *stalled = g_uart_tx_stalled;
+    if (dropped)
+        *dropped = g_uart_tx_dropped;
+}
+
+/**
+ *   @brief    - UART TX interrupt handler, refills the FIFO from the TX ring.
+ *               Installed through val_gic_install_isr() with ACS_UART_TX_IRQ.
+ *   @return   - none
+**/
+void pal_uart_tx_isr(void)
+{
+    pal_uart_t *uart = (pal_uart_t *)g_uart;
+
+    uart->uarticr = UART_PL011_TX_INTR_MASK;
+
+#ifdef ACS_UART_TX_BUFFERED
+    if (g_uart_tx.draining || !pal_uart_tx_is_owner()) {
+        /* The drain in progress unmasks the interrupt when it completes */
+        uart->uartimsc &= ~UART_PL011_TX_INTR_MASK;
+        return;
+    }
+
+    pal_uart_tx_drain(ACS_UART_TX_RING_SIZE);
+#endif
+}
+
+/**
+ *   @brief    - Enables or disables draining of the TX ring from the UART TX
+ *               interrupt
+ *   @param    - enable: 1 to enable, 0 to disable
+ *   @return   - none
+**/
+void pal_uart_tx_irq_enable(uint32_t enable)
+{
+#ifdef ACS_UART_TX_BUFFERED
+    pal_uart_t *uart = (pal_uart_t *)g_uart;
+
+    if (enable) {
+        uart->uartifls = (uart->uartifls & ~UART_PL011_UARTIFLS_TX_MASK) |
+                         UART_PL011_UARTIFLS_TX_1_8;
+        g_uart_tx.irq_enabled = 1;
+        uart->uartimsc |= UART_PL011_TX_INTR_MASK;
+    } else {
+        g_uart_tx.irq_enabled = 0;
+        uart->uartimsc &= ~UART_PL011_TX_INTR_MASK;
+    }
+#else
+    (void)enable;
+#endif
+}
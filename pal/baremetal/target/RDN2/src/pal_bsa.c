@@ -1086,6 +1086,7 @@ pal_dma_mem_get_attrs(void *buf, uint32_t *attr, uint32_t *sh)
 **/
 uint32_t pal_exit_acs(void)
 {
+  pal_uart_flush();
   while (1);
   return 0;
 }
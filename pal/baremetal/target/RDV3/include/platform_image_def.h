@@ -41,4 +41,18 @@
 #define PLATFORM_HEAP_REGION_BASE           (PLATFORM_SHARED_REGION_BASE + \
                                             PLATFORM_SHARED_REGION_SIZE)
 
+/*
+ * Memory preserved across a warm reset, used to checkpoint rule based
+ * execution progress for resume (ACS_RESUME). The region must be mapped
+ * in the platform memory map. Size 0 disables checkpointing.
+ */
+#define PLATFORM_CHECKPOINT_REGION_BASE     0x0
+#define PLATFORM_CHECKPOINT_REGION_SIZE     0x0
+
+/*
+ * PL011 carrying the machine-readable rule result records
+ * (ACS_RESULT_SINK=uart), separate from the console UART. 0 if not present.
+ */
+#define PLATFORM_RESULT_UART_BASE           0x0
+
 #endif /* _PAL_CONFIG_H_ */
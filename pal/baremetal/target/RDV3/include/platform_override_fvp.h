@@ -299,6 +299,8 @@
 #define PLATFORM_OVERRIDE_TIMEOUT              1000   /* time out for DUT */
 /* Timer test timeout (us); range 500us to 2 sec */
 #define PLATFORM_OVERRIDE_TIMER_TIMEOUT        10000
+/* Scale of the test wait deadlines in percent, raise on slow models */
+#define PLATFORM_OVERRIDE_TIMEOUT_SCALE        100
 
 /* FAIL safe timeout (> PLATFORM_OVERRIDE_TIMEOUT) */
 #define PLATFORM_OVERRIDE_FAILSAFE_TIMEOUT     (PLATFORM_OVERRIDE_TIMEOUT * 2)
@@ -641,6 +643,7 @@
 #define UART_BAUD_RATE                   0x7        /* Baud-rate enum (as per SPCR table)        */
 #define UART_BAUD_RATE_BPS               115200     /* Actual bits-per-second                    */
 #define UART_CLK_IN_HZ                   24000000   /* Reference clock input                     */
+#define UART_TX_FIFO_DEPTH               16         /* TX FIFO entries, 32 from PL011 r1p5       */
 #define UART_GLOBAL_SYSTEM_INTERRUPT     0x70       /* UART GSIV                                 */
 #define UART_PCI_DEVICE_ID               0xFFFF     /* Device ID - If UART is on PCIe            */
 #define UART_PCI_VENDOR_ID               0xFFFF     /* Vendor ID - If UART is on PCIe            */
@@ -28,7 +28,8 @@
 
 #define PAL_PRINT_IF(verbose, call_expr) \
     do { \
-        if ((verbose) >= acs_policy_get_print_level()) { \
+        if (ACS_PRINT_COMPILED_IN(verbose) && \
+            (verbose) >= acs_policy_get_print_level()) { \
             call_expr; \
         } \
     } while (0)
@@ -86,7 +87,8 @@ static inline void pal_print_log_prefix(uint32_t verbose)
 
 #define PAL_PRINT_LITERAL(verbose, string, ...) \
     do { \
-        if ((verbose) >= acs_policy_get_print_level()) { \
+        if (ACS_PRINT_COMPILED_IN(verbose) && \
+            (verbose) >= acs_policy_get_print_level()) { \
             const CHAR16 *_pal_fmt = L"" string; \
             uint32_t _pal_i; \
             bool _pal_new_record = (*_pal_fmt == L'\n'); \
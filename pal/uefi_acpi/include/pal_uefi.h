@@ -35,6 +35,7 @@ typedef struct _EFI_PCI_IO_PROTOCOL EFI_PCI_IO_PROTOCOL;
 UINT64 pal_get_acpi_table_ptr(UINT32 table_signature);
 
 extern VOID* g_acs_log_file_handle;
+extern VOID* g_acs_result_file_handle;
 extern UINT32 g_curr_module;
 extern UINT32 g_enable_module;
 VOID pal_warn_not_implemented(const CHAR8 *api_name);
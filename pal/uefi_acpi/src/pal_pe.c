@@ -42,7 +42,7 @@ extern INT32 gPsciConduit;
 static PE_MMU_CONFIG gMmuConfig __attribute__((aligned(64)));
 
 #define MAX_NUM_OF_SMBIOS_SLOTS_SUPPORTED  1024
-#define SIZE_STACK_SECONDARY_PE  0x100      //256 bytes per core
+#define SIZE_STACK_SECONDARY_PE  0x400      //1KB per core, StackSize in ModuleEntryPoint.S
 #define UPDATE_AFF_MAX(src,dest,mask)  ((dest & mask) > (src & mask) ? (dest & mask) : (src & mask))
 
 #define ENABLED_BIT(flags)  (flags & 0x1)
@@ -22,6 +22,7 @@
 #include "pal_print.h"
 
 extern VOID* g_acs_log_file_handle;
+extern VOID* g_acs_result_file_handle;
 extern UINT32 g_curr_module;
 extern UINT32 g_enable_module;
 VOID pal_warn_not_implemented(const CHAR8 *api_name);
@@ -20,6 +20,7 @@
 #include  <Library/ShellLib.h>
 #include  <Library/PrintLib.h>
 #include  <Library/BaseMemoryLib.h>
+#include  <Library/UefiRuntimeServicesTableLib.h>
 #include  <Protocol/Cpu.h>
 
 
@@ -245,6 +246,50 @@ pal_print(UINT64 data)
   }
 }
 
+/**
+  @brief  Console output is written synchronously through the UEFI console,
+          nothing is queued.
+
+  @return None
+**/
+VOID
+pal_print_flush(VOID)
+{
+}
+
+/**
+  @brief  Console output counters are not kept by the UEFI console.
+
+  @param  Stalled  Unused
+  @param  Dropped  Unused
+
+  @return PAL_STATUS_UNSUPPORTED
+**/
+UINT32
+pal_print_get_stats(UINT64 *Stalled, UINT64 *Dropped)
+{
+  (VOID)Stalled;
+  (VOID)Dropped;
+
+  return PAL_STATUS_UNSUPPORTED;
+}
+
+/**
+  @brief  Heap statistics are not kept, UEFI memory comes from the boot
+          services pool.
+
+  @param  Stats  Unused
+
+  @return PAL_STATUS_UNSUPPORTED
+**/
+UINT32
+pal_mem_get_heap_stats(VOID *Stats)
+{
+  (VOID)Stats;
+
+  return PAL_STATUS_UNSUPPORTED;
+}
+
 /**
   @brief  Emit a warning indicating the given PAL API is not implemented.
   @param  api_name  Name of the unimplemented API (typically __func__).
@@ -704,3 +749,131 @@ void pal_uart_putc(char c)
         }
     }
 }
+
+/* Non-volatile UEFI variable holding the rule based execution checkpoint */
+#define ACS_CHECKPOINT_VARIABLE_NAME  L"AcsRuleCheckpoint"
+
+STATIC EFI_GUID gAcsCheckpointVariableGuid = {
+  0x6c0f3a2e, 0x91d4, 0x4b7a, { 0x8e, 0x25, 0x3f, 0x5d, 0xa1, 0x70, 0xc4, 0x9b }
+};
+
+/**
+  @brief Saves the rule execution checkpoint to a non-volatile UEFI variable,
+         so it survives a reset of the platform.
+
+  @param Buffer Checkpoint data
+  @param Size   Size of the checkpoint data in bytes
+
+  @return PAL_STATUS_SUCCESS on success, error code otherwise
+**/
+UINT32
+pal_checkpoint_save(VOID *Buffer, UINT32 Size)
+{
+  EFI_STATUS Status;
+
+  if (Buffer == NULL || Size == 0)
+    return PAL_STATUS_INVALID_PARAM;
+
+  Status = gRT->SetVariable(ACS_CHECKPOINT_VARIABLE_NAME,
+                            &gAcsCheckpointVariableGuid,
+                            EFI_VARIABLE_NON_VOLATILE | EFI_VARIABLE_BOOTSERVICE_ACCESS,
+                            Size,
+                            Buffer);
+  if (EFI_ERROR(Status)) {
+    pal_print_msg(ACS_PRINT_DEBUG,
+                  "\n       Checkpoint variable write failed %x",
+                  Status);
+    return PAL_STATUS_ERROR;
+  }
+
+  return PAL_STATUS_SUCCESS;
+}
+
+/**
+  @brief Loads the rule execution checkpoint saved by pal_checkpoint_save.
+
+  @param Buffer Buffer receiving the checkpoint data
+  @param Size   In: size of Buffer, Out: size of the checkpoint data
+
+  @return PAL_STATUS_SUCCESS on success,
+          PAL_STATUS_UNSUPPORTED if no checkpoint is present, error code otherwise
+**/
+UINT32
+pal_checkpoint_load(VOID *Buffer, UINT32 *Size)
+{
+  EFI_STATUS Status;
+  UINTN      DataSize;
+
+  if (Buffer == NULL || Size == NULL)
+    return PAL_STATUS_INVALID_PARAM;
+
+  DataSize = *Size;
+  Status = gRT->GetVariable(ACS_CHECKPOINT_VARIABLE_NAME,
+                            &gAcsCheckpointVariableGuid,
+                            NULL,
+                            &DataSize,
+                            Buffer);
+  if (Status == EFI_NOT_FOUND)
+    return PAL_STATUS_UNSUPPORTED;
+  if (Status == EFI_BUFFER_TOO_SMALL)
+    return PAL_STATUS_NO_RESOURCE;
+  if (EFI_ERROR(Status))
+    return PAL_STATUS_ERROR;
+
+  *Size = (UINT32)DataSize;
+  return PAL_STATUS_SUCCESS;
+}
+
+/**
+  @brief Deletes the rule execution checkpoint.
+
+  @param None
+
+  @return PAL_STATUS_SUCCESS on success or if no checkpoint is present
+**/
+UINT32
+pal_checkpoint_clear(VOID)
+{
+  EFI_STATUS Status;
+
+  Status = gRT->SetVariable(ACS_CHECKPOINT_VARIABLE_NAME,
+                            &gAcsCheckpointVariableGuid,
+                            0,
+                            0,
+                            NULL);
+  if (EFI_ERROR(Status) && (Status != EFI_NOT_FOUND))
+    return PAL_STATUS_ERROR;
+
+  return PAL_STATUS_SUCCESS;
+}
+
+/* Rule result record file, opened by the application for -results */
+VOID *g_acs_result_file_handle;
+
+/**
+  @brief  Writes machine-readable rule result records to the result file.
+
+  @param  Buf  Record text
+  @param  Len  Length of the record text in bytes
+
+  @return PAL_STATUS_SUCCESS on success,
+          PAL_STATUS_UNSUPPORTED if no result file is open, error code otherwise
+**/
+UINT32
+pal_result_sink_write(const CHAR8 *Buf, UINT32 Len)
+{
+  UINTN      BufferSize = Len;
+  EFI_STATUS Status;
+
+  if (g_acs_result_file_handle == NULL)
+    return PAL_STATUS_UNSUPPORTED;
+
+  if (Buf == NULL)
+    return PAL_STATUS_INVALID_PARAM;
+
+  Status = ShellWriteFile(g_acs_result_file_handle, &BufferSize, (VOID *)Buf);
+  if (EFI_ERROR(Status) || (BufferSize != Len))
+    return PAL_STATUS_ERROR;
+
+  return PAL_STATUS_SUCCESS;
+}
@@ -30,8 +30,10 @@ volatile uint32_t dl_done = 0;
 void payload_secondary(void)
 {
   /* Wait until DL is called on Primary PE */
-  uint32_t timeout = TIMEOUT_MEDIUM;
-  while (timeout-- && (dl_done == 0));
+  val_deadline_t deadline;
+
+  val_deadline_start(&deadline, TIMEOUT_MEDIUM_US);
+  while (!val_deadline_expired(&deadline) && (dl_done == 0));
 }
 
 static
@@ -45,7 +47,6 @@ payload(uint32_t num_pe)
   uint32_t index = val_pe_get_index_mpid(val_pe_get_mpid());
   int64_t  status;
   uint32_t sec_pe_index;
-  uint32_t timeout = TIMEOUT_MEDIUM;
 
   DRTM_PARAMETERS *drtm_params;
   uint64_t drtm_params_size = DRTM_SIZE_4K;
@@ -113,7 +114,7 @@ free_drtm_params:
   val_memory_free_aligned((void *)drtm_params);
 
   /* Wait for some time to make sure PE switched off */
-  while (timeout--);
+  val_deadline_wait_us(TIMEOUT_MEDIUM_US);
 
   return;
 }
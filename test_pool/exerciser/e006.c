@@ -72,7 +72,7 @@ payload (void)
 {
   uint32_t pe_index;
   uint32_t ret_val;
-  uint32_t timeout;
+  val_deadline_t deadline;
   uint32_t e_intr_pin;
   uint32_t status;
   uint32_t count;
@@ -141,10 +141,10 @@ payload (void)
             val_exerciser_ops(GENERATE_L_INTR, e_intr_line, instance);
 
             /* PE busy polls to check the completion of interrupt service routine */
-            timeout = TIMEOUT_LARGE;
-            while ((--timeout > 0) && e_intr_pending);
+            val_deadline_start(&deadline, TIMEOUT_LARGE_US);
+            while (!val_deadline_expired(&deadline) && e_intr_pending);
 
-            if (timeout == 0) {
+            if (val_deadline_timed_out(&deadline)) {
                 /* Deassert any stuck legacy line and uninstall ISR */
                 val_exerciser_ops(CLEAR_INTR, e_intr_line, instance);
                 val_gic_end_of_interrupt(e_intr_line);
@@ -49,7 +49,7 @@ payload (void)
 
   uint32_t index;
   uint32_t e_bdf = 0, get_value = 0;
-  uint32_t timeout;
+  val_deadline_t deadline;
   uint32_t status;
   uint32_t num_cards;
   uint32_t num_smmus, num_group;
@@ -149,8 +149,8 @@ payload (void)
     val_exerciser_ops(GENERATE_MSI, msi_index, instance);
 
     /* PE busy polls to check the completion of interrupt service routine */
-    timeout = TIMEOUT_LARGE;
-    while ((--timeout > 0) && irq_pending)
+    val_deadline_start(&deadline, TIMEOUT_LARGE_US);
+    while (!val_deadline_expired(&deadline) && irq_pending)
         {};
 
     /* Interrupt must not be generated */
@@ -92,7 +92,7 @@ payload (void)
   uint32_t index;
   uint32_t e_bdf = 0;
   uint32_t req_bdf = 0;
-  uint32_t timeout;
+  val_deadline_t deadline;
   uint32_t status;
   uint32_t num_cards;
   uint32_t num_smmus;
@@ -189,8 +189,8 @@ payload (void)
     val_exerciser_ops(GENERATE_MSI, msi_index, req_instance);
 
     /* PE busy polls to check the completion of interrupt service routine */
-    timeout = TIMEOUT_MEDIUM;
-    while ((--timeout > 0) && irq_pending)
+    val_deadline_start(&deadline, TIMEOUT_MEDIUM_US);
+    while (!val_deadline_expired(&deadline) && irq_pending)
         {};
 
     /* Interrupt must not be generated */
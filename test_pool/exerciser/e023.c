@@ -214,7 +214,8 @@ inject_error(uint32_t e_bdf, uint32_t instance, uint32_t aer_offset)
 {
     uint32_t err_code;
     uint32_t status, value;
-    uint32_t res, timeout;
+    val_deadline_t deadline;
+    uint32_t res;
 
     for (err_code = 0; err_code <= ERR_CNT; err_code++)
     {
@@ -228,11 +229,11 @@ inject_error(uint32_t e_bdf, uint32_t instance, uint32_t aer_offset)
         if (msi_check == 1)
         {
             if (mask_value == 0) {
-                timeout = TIMEOUT_LARGE;
-                while ((--timeout > 0) && irq_pending)
+                val_deadline_start(&deadline, TIMEOUT_LARGE_US);
+                while (!val_deadline_expired(&deadline) && irq_pending)
                 {};
 
-                if (timeout == 0)
+                if (val_deadline_timed_out(&deadline))
                 {
                     val_gic_free_irq(irq_pending, 0);
                     val_print(ERROR,
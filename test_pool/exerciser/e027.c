@@ -153,7 +153,7 @@ payload(void)
   uint32_t rp_dpc_cap_base;
   uint32_t aer_offset;
   uint32_t rp_aer_offset;
-  uint32_t timeout;
+  val_deadline_t deadline;
 
   uint32_t device_id = 0;
   uint32_t stream_id = 0;
@@ -291,11 +291,11 @@ payload(void)
               fail_cnt++;
           }
 
-          timeout = TIMEOUT_LARGE;
-          while ((--timeout > 0) && irq_pending)
+          val_deadline_start(&deadline, TIMEOUT_LARGE_US);
+          while (!val_deadline_expired(&deadline) && irq_pending)
           {};
 
-          if (timeout == 0) {
+          if (val_deadline_timed_out(&deadline)) {
               val_gic_free_irq(irq_pending, 0);
               val_print(ERROR, "\n       Interrupt trigger failed for bdf 0x%lx", e_bdf);
               fail_cnt++;
@@ -315,9 +315,7 @@ payload(void)
           reg_value = reg_value & ~BRIDGE_CTRL_SBR_SET;
           val_pcie_write_cfg(erp_bdf, TYPE01_ILR, reg_value);
 
-          timeout = TIMEOUT_LARGE;
-          while (--timeout)
-          {};
+          val_deadline_wait_us(TIMEOUT_LARGE_US);
 
           status = val_pcie_data_link_layer_status(erp_bdf);
           if (status != PCIE_DLL_LINK_ACTIVE_NOT_SUPPORTED)
@@ -58,7 +58,6 @@ payload()
   uint32_t data;
   uint32_t fail_cnt = 0;
   uint32_t test_skip = 1;
-  uint32_t timeout;
   exception = 0;
 
   pe_index = val_pe_get_index_mpid(val_pe_get_mpid());
@@ -133,8 +132,7 @@ payload()
       test_skip = 0;
 
       bar_data = (*(volatile addr_t *)e_data.bar_space.base_addr);
-      timeout = TIMEOUT_SMALL;
-      while (--timeout > 0);
+      val_deadline_wait_us(TIMEOUT_SMALL_US);
 
 exception_return:
       /*
@@ -49,7 +49,7 @@ payload (void)
 {
   uint32_t index;
   uint32_t e_bdf = 0;
-  uint32_t timeout;
+  val_deadline_t deadline;
   uint32_t status;
   uint32_t num_cards;
   uint32_t num_smmus;
@@ -140,11 +140,11 @@ payload (void)
     val_exerciser_ops(GENERATE_MSI, msi_index, instance);
 
     /* PE busy polls to check the completion of interrupt service routine */
-    timeout = TIMEOUT_LARGE;
-    while ((--timeout > 0) && irq_pending)
+    val_deadline_start(&deadline, TIMEOUT_LARGE_US);
+    while (!val_deadline_expired(&deadline) && irq_pending)
         {};
 
-    if (timeout == 0) {
+    if (val_deadline_timed_out(&deadline)) {
         val_print(ERROR,
             "\n       Interrupt trigger failed for : 0x%x, ", lpi_int_id + instance);
         val_print(ERROR,
@@ -41,7 +41,7 @@ void
 payload()
 {
   /* Check non-secure physical timer Private Peripheral Interrupt (PPI) assignment */
-  uint32_t timeout = TIMEOUT_LARGE;
+  val_deadline_t deadline;
   uint32_t timer_expire_val = 100;
   uint32_t index = val_pe_get_index_mpid(val_pe_get_mpid());
 
@@ -60,11 +60,12 @@ payload()
 
   val_timer_set_phy_el1(timer_expire_val);
 
-  while ((--timeout > 0) && (IS_RESULT_PENDING(val_get_status(index)))) {
+  val_deadline_start(&deadline, TIMEOUT_LARGE_US);
+  while (!val_deadline_expired(&deadline) && (IS_RESULT_PENDING(val_get_status(index)))) {
         ;
   }
 
-  if (timeout == 0) {
+  if (val_deadline_timed_out(&deadline)) {
     val_print(ERROR,
         "\n       EL0-Phy timer interrupt not received on INTID: %d   ", intid);
     val_set_status(index, RESULT_FAIL(3));
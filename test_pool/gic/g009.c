@@ -48,7 +48,7 @@ payload()
 
     /*Check CNTHV interrupt received*/
     uint32_t data;
-    uint32_t timeout = TIMEOUT_LARGE;
+    val_deadline_t deadline;
     uint64_t timer_expire_val = 100;
     uint32_t index = val_pe_get_index_mpid(val_pe_get_mpid());
 
@@ -92,11 +92,12 @@ payload()
     }
 
     val_timer_set_vir_el2(timer_expire_val);
-    while ((--timeout > 0) && (IS_RESULT_PENDING(val_get_status(index)))) {
+    val_deadline_start(&deadline, TIMEOUT_LARGE_US);
+    while (!val_deadline_expired(&deadline) && (IS_RESULT_PENDING(val_get_status(index)))) {
         ;
     }
 
-    if (timeout == 0) {
+    if (val_deadline_timed_out(&deadline)) {
         val_print(ERROR,
             "\n       NS EL2 Virtual timer interrupt %d not received", intid);
         val_set_status(index, RESULT_FAIL(4));
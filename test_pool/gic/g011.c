@@ -55,7 +55,7 @@ payload()
 
     /*Check GIC Maintenance interrupt received*/
     uint32_t data;
-    uint32_t timeout = TIMEOUT_LARGE;
+    val_deadline_t deadline;
     uint32_t index = val_pe_get_index_mpid(val_pe_get_mpid());
 
     if (val_pe_reg_read(CurrentEL) == AARCH64_EL1) {
@@ -91,11 +91,12 @@ payload()
     data |= 0x7;
     val_gic_reg_write(ICH_HCR_EL2, data);
 
-    while ((--timeout > 0) && (IS_RESULT_PENDING(val_get_status(index)))) {
+    val_deadline_start(&deadline, TIMEOUT_LARGE_US);
+    while (!val_deadline_expired(&deadline) && (IS_RESULT_PENDING(val_get_status(index)))) {
         ;
     }
 
-    if (timeout == 0) {
+    if (val_deadline_timed_out(&deadline)) {
         val_print(ERROR, "\n       Interrupt not received within timeout");
         val_set_status(index, RESULT_FAIL(4));
         return;
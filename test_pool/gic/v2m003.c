@@ -45,7 +45,7 @@ payload()
 
   uint32_t num_spi;
   uint32_t instance;
-  uint32_t timeout = TIMEOUT_MEDIUM;
+  val_deadline_t deadline;
   uint32_t msi_frame, min_spi_id;
   uint64_t frame_base;
   uint32_t index = val_pe_get_index_mpid(val_pe_get_mpid());
@@ -76,11 +76,11 @@ payload()
     /* Generate the Interrupt by writing the int_id to SETSPI_NS Register */
     val_mmio_write(frame_base + GICv2m_MSI_SETSPI, int_id);
 
-    while ((timeout > 0) && (IS_RESULT_PENDING(val_get_status(index)))) {
-      timeout--;
-    }
+    val_deadline_start(&deadline, TIMEOUT_MEDIUM_US);
+    while (!val_deadline_expired(&deadline) && (IS_RESULT_PENDING(val_get_status(index))))
+      ;
 
-    if (timeout == 0) {
+    if (val_deadline_timed_out(&deadline)) {
       val_print(ERROR, "\n       Interrupt not received within timeout");
       val_set_status(index, RESULT_FAIL(2));
       return;
@@ -90,11 +90,11 @@ payload()
     /* Generate the Interrupt by writing the int_id to SETSPI_NS Register */
     val_mmio_write16(frame_base + GICv2m_MSI_SETSPI, int_id);
 
-    while ((timeout > 0) && (IS_RESULT_PENDING(val_get_status(index)))) {
-      timeout--;
-    }
+    val_deadline_start(&deadline, TIMEOUT_MEDIUM_US);
+    while (!val_deadline_expired(&deadline) && (IS_RESULT_PENDING(val_get_status(index))))
+      ;
 
-    if (timeout == 0) {
+    if (val_deadline_timed_out(&deadline)) {
       val_print(ERROR, "\n       Interrupt not received within timeout");
       val_set_status(index, RESULT_FAIL(3));
       return;
@@ -71,7 +71,7 @@ void payload(void)
     uint32_t pe_index;
     uint32_t status;
     uint32_t total_nodes;
-    uint32_t timeout;
+    val_deadline_t deadline;
     uint32_t intr_count = 0;
 
     pe_index = val_pe_get_index_mpid(val_pe_get_mpid());
@@ -133,12 +133,12 @@ void payload(void)
         val_mpam_msc_trigger_intr(msc_index);
 
         /* PE busy polls to check the completion of interrupt service routine */
-        timeout = TIMEOUT_LARGE;
-        while ((--timeout > 0) && (IS_RESULT_PENDING(val_get_status(pe_index))));
+        val_deadline_start(&deadline, TIMEOUT_LARGE_US);
+        while (!val_deadline_expired(&deadline) && (IS_RESULT_PENDING(val_get_status(pe_index))));
 
         /* Restore Error Control Register original settings (safety net) */
         val_mpam_mmr_write(msc_index, REG_MPAMF_ECR, mpamf_ecr_saved);
-        if (timeout == 0) {
+        if (val_deadline_timed_out(&deadline)) {
             val_print(ERROR, "\n       MSC Err Interrupt not received on %d", intr_num);
             val_set_status(pe_index, RESULT_FAIL(03));
             return;
@@ -64,7 +64,7 @@ void payload(void)
     uint32_t rsrc_node_cnt;
     uint32_t rsrc_index;
     uint64_t mpam2_el2;
-    uint64_t timeout;
+    val_deadline_t deadline;
     uint32_t status;
     uint64_t buf_size = 0;
     uint64_t base = 0;
@@ -175,8 +175,8 @@ void payload(void)
             val_time_delay_ms(TIMEOUT_MEDIUM);
 
             /* PE busy polls to check the completion of interrupt service routine */
-            timeout = TIMEOUT_LARGE;
-            while ((--timeout > 0) && (isr_completion_flag == 0));
+            val_deadline_start(&deadline, TIMEOUT_LARGE_US);
+            while (!val_deadline_expired(&deadline) && (isr_completion_flag == 0));
 
             val_print(DEBUG, "\n       MSMON_CFG_MBWU_CTL is %llx",
                                             val_mpam_mmr_read(msc_index, REG_MSMON_CFG_MBWU_CTL));
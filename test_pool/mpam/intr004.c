@@ -155,7 +155,7 @@ void payload(void)
     uint32_t test_fail = 0;
     uint32_t test_skip = 1;
     uint32_t intr_enabled = 0;
-    uint64_t timeout;
+    val_deadline_t deadline;
     uint64_t buf_size = TEST_BUF_SIZE;
     uint64_t base = 0;
     uint64_t mem_size = 0;
@@ -251,10 +251,11 @@ void payload(void)
                 goto monitor_cleanup;
             }
 
-            timeout = TIMEOUT_LARGE;
-            while ((--timeout > 0) && (IS_RESULT_PENDING(val_get_status(pe_index))));
+            val_deadline_start(&deadline, TIMEOUT_LARGE_US);
+            while (!val_deadline_expired(&deadline) &&
+                   (IS_RESULT_PENDING(val_get_status(pe_index))));
 
-            if (timeout == 0) {
+            if (val_deadline_timed_out(&deadline)) {
                 val_print(ERROR,
                     "\n       Overflow interrupt not received for MSC %d", msc_index);
                 test_fail++;
@@ -145,7 +145,7 @@ void payload(void)
     uint32_t msmon_idr;
     uint32_t device_id = 0;
     uint32_t its_id = 0;
-    uint64_t timeout;
+    val_deadline_t deadline;
     uint64_t buf_size = TEST_BUF_SIZE;
     uint64_t base = 0;
     uint64_t mem_size = 0;
@@ -268,10 +268,11 @@ void payload(void)
                 goto monitor_cleanup;
             }
 
-            timeout = TIMEOUT_LARGE;
-            while ((--timeout > 0) && (IS_RESULT_PENDING(val_get_status(pe_index))));
+            val_deadline_start(&deadline, TIMEOUT_LARGE_US);
+            while (!val_deadline_expired(&deadline) &&
+                   (IS_RESULT_PENDING(val_get_status(pe_index))));
 
-            if (timeout == 0) {
+            if (val_deadline_timed_out(&deadline)) {
                 val_print(ERROR,
                     "\n       Overflow MSI not received for MSC %d", msc_index);
                 test_fail++;
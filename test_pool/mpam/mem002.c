@@ -21,6 +21,7 @@
 #include "acs_memory.h"
 #include "acs_mpam_reg.h"
 #include "val_interface.h"
+#include "val_sync.h"
 
 #define TEST_NUM   ACS_MPAM_MEMORY_TEST_NUM_BASE  +  2
 #define TEST_DESC  "Check MBWMIN Partitioning             "
@@ -34,6 +35,7 @@
 
 static uint8_t contend_flag;
 static uint32_t num_pe_cont;
+static val_sync_gate_t contend_gate;
 static void *branch_to_test;
 
 static
@@ -55,9 +57,9 @@ static int wait_for_secondary_off(uint32_t primary_pe_index)
 
     uint32_t pe_index;
     uint32_t payload_status;
-    uint64_t timeout;
+    val_deadline_t deadline;
 
-    timeout = (num_pe_cont * TIMEOUT_LARGE);
+    val_deadline_start(&deadline, num_pe_cont * TIMEOUT_LARGE_US);
 
     /* Wait for all pe OFF or timeout, whichever is first */
     do {
@@ -69,10 +71,10 @@ static int wait_for_secondary_off(uint32_t primary_pe_index)
                 payload_status |= IS_RESULT_PENDING(val_get_status(pe_index));
             }
         }
-    } while (payload_status && (--timeout));
+    } while (payload_status && !val_deadline_expired(&deadline));
 
     /* Print all pending pe indices to console at timeout */
-    if (!timeout) {
+    if (val_deadline_timed_out(&deadline)) {
 
         for (pe_index = 0; pe_index < num_pe_cont; pe_index++) {
 
@@ -166,6 +168,10 @@ static void payload_secondary(void)
         return;
     }
 
+    /* Start the traffic together with the other PEs */
+    if (val_sync_gate_wait(&contend_gate) != ACS_STATUS_PASS)
+        val_print(WARN, "\n       PE %d started contention without the other PEs", pe_index);
+
     /* Generate memory bandwidth contention via PE traffic */
     while (contend_flag) {
         val_memcpy((void *)src_buf, (void *)dest_buf, buf_size);
@@ -340,6 +346,10 @@ payload_primary(void)
                 contend_flag = 1;
                 val_data_cache_ops_by_va((addr_t)&contend_flag, CLEAN);
 
+                /* All contending PEs and this PE start their copies together */
+                val_sync_gate_init(&contend_gate, num_pe_cont +
+                                   ((primary_pe_index < num_pe_cont) ? 0 : 1), 0);
+
                 /* Create bandwidth contention on the current memory node */
                 for (pe_index = 0; pe_index < num_pe_cont; pe_index++) {
 
@@ -352,6 +362,8 @@ payload_primary(void)
                 if (!val_mpam_get_mbwumon_count(msc_index)) {
                     val_print(INFO,
                         "\n       No MBWU Monitor found to validate the test. Skipping test");
+                        /* Release the contending PEs waiting for this PE */
+                        val_sync_gate_wait(&contend_gate);
                         val_set_status(pe_index, RESULT_SKIP(02));
                         contend_flag = 0;
                         return;
@@ -371,6 +383,9 @@ payload_primary(void)
                     --nrdy_timeout;
                 };
 
+                if (val_sync_gate_wait(&contend_gate) != ACS_STATUS_PASS)
+                    val_print(WARN, "\n       Contending PEs did not reach the start gate");
+
                 start_count = val_mpam_memory_mbwumon_read_count(msc_index);
                 val_print(INFO, "\n       Start Count = 0x%llx", start_count);
                 /* perform memory operation */
@@ -410,6 +425,10 @@ payload_primary(void)
                 contend_flag = 1;
                 val_data_cache_ops_by_va((addr_t)&contend_flag, CLEAN);
 
+                /* All contending PEs and this PE start their copies together */
+                val_sync_gate_init(&contend_gate, num_pe_cont +
+                                   ((primary_pe_index < num_pe_cont) ? 0 : 1), 0);
+
                 /* Create bandwidth contention on the current memory node */
                 for (pe_index = 0; pe_index < num_pe_cont; pe_index++) {
                     if (pe_index != primary_pe_index) {
@@ -427,6 +446,9 @@ payload_primary(void)
                     --nrdy_timeout;
                 };
 
+                if (val_sync_gate_wait(&contend_gate) != ACS_STATUS_PASS)
+                    val_print(WARN, "\n       Contending PEs did not reach the start gate");
+
                 start_count = val_mpam_memory_mbwumon_read_count(msc_index);
                 val_print(INFO, "\n       Start Count = 0x%llx", start_count);
 
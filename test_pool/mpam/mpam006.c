@@ -248,17 +248,18 @@ payload(void)
         return;
     }
 
-    /*Allocate memory for source and destination buffers */
-    src_buf = (void *)val_aligned_alloc(MEM_ALIGN_4K, BUFFER_SIZE);
-    dest_buf = (void *)val_aligned_alloc(MEM_ALIGN_4K, BUFFER_SIZE);
+    /*Allocate memory for source and destination buffers, mapped by 2MB blocks
+      where possible so the copies are not dominated by TLB refills */
+    src_buf = (void *)val_memory_alloc_contig(BUFFER_SIZE, MEM_CONTIG_2MB, NULL);
+    dest_buf = (void *)val_memory_alloc_contig(BUFFER_SIZE, MEM_CONTIG_2MB, NULL);
 
     if ((src_buf == NULL) || (dest_buf == NULL)) {
         val_print(ERROR, "\n       Mem allocation failed");
         val_set_status(index, RESULT_FAIL(04));
         if (dest_buf != NULL)
-            val_memory_free_aligned(dest_buf);
+            val_memory_free_contig(dest_buf);
         if (src_buf != NULL)
-            val_memory_free_aligned(src_buf);
+            val_memory_free_contig(src_buf);
         return;
     }
 
@@ -338,8 +339,8 @@ payload(void)
         val_mpam_reg_write(MPAM2_EL2, mpam2_el2_temp);
 
         /*Free the buffers */
-        val_memory_free_aligned(src_buf);
-        val_memory_free_aligned(dest_buf);
+        val_memory_free_contig(src_buf);
+        val_memory_free_contig(dest_buf);
 
         return;
     }
@@ -348,8 +349,8 @@ payload(void)
     val_mpam_reg_write(MPAM2_EL2, mpam2_el2_temp);
 
     /*Free the buffers */
-    val_memory_free_aligned(src_buf);
-    val_memory_free_aligned(dest_buf);
+    val_memory_free_contig(src_buf);
+    val_memory_free_contig(dest_buf);
 
     val_set_status(index, RESULT_PASS);
     return;
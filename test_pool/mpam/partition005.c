@@ -70,7 +70,6 @@ payload(void)
     uint32_t page_size;
     uint32_t num_pages;
     volatile uint64_t nrdy_timeout = 0;
-    volatile uint64_t buf_timeout  = 0;
 
     uint32_t msc_index, rsrc_index, rsrc_cnt;
     uint64_t saved_el2;
@@ -203,10 +202,7 @@ payload(void)
             val_time_delay_ms(TIMEOUT_MEDIUM);
 
             /* wait for some time till memcpy settles */
-            buf_timeout = TIMEOUT_MEDIUM;
-            while (buf_timeout) {
-                --buf_timeout;
-            };
+            val_deadline_wait_us(TIMEOUT_MEDIUM_US);
 
             /* Step 6 - Read the Cache line count used by PARTID X from CSU MON */
             counter[0] = val_mpam_read_csumon(msc_index);
@@ -232,10 +228,7 @@ payload(void)
             val_time_delay_ms(TIMEOUT_MEDIUM);
 
             /* wait for some time till memcpy settles */
-            buf_timeout = TIMEOUT_MEDIUM;
-            while (buf_timeout) {
-                --buf_timeout;
-            };
+            val_deadline_wait_us(TIMEOUT_MEDIUM_US);
 
             /* Step 8: Disable PARTID_Y. The disabled PARTID's cache will have higher priority of
                        eviction */
@@ -275,10 +268,7 @@ payload(void)
             val_time_delay_ms(TIMEOUT_MEDIUM);
 
             /* wait for some time till memcpy settles */
-            buf_timeout = TIMEOUT_MEDIUM;
-            while (buf_timeout) {
-                --buf_timeout;
-            };
+            val_deadline_wait_us(TIMEOUT_MEDIUM_US);
 
             /* Step 11: Measure cache usage again with the CSU monitor */
             counter[1] = val_mpam_read_csumon(msc_index);
@@ -110,7 +110,6 @@ payload(void)
   bool skip_flag = acs_policy_get_pcie_skip_dp_nic_ms();
   uint64_t bar_base;
   uint32_t status;
-  uint32_t timeout;
 
   pcie_device_bdf_table *bdf_tbl_ptr;
 
@@ -206,8 +205,7 @@ payload(void)
        * even cause an sync/async exception.
        */
       bar_data = (*(volatile addr_t *)bar_base);
-      timeout = TIMEOUT_SMALL;
-      while (--timeout > 0);
+      val_deadline_wait_us(TIMEOUT_SMALL_US);
 
 exception_return:
       /*
@@ -123,7 +123,6 @@ payload(void *arg)
   uint64_t bar_base;
   uint32_t dp_type;
   uint32_t status;
-  uint32_t timeout;
   test_data_t *test_data = (test_data_t *)arg;
 
   pcie_device_bdf_table *bdf_tbl_ptr;
@@ -245,8 +244,7 @@ payload(void *arg)
        * even cause an sync/async exception.
        */
       bar_data = (*(volatile addr_t *)bar_base);
-      timeout = TIMEOUT_SMALL;
-      while (--timeout > 0);
+      val_deadline_wait_us(TIMEOUT_SMALL_US);
 
 exception_return:
       /*
@@ -71,7 +71,7 @@ payload(void)
   bool skip_due_to_flag = false;
   bool skip_flag = acs_policy_get_pcie_skip_dp_nic_ms();
   uint32_t idx;
-  uint32_t timeout;
+  val_deadline_t deadline;
   uint32_t status;
   uint32_t device_id, vendor_id;
   addr_t config_space_addr;
@@ -165,8 +165,8 @@ payload(void)
            * ready to respond to configuration read. Hence check
            * for the vendor id to be 0x0001 to ensure device is
            * initilaised and ready to respond */
-          timeout = (5 * TIMEOUT_LARGE);
-          while (timeout-- > 0)
+          val_deadline_start(&deadline, 5 * TIMEOUT_LARGE_US);
+          while (!val_deadline_expired(&deadline))
           {
               val_pcie_read_cfg(bdf, 0, &reg_value);
               vendor_id = reg_value & TYPE01_VIDR_MASK;
@@ -304,7 +304,7 @@ payload(uint32_t num_pe)
 {
   uint32_t my_index = val_pe_get_index_mpid(val_pe_get_mpid());
   uint32_t i, j, t = 0;
-  uint32_t timeout;
+  val_deadline_t deadline;
   uint64_t reg_read_data;
   uint64_t total_fail = 0;
   uint64_t reg_fail = 0;
@@ -360,11 +360,11 @@ payload(uint32_t num_pe)
 
   for (i = 0; i < num_pe; i++) {
       if (i != my_index) {
-          timeout = TIMEOUT_LARGE;
+          val_deadline_start(&deadline, TIMEOUT_LARGE_US);
           val_execute_on_pe(i, id_regs_check, (uint64_t)g_pe_reg_info);
-          while ((--timeout) && (IS_RESULT_PENDING(val_get_status(i))));
+          while (!val_deadline_expired(&deadline) && (IS_RESULT_PENDING(val_get_status(i))));
 
-          if(timeout == 0) {
+          if (val_deadline_timed_out(&deadline)) {
               val_print(ERROR, "\n       **Timed out** for PE index = %d", i);
               val_set_status(i, RESULT_FAIL(3));
               return;
@@ -47,7 +47,8 @@ static void payload_all_pe_version_check(void *arg)
 {
   uint32_t index = val_pe_get_index_mpid(val_pe_get_mpid());
   uint32_t num_pe = *((uint32_t *)arg);
-  uint32_t timeout, i = 0, major = 0, minor = 0;
+  val_deadline_t deadline;
+  uint32_t i = 0, major = 0, minor = 0;
   uint32_t test_fail = 0;
   PFDI_RET_PARAMS *pfdi_buffer;
   int64_t version = 0;
@@ -71,12 +72,12 @@ static void payload_all_pe_version_check(void *arg)
   /* Execute pfdi_version_check function in All PE's */
   for (i = 0; i < num_pe; i++) {
     if (i != index) {
-      timeout = TIMEOUT_LARGE;
+      val_deadline_start(&deadline, TIMEOUT_LARGE_US);
       val_execute_on_pe(i, pfdi_version_check, (uint64_t)g_pfdi_version_details);
 
-      while ((--timeout) && (IS_RESULT_PENDING(val_get_status(i))));
+      while (!val_deadline_expired(&deadline) && (IS_RESULT_PENDING(val_get_status(i))));
 
-      if (timeout == 0) {
+      if (val_deadline_timed_out(&deadline)) {
         val_print(ERROR, "\n       **Timed out** for PE index = %d", i);
         val_set_status(i, RESULT_FAIL(2));
         goto free_pfdi_details;
@@ -49,7 +49,8 @@ static void payload_pe_test_id_check(void *arg)
   uint32_t num_pe = *((uint32_t *)arg);
   int64_t test_fail = 0;
   int64_t version, temp_status;
-  uint32_t timeout, i = 0, major, minor, vendor_id;
+  val_deadline_t deadline;
+  uint32_t i = 0, major, minor, vendor_id;
   PFDI_RET_PARAMS *pfdi_buffer;
 
   /* Allocate memory to save all PFDI Self Test Versions for all PE's */
@@ -73,12 +74,12 @@ static void payload_pe_test_id_check(void *arg)
   /* Execute pfdi_st_version_check function in All PE's */
   for (i = 0; i < num_pe; i++) {
     if (i != index) {
-      timeout = TIMEOUT_LARGE;
+      val_deadline_start(&deadline, TIMEOUT_LARGE_US);
       val_execute_on_pe(i, pfdi_st_version_check, (uint64_t)g_pfdi_st_version_details);
 
-      while ((--timeout) && (IS_RESULT_PENDING(val_get_status(i))));
+      while (!val_deadline_expired(&deadline) && (IS_RESULT_PENDING(val_get_status(i))));
 
-      if (timeout == 0) {
+      if (val_deadline_timed_out(&deadline)) {
         val_print(ERROR, "\n       **Timed out** for PE index = %d", i);
         val_set_status(i, RESULT_FAIL(5));
         goto free_pfdi_details;
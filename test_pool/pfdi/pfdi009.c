@@ -46,7 +46,8 @@ pfdi_fw_check(void)
 static void payload_fw_check(void *arg)
 {
   uint32_t index = val_pe_get_index_mpid(val_pe_get_mpid());
-  uint32_t timeout, i = 0, test_fail = 0;
+  val_deadline_t deadline;
+  uint32_t i = 0, test_fail = 0;
   PFDI_RET_PARAMS *pfdi_buffer;
   uint32_t num_pe = *(uint32_t *)arg;
 
@@ -71,12 +72,12 @@ static void payload_fw_check(void *arg)
   /* Execute pfdi_fw_check function in All PE's */
   for (i = 0; i < num_pe; i++) {
     if (i != index) {
-      timeout = TIMEOUT_LARGE;
+      val_deadline_start(&deadline, TIMEOUT_LARGE_US);
       val_execute_on_pe(i, pfdi_fw_check, 0);
 
-      while ((--timeout) && (IS_RESULT_PENDING(val_get_status(i))));
+      while (!val_deadline_expired(&deadline) && (IS_RESULT_PENDING(val_get_status(i))));
 
-      if (timeout == 0) {
+      if (val_deadline_timed_out(&deadline)) {
         val_print(ERROR, "\n       **Timed out** for PE index = %d", i);
         val_set_status(i, RESULT_FAIL(3));
         goto free_pfdi_details;
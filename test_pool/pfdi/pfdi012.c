@@ -285,7 +285,8 @@ static void pfdi_error_recovery(void)
 static void payload_pfdi_error_injection(void *arg)
 {
   uint32_t index = val_pe_get_index_mpid(val_pe_get_mpid());
-  uint32_t timeout = 0, i = 0, j = 0, run_fail = 0;
+  val_deadline_t deadline;
+  uint32_t i = 0, j = 0, run_fail = 0;
   pfdi_force_error_check *pfdi_buffer;
   uint32_t num_pe = *(uint32_t *)arg;
 
@@ -312,12 +313,12 @@ static void payload_pfdi_error_injection(void *arg)
   /* Execute check_invalid_fn function in All PE's */
   for (i = 0; i < num_pe; i++) {
     if (i != index) {
-      timeout = TIMEOUT_LARGE;
+      val_deadline_start(&deadline, TIMEOUT_LARGE_US);
       val_execute_on_pe(i, pfdi_error_injection, 0);
 
-      while ((--timeout) && (IS_RESULT_PENDING(val_get_status(i))));
+      while (!val_deadline_expired(&deadline) && (IS_RESULT_PENDING(val_get_status(i))));
 
-      if (timeout == 0) {
+      if (val_deadline_timed_out(&deadline)) {
         val_print(ERROR, "\n       **Timed out** for PE index = %d", i);
         val_set_status(i, RESULT_FAIL(2));
         goto free_pfdi_details;
@@ -375,7 +376,8 @@ free_pfdi_details:
 static void payload_pfdi_error_recovery_check(void *arg)
 {
   uint32_t index = val_pe_get_index_mpid(val_pe_get_mpid());
-  uint32_t timeout = 0, i = 0, j = 0, run_fail = 0, run_skip = 0;
+  val_deadline_t deadline;
+  uint32_t i = 0, j = 0, run_fail = 0, run_skip = 0;
   pfdi_err_recovery_check *rec_buffer;
   uint32_t num_pe = *(uint32_t *)arg;
 
@@ -405,12 +407,12 @@ static void payload_pfdi_error_recovery_check(void *arg)
   /* Execute check_invalid_fn function in All PE's */
   for (i = 0; i < num_pe; i++) {
     if (i != index) {
-      timeout = TIMEOUT_LARGE;
+      val_deadline_start(&deadline, TIMEOUT_LARGE_US);
       val_execute_on_pe(i, pfdi_error_recovery, 0);
 
-      while ((--timeout) && (IS_RESULT_PENDING(val_get_status(i))));
+      while (!val_deadline_expired(&deadline) && (IS_RESULT_PENDING(val_get_status(i))));
 
-      if (timeout == 0) {
+      if (val_deadline_timed_out(&deadline)) {
         val_print(ERROR, "\n       **Timed out** for PE index = %d", i);
         val_set_status(i, RESULT_FAIL(2));
         goto free_pfdi_error_recovery;
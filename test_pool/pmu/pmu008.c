@@ -58,7 +58,7 @@ static void payload2(void)
 static uint32_t generate_traffic(uint64_t prox_domain, uint32_t size, void (*remote_traffic)(void))
 {
     uint64_t prox_base_addr, addr_len;
-    uint32_t timeout = TIMEOUT_LARGE;
+    val_deadline_t deadline;
 
     prox_base_addr = val_srat_get_info(SRAT_MEM_BASE_ADDR, prox_domain);
     addr_len = val_srat_get_info(SRAT_MEM_ADDR_LEN, prox_domain);
@@ -84,7 +84,8 @@ static uint32_t generate_traffic(uint64_t prox_domain, uint32_t size, void (*rem
     val_execute_on_pe(remote_pe_index, remote_traffic, 0);
 
     /* Wait for execution to complete*/
-    while (--timeout)
+    val_deadline_start(&deadline, TIMEOUT_LARGE_US);
+    while (!val_deadline_expired(&deadline))
     {
         if (!(IS_RESULT_PENDING(val_get_status(remote_pe_index)))) {
             break;
@@ -23,6 +23,7 @@ set(_LINKER_CMAKE_LOADED TRUE)
 set(GNUARM_LINKER "${CROSS_COMPILE}ld" CACHE FILEPATH "The GNUARM linker" FORCE)
 set(GNUARM_OBJCOPY "${CROSS_COMPILE}objcopy" CACHE FILEPATH "The GNUARM objcopy" FORCE)
 set(GNUARM_OBJDUMP "${CROSS_COMPILE}objdump" CACHE FILEPATH "The GNUARM objdump" FORCE)
+set(GNUARM_SIZE "${CROSS_COMPILE}size" CACHE FILEPATH "The GNUARM size" FORCE)
 
 if(${ENABLE_PIE})
     set(LINKER_PIE_SWITCH "-pie --no-dynamic-linker")
@@ -48,6 +49,8 @@ function (create_executable EXE_NAME OUTPUT_DIR TEST)
     # Link the objects
     add_custom_command(OUTPUT ${EXE_NAME}${TEST}.elf
                     COMMAND ${GNUARM_LINKER} ${CMAKE_LINKER_FLAGS} -T ${SCATTER_OUTPUT_FILE} -o ${OUTPUT_DIR}/${EXE_NAME}.elf ${VAL_LIB}.a ${PAL_LIB}.a ${TEST_LIB}.a ${VAL_LIB}.a ${PAL_LIB}.a ${PAL_OBJ_LIST} -Map=${OUTPUT_DIR}/${EXE_NAME}.map
+                    # Report the image size, e.g. to compare ACS_PRINT_MIN_LEVEL builds
+                    COMMAND ${GNUARM_SIZE} ${OUTPUT_DIR}/${EXE_NAME}.elf
                     DEPENDS CPP-LD-${EXE_NAME}${TEST})
     add_custom_target(${EXE_NAME}${TEST}_elf ALL DEPENDS ${EXE_NAME}${TEST}.elf)
 
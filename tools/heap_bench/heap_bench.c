@@ -0,0 +1,199 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+/*
+ * Host stress benchmark of the baremetal PAL heap (pal/baremetal/base/src/pal_heap.c).
+ *
+ * Runs a random mix of allocations and frees with the sizes and alignments
+ * seen in ACS runs over a 64MB region, checks every payload for alignment and
+ * overlap with a fill pattern, and prints the alloc/free latency and the heap
+ * statistics reported by pal_mem_get_heap_stats().
+ *
+ * Build and run from the repository root:
+ *   cc -O2 -Itools/heap_bench -Ival/include -Ipal/include -Ipal/baremetal/base/include \
+ *      tools/heap_bench/heap_bench.c pal/baremetal/base/src/pal_heap.c -o heap_bench
+ *   ./heap_bench [operations] [seed]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "pal_heap.h"
+#include "pal_status.h"
+#include "platform_image_def.h"
+
+#define BENCH_SLOTS        4096
+#define BENCH_DEFAULT_OPS  2000000
+
+typedef struct {
+  uint8_t *ptr;
+  size_t   size;
+  uint8_t  fill;
+} bench_slot_t;
+
+uint8_t g_heap_bench_region[HEAP_BENCH_REGION_SIZE] __attribute__((aligned(4096)));
+
+static bench_slot_t g_slot[BENCH_SLOTS];
+static uint64_t     g_rng;
+
+static uint64_t
+bench_rand(void)
+{
+  /* xorshift64 */
+  g_rng ^= g_rng << 13;
+  g_rng ^= g_rng >> 7;
+  g_rng ^= g_rng << 17;
+  return g_rng;
+}
+
+static uint64_t
+bench_now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* Size mix of an ACS run: many small tables, some pages, few large buffers */
+static size_t
+bench_size(void)
+{
+  uint64_t pick = bench_rand() % 100;
+
+  if (pick < 70)
+    return 8 + bench_rand() % 256;
+  if (pick < 95)
+    return 256 + bench_rand() % 16384;
+  return 16384 + bench_rand() % (1024 * 1024);
+}
+
+static size_t
+bench_alignment(void)
+{
+  static const size_t align[] = {8, 8, 8, 8, 16, 64, 4096, 8192};
+
+  return align[bench_rand() % (sizeof(align) / sizeof(align[0]))];
+}
+
+static int
+bench_check(const bench_slot_t *slot)
+{
+  size_t i;
+
+  for (i = 0; i < slot->size; i++) {
+    if (slot->ptr[i] != slot->fill)
+      return 1;
+  }
+  return 0;
+}
+
+int
+main(int argc, char **argv)
+{
+  uint64_t ops = (argc > 1) ? strtoull(argv[1], NULL, 0) : BENCH_DEFAULT_OPS;
+  PAL_HEAP_STATS stats;
+  bench_slot_t *slot;
+  uint64_t alloc_ns = 0, free_ns = 0;
+  uint64_t alloc_max = 0, free_max = 0;
+  uint64_t allocs = 0, frees = 0, failures = 0;
+  uint64_t start, elapsed;
+  uint64_t op;
+  size_t alignment;
+  uint32_t i;
+
+  g_rng = (argc > 2) ? strtoull(argv[2], NULL, 0) : 0x9E3779B97F4A7C15ULL;
+  if (g_rng == 0)
+    g_rng = 1;
+
+  /* Fault the region in so page faults do not show up as allocator latency */
+  memset(g_heap_bench_region, 0, sizeof(g_heap_bench_region));
+
+  for (op = 0; op < ops; op++) {
+    slot = &g_slot[bench_rand() % BENCH_SLOTS];
+
+    if (slot->ptr != NULL) {
+      if (bench_check(slot)) {
+        printf("payload %p of %zu bytes corrupted\n", (void *)slot->ptr, slot->size);
+        return 1;
+      }
+      start = bench_now_ns();
+      mem_free(slot->ptr);
+      elapsed = bench_now_ns() - start;
+      free_ns += elapsed;
+      if (elapsed > free_max)
+        free_max = elapsed;
+      frees++;
+      slot->ptr = NULL;
+      continue;
+    }
+
+    slot->size = bench_size();
+    alignment = bench_alignment();
+    start = bench_now_ns();
+    slot->ptr = mem_alloc(alignment, slot->size);
+    elapsed = bench_now_ns() - start;
+    alloc_ns += elapsed;
+    if (elapsed > alloc_max)
+      alloc_max = elapsed;
+    allocs++;
+
+    if (slot->ptr == NULL) {
+      failures++;
+      continue;
+    }
+    if (((uintptr_t)slot->ptr & (alignment - 1)) != 0) {
+      printf("payload %p not aligned to %zu\n", (void *)slot->ptr, alignment);
+      return 1;
+    }
+    slot->fill = (uint8_t)bench_rand();
+    memset(slot->ptr, slot->fill, slot->size);
+  }
+
+  if (pal_mem_get_heap_stats(&stats) != PAL_STATUS_SUCCESS) {
+    printf("pal_mem_get_heap_stats failed\n");
+    return 1;
+  }
+
+  printf("operations      : %llu allocs, %llu frees, %llu failed allocs\n",
+         (unsigned long long)allocs, (unsigned long long)frees,
+         (unsigned long long)failures);
+  printf("alloc           : %llu ns average, %llu ns worst\n",
+         (unsigned long long)(allocs ? alloc_ns / allocs : 0), (unsigned long long)alloc_max);
+  printf("free            : %llu ns average, %llu ns worst\n",
+         (unsigned long long)(frees ? free_ns / frees : 0), (unsigned long long)free_max);
+  printf("heap            : %llu bytes, peak %llu in use, %llu in use now\n",
+         (unsigned long long)stats.heap_size, (unsigned long long)stats.peak_in_use,
+         (unsigned long long)stats.in_use);
+  printf("free blocks     : %u, largest %llu bytes, %u%% fragmented\n",
+         stats.free_blocks, (unsigned long long)stats.largest_free, stats.fragmentation);
+
+  /* Everything freed must coalesce back into a single block */
+  for (i = 0; i < BENCH_SLOTS; i++) {
+    if (g_slot[i].ptr != NULL)
+      mem_free(g_slot[i].ptr);
+  }
+  pal_mem_get_heap_stats(&stats);
+  if (stats.in_use != 0 || stats.free_blocks != 1 || stats.largest_free != stats.heap_size) {
+    printf("heap not fully coalesced after freeing everything: %u free blocks\n",
+           stats.free_blocks);
+    return 1;
+  }
+
+  return 0;
+}
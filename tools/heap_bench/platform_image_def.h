@@ -0,0 +1,32 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+/* Host stand-in for the target platform_image_def.h, used by heap_bench.c */
+
+#ifndef _PAL_CONFIG_H_
+#define _PAL_CONFIG_H_
+
+#include <stdint.h>
+
+#define HEAP_BENCH_REGION_SIZE     (64 * 0x100000)
+
+extern uint8_t g_heap_bench_region[];
+
+#define PLATFORM_HEAP_REGION_BASE  ((uintptr_t)g_heap_bench_region)
+#define PLATFORM_HEAP_REGION_SIZE  HEAP_BENCH_REGION_SIZE
+
+#endif /* _PAL_CONFIG_H_ */
@@ -0,0 +1,281 @@
+## @file
+ # Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ # SPDX-License-Identifier : Apache-2.0
+ #
+ # Licensed under the Apache License, Version 2.0 (the "License");
+ # you may not use this file except in compliance with the License.
+ # You may obtain a copy of the License at
+ #
+ #  http://www.apache.org/licenses/LICENSE-2.0
+ #
+ # Unless required by applicable law or agreed to in writing, software
+ # distributed under the License is distributed on an "AS IS" BASIS,
+ # WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ # See the License for the specific language governing permissions and
+ # limitations under the License.
+ ##
+
+"""Decode the binary log of a Baremetal ACS image built with ACS_BINARY_LOG.
+
+The image keeps DEBUG/TRACE prints unformatted (val/src/val_binlog.c) and
+prints them as BINLOG hex lines when a rule fails. This script rebuilds the
+text from the format strings in the .rodata of the ELF image.
+
+Input is either a console log holding BINLOG lines, or with --raw a memory
+dump of the g_binlog symbol.
+
+Usage:
+  python3 tools/scripts/decode_binlog.py <image.elf> <console.log>
+  python3 tools/scripts/decode_binlog.py --raw <image.elf> <g_binlog.bin>
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+BINLOG_MAGIC = 0x474F4C42
+BINLOG_VERSION = 1
+HDR_FORMAT = "<IIQQII"
+HDR_SIZE = struct.calcsize(HDR_FORMAT)
+SLOT_WORDS = 13
+SLOT_FORMAT = "<IBBBBIIQ%dQ" % SLOT_WORDS
+SLOT_SIZE = struct.calcsize(SLOT_FORMAT)
+FMT_INLINE = 0xFFFFFFFF
+FLAG_TRUNCATED = 0x1
+INLINE_STR_TAG = 0xFF
+LEVEL_NAMES = {1: "TRACE", 2: "DEBUG", 3: "INFO", 4: "WARN", 5: "ERROR", 6: "FATAL"}
+
+CONVERSION_RE = re.compile(r"%([-+ #0]*)(\*|\d*)(hh|h|ll|l)?([a-zA-Z%])")
+
+
+class ElfImage:
+    """Read-only view of the .rodata of an ELF64 little-endian image."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = f.read()
+        if self.data[:4] != b"\x7fELF" or self.data[4] != 2 or self.data[5] != 1:
+            raise ValueError("%s is not an ELF64 little-endian image" % path)
+
+        shoff, = struct.unpack_from("<Q", self.data, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from("<HHH", self.data, 0x3A)
+        sections = []
+        for i in range(shnum):
+            sections.append(struct.unpack_from("<IIQQQQIIQQ", self.data, shoff + i * shentsize))
+
+        names_off = sections[shstrndx][4]
+        self.rodata = None
+        self.symtab = None
+        for sec in sections:
+            name = self._cstr(names_off + sec[0])
+            if name == ".rodata":
+                self.rodata = sec
+            elif name == ".symtab":
+                self.symtab = sec
+        if self.rodata is None:
+            raise ValueError("%s has no .rodata section" % path)
+
+        # Link address of __RODATA_START__, the .rodata start if not found
+        self.rodata_start = self._symbol("__RODATA_START__", sections)
+        if self.rodata_start is None:
+            self.rodata_start = self.rodata[3]
+
+    def _cstr(self, offset):
+        end = self.data.index(b"\0", offset)
+        return self.data[offset:end].decode("ascii", "replace")
+
+    def _symbol(self, wanted, sections):
+        if self.symtab is None:
+            return None
+        strtab = sections[self.symtab[6]]
+        for off in range(self.symtab[4], self.symtab[4] + self.symtab[5], 24):
+            name, _, _, _, value, _ = struct.unpack_from("<IBBHQQ", self.data, off)
+            if self._cstr(strtab[4] + name) == wanted:
+                return value
+        return None
+
+    def string_at(self, rodata_offset):
+        """String at an offset from __RODATA_START__, None if outside .rodata."""
+        addr = self.rodata_start + rodata_offset
+        sec_addr, sec_off, sec_size = self.rodata[3], self.rodata[4], self.rodata[5]
+        if addr < sec_addr or addr >= sec_addr + sec_size:
+            return None
+        return self._cstr(sec_off + addr - sec_addr)
+
+
+def inline_string(words, index):
+    """Decode an inline string starting at words[index], return (text, words used)."""
+    length = words[index] & 0xFFFFFFFF
+    nwords = (length + 7) // 8
+    raw = b"".join(struct.pack("<Q", w) for w in words[index + 1:index + 1 + nwords])
+    return raw[:length].decode("ascii", "replace"), 1 + nwords
+
+
+def to_signed(value, bits):
+    value &= (1 << bits) - 1
+    return value - (1 << bits) if value >> (bits - 1) else value
+
+
+def format_record(fmt, words, image, rodata_start):
+    """printf-style formatting following val_log() in val/src/val_logger.c."""
+    out = []
+    pos = 0
+    arg = 0
+
+    def next_word():
+        nonlocal arg
+        if arg >= len(words):
+            raise IndexError
+        value = words[arg]
+        arg += 1
+        return value
+
+    for match in CONVERSION_RE.finditer(fmt):
+        out.append(fmt[pos:match.start()])
+        pos = match.end()
+        flags, width, length, conv = match.groups()
+        bits = {"hh": 8, "h": 16, "l": 64, "ll": 64}.get(length, 32)
+        try:
+            if width == "*":
+                width = to_signed(next_word(), 32)
+                if width < 0:
+                    flags += "-"
+                    width = -width
+            width = int(width) if width else 0
+
+            if conv == "%":
+                out.append("%")
+                continue
+            if conv == "c":
+                text = chr(next_word() & 0xFF)
+            elif conv == "s":
+                value = words[arg]
+                if value >> 56 == INLINE_STR_TAG:
+                    text, used = inline_string(words, arg)
+                    arg += used
+                else:
+                    arg += 1
+                    if value == 0:
+                        text = "(null)"
+                    else:
+                        text = image.string_at(value - rodata_start)
+                        if text is None:
+                            text = "<str@0x%x>" % value
+            elif conv in "di":
+                value = to_signed(next_word(), bits)
+                sign = "-" if value < 0 else ("+" if "+" in flags else (" " if " " in flags else ""))
+                text = sign + str(abs(value))
+            elif conv in "bBoxXup":
+                value = next_word() & ((1 << (64 if conv == "p" else bits)) - 1)
+                base = {"b": "b", "B": "b", "o": "o", "x": "x", "X": "X", "u": "d", "p": "x"}[conv]
+                text = format(value, base)
+                if conv == "B":
+                    text = text.upper()
+                if conv == "p":
+                    flags += "#0"
+                    width = 18
+                if "#" in flags and conv in "xXp":
+                    prefix = "0X" if conv == "X" else "0x"
+                    if "0" in flags and "-" not in flags:
+                        text = prefix + text.rjust(max(width - 2, 0), "0")
+                        width = 0
+                    else:
+                        text = prefix + text
+            else:
+                out.append("<bad conversion %%%s>" % conv)
+                break
+        except IndexError:
+            out.append("<missing argument>")
+            break
+
+        if "-" in flags:
+            text = text.ljust(width)
+        elif "0" in flags and conv not in "cs":
+            sign = text[0] if text[:1] in "+- " and conv in "di" else ""
+            text = sign + text[len(sign):].rjust(width - len(sign), "0")
+        else:
+            text = text.rjust(width)
+        out.append(text)
+    else:
+        out.append(fmt[pos:])
+
+    return "".join(out)
+
+
+def read_dump(path, raw):
+    """Return (header tuple, list of slot tuples) from the dump file."""
+    if raw:
+        with open(path, "rb") as f:
+            data = f.read()
+        header = struct.unpack_from(HDR_FORMAT, data, 0)
+        slots = []
+        for i in range(header[4]):
+            off = HDR_SIZE + i * SLOT_SIZE
+            if off + SLOT_SIZE > len(data):
+                break
+            slots.append(struct.unpack_from(SLOT_FORMAT, data, off))
+        return header, slots
+
+    header = None
+    slots = {}
+    with open(path, "r", errors="replace") as f:
+        for line in f:
+            match = re.search(r"BINLOG,([HR]),([0-9a-fA-F]+)", line)
+            if not match:
+                continue
+            blob = bytes.fromhex(match.group(2))
+            if match.group(1) == "H" and len(blob) >= HDR_SIZE:
+                header = struct.unpack_from(HDR_FORMAT, blob, 0)
+            elif match.group(1) == "R" and len(blob) >= SLOT_SIZE:
+                slot = struct.unpack_from(SLOT_FORMAT, blob, 0)
+                slots[slot[0]] = slot
+    if header is None:
+        raise ValueError("no BINLOG header line in %s" % path)
+    return header, list(slots.values())
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--raw", action="store_true",
+                        help="input is a memory dump of g_binlog")
+    parser.add_argument("elf", help="ELF image the log was taken from")
+    parser.add_argument("log", help="console log with BINLOG lines, or raw dump")
+    args = parser.parse_args()
+
+    image = ElfImage(args.elf)
+    header, slots = read_dump(args.log, args.raw)
+    magic, version, rodata_start, freq, _, _ = header
+    if magic != BINLOG_MAGIC or version != BINLOG_VERSION:
+        sys.exit("unsupported binary log header (magic 0x%x version %d)" % (magic, version))
+
+    expected = None
+    for slot in sorted((s for s in slots if s[0] != 0), key=lambda s: s[0]):
+        seq, level, pe_index, nwords, flags, fmt_off, _, timestamp = slot[:8]
+        words = list(slot[8:8 + nwords])
+
+        if expected is not None and seq > expected:
+            print("... %d records lost" % (seq - expected))
+        expected = seq + 1
+
+        if fmt_off == FMT_INLINE:
+            fmt, used = inline_string(words, 0)
+            words = words[used:]
+        else:
+            fmt = image.string_at(fmt_off)
+            if fmt is None:
+                fmt = "<format at .rodata+0x%x>" % fmt_off
+
+        text = format_record(fmt, words, image, rodata_start).replace("\r", "")
+        if flags & FLAG_TRUNCATED:
+            text += " <truncated>"
+        usec = (timestamp * 1000000 // freq) if freq else 0
+        for line in text.strip("\n").split("\n"):
+            print("[PE %d %d us] %-5s %s" % (pe_index, usec, LEVEL_NAMES.get(level, "?"), line))
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,224 @@
+## @file
+ # Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ # SPDX-License-Identifier : Apache-2.0
+ #
+ # Licensed under the Apache License, Version 2.0 (the "License");
+ # you may not use this file except in compliance with the License.
+ # You may obtain a copy of the License at
+ #
+ #  http://www.apache.org/licenses/LICENSE-2.0
+ #
+ # Unless required by applicable law or agreed to in writing, software
+ # distributed under the License is distributed on an "AS IS" BASIS,
+ # WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ # See the License for the specific language governing permissions and
+ # limitations under the License.
+ ##
+
+"""Generate val/src/rule_registry_gen.c from the rule sources.
+
+The rule enum (rule_based_execution_enum.h), rule name strings
+(rule_enum_string_map.c) and alias map (rule_metadata.c) remain the single
+source of rule data. This script derives dense const lookup tables from them:
+
+  - a collision-free (hash and displace) perfect hash for rule name to
+    RULE_ID_e lookup, and
+  - a RULE_ID_e indexed alias_rule_map index.
+
+Usage (from the repository root):
+  python3 tools/scripts/gen_rule_registry.py          # regenerate
+  python3 tools/scripts/gen_rule_registry.py --check  # verify up to date
+"""
+
+import os
+import re
+import sys
+
+ENUM_FILE = os.path.join("val", "include", "rule_based_execution_enum.h")
+STRING_FILE = os.path.join("val", "src", "rule_enum_string_map.c")
+METADATA_FILE = os.path.join("val", "src", "rule_metadata.c")
+OUTPUT_FILE = os.path.join("val", "src", "rule_registry_gen.c")
+
+INVALID_U16 = 0xFFFF
+FNV_OFFSET = 0x811C9DC5
+FNV_PRIME = 0x01000193
+
+HEADER = """/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+/*
+ * GENERATED FILE - DO NOT EDIT.
+ * Regenerate with: python3 tools/scripts/gen_rule_registry.py
+ */
+"""
+
+
+def strip_comments(text):
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+    return re.sub(r"//[^\n]*", "", text)
+
+
+def parse_rule_enum(path):
+    """Return the RULE_ID_e enumerators in declaration order."""
+    text = strip_comments(open(path, encoding="utf-8").read())
+    match = re.search(r"typedef\s+enum\s*\{(.*?)\}\s*RULE_ID_e\s*;", text, re.S)
+    if not match:
+        sys.exit("RULE_ID_e not found in " + path)
+    names = [n.strip() for n in match.group(1).split(",") if n.strip()]
+    for name in names:
+        if "=" in name:
+            sys.exit("RULE_ID_e enumerators must not have explicit values: " + name)
+    if names[-1] != "RULE_ID_SENTINEL":
+        sys.exit("RULE_ID_SENTINEL must be the last RULE_ID_e enumerator")
+    return names[:-1]
+
+
+def parse_rule_strings(path):
+    """Return {enumerator: string} from rule_id_string[]."""
+    text = strip_comments(open(path, encoding="utf-8").read())
+    match = re.search(r"rule_id_string\s*\[[^\]]*\]\s*=\s*\{(.*?)\};", text, re.S)
+    if not match:
+        sys.exit("rule_id_string not found in " + path)
+    return dict(re.findall(r"\[\s*(\w+)\s*\]\s*=\s*\"([^\"]*)\"", match.group(1)))
+
+
+def parse_alias_map(path):
+    """Return alias rule enumerators in alias_rule_map[] order."""
+    text = strip_comments(open(path, encoding="utf-8").read())
+    match = re.search(r"alias_rule_map\s*\[\s*\]\s*=\s*\{(.*?)\};", text, re.S)
+    if not match:
+        sys.exit("alias_rule_map not found in " + path)
+    return re.findall(r"\{\s*(\w+)\s*,\s*\w+\s*\}", match.group(1))
+
+
+def fnv1a(name, seed):
+    value = FNV_OFFSET ^ seed
+    for char in name.encode("ascii"):
+        value ^= char
+        value = (value * FNV_PRIME) & 0xFFFFFFFF
+    return value
+
+
+def build_perfect_hash(names):
+    """Hash-and-displace: bucket by fnv1a(name, 0), then search a per-bucket
+    seed that places every key of the bucket into a distinct free slot."""
+    count = len(names)
+    bucket_count = max(1, (count + 3) // 4)
+    slot_count = count + count // 4 + 1
+
+    buckets = [[] for _ in range(bucket_count)]
+    for rid, name in names:
+        buckets[fnv1a(name, 0) % bucket_count].append((rid, name))
+
+    slots = [INVALID_U16] * slot_count
+    seeds = [0] * bucket_count
+    order = sorted(range(bucket_count), key=lambda b: len(buckets[b]), reverse=True)
+    for bucket in order:
+        keys = buckets[bucket]
+        if not keys:
+            continue
+        for seed in range(1, INVALID_U16):
+            placed = [fnv1a(name, seed) % slot_count for _, name in keys]
+            if len(set(placed)) == len(placed) and \
+               all(slots[p] == INVALID_U16 for p in placed):
+                for (rid, _), pos in zip(keys, placed):
+                    slots[pos] = rid
+                seeds[bucket] = seed
+                break
+        else:
+            sys.exit("perfect hash construction failed")
+    return seeds, slots
+
+
+def format_table(values, per_line=12):
+    lines = []
+    for i in range(0, len(values), per_line):
+        chunk = ", ".join("0x%04X" % v for v in values[i:i + per_line])
+        lines.append("    " + chunk + ",")
+    return "\n".join(lines)
+
+
+def generate():
+    enum_names = parse_rule_enum(ENUM_FILE)
+    strings = parse_rule_strings(STRING_FILE)
+    aliases = parse_alias_map(METADATA_FILE)
+    rule_index = {name: idx for idx, name in enumerate(enum_names)}
+
+    names = []
+    seen = {}
+    for enum_name, string in strings.items():
+        if enum_name not in rule_index:
+            sys.exit("rule_id_string entry for unknown rule " + enum_name)
+        if string in seen:
+            sys.exit("duplicate rule name string " + string)
+        seen[string] = enum_name
+        names.append((rule_index[enum_name], string))
+
+    seeds, slots = build_perfect_hash(names)
+
+    alias_index = [INVALID_U16] * len(enum_names)
+    for idx, alias in enumerate(aliases):
+        if alias not in rule_index:
+            sys.exit("alias_rule_map entry for unknown rule " + alias)
+        if alias_index[rule_index[alias]] == INVALID_U16:
+            alias_index[rule_index[alias]] = idx
+
+    out = [HEADER]
+    out.append('#include "acs_stdint.h"')
+    out.append('#include "rule_based_execution_enum.h"')
+    out.append("")
+    out.append("/* Generated for %d rules, %d named rules, %d alias rules */"
+               % (len(enum_names), len(names), len(aliases)))
+    out.append("const uint32_t rule_registry_rule_count = %d;" % len(enum_names))
+    out.append("")
+    out.append("/* Perfect hash of rule_id_string[]: bucket = fnv1a(name, 0) % bucket count,")
+    out.append("   slot = fnv1a(name, rule_name_hash_seed[bucket]) % slot count */")
+    out.append("const uint32_t rule_name_hash_bucket_count = %d;" % len(seeds))
+    out.append("const uint32_t rule_name_hash_slot_count = %d;" % len(slots))
+    out.append("")
+    out.append("const uint16_t rule_name_hash_seed[%d] = {" % len(seeds))
+    out.append(format_table(seeds))
+    out.append("};")
+    out.append("")
+    out.append("/* RULE_ID_e per slot, 0xFFFF for unused slots */")
+    out.append("const uint16_t rule_name_hash_slot[%d] = {" % len(slots))
+    out.append(format_table(slots))
+    out.append("};")
+    out.append("")
+    out.append("/* alias_rule_map[] index per RULE_ID_e, 0xFFFF for non-alias rules */")
+    out.append("const uint16_t alias_rule_map_index[RULE_ID_SENTINEL] = {")
+    out.append(format_table(alias_index))
+    out.append("};")
+    out.append("")
+    return "\n".join(out)
+
+
+def main():
+    content = generate()
+    if len(sys.argv) > 1 and sys.argv[1] == "--check":
+        current = ""
+        if os.path.exists(OUTPUT_FILE):
+            current = open(OUTPUT_FILE, encoding="utf-8").read()
+        if current != content:
+            sys.exit(OUTPUT_FILE + " is out of date, run " + sys.argv[0])
+        return
+    with open(OUTPUT_FILE, "w", encoding="utf-8") as out_file:
+        out_file.write(content)
+
+
+if __name__ == "__main__":
+    main()
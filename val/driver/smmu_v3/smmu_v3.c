@@ -465,6 +465,10 @@ static smmu_master_t *smmu_master_at(uint32_t sid)
         return NULL;
     }
 
+    /* Masters are looked up again by later rules, keep them for the run */
+    val_memory_scope_keep(node->master);
+    val_memory_scope_keep(node);
+
     node->next = g_smmu_master_list_head;
     g_smmu_master_list_head = node;
 
@@ -1095,19 +1099,7 @@ static int smmu_cdtab_alloc(smmu_master_t *master)
     return 1;
 }
 
-/**
-  @brief - 1. Determine if stage 1 or stage 2 translation is needed.
-           2. Populate stage1 or stage2 configuration data structures. Create and populate
-              context desciptor tables as well in case of stage 1 transalation.
-           3. Get pointer to stream table entry corresponding to master stream id
-           4. Populate the stream table entry, with stage1/2 configuration.
-           5. Invalidate all SMMU config and tlb entries, so that stream table is accessed,
-              at the next memory access from a master.
-  @param master_attr - structured data about the master (like streamid, smmu index).
-  @param pgt_desc - page table base and translation attributes
-  @return status
-**/
-uint64_t val_smmu_map(smmu_master_attributes_t master_attr, pgt_descriptor_t pgt_desc)
+static uint64_t smmu_map(smmu_master_attributes_t master_attr, pgt_descriptor_t pgt_desc)
 {
     smmu_master_t *master;
     smmu_dev_t *smmu;
@@ -1221,6 +1213,32 @@ uint64_t val_smmu_map(smmu_master_attributes_t master_attr, pgt_descriptor_t pgt
     return 0;
 }
 
+/**
+  @brief - 1. Determine if stage 1 or stage 2 translation is needed.
+           2. Populate stage1 or stage2 configuration data structures. Create and populate
+              context desciptor tables as well in case of stage 1 transalation.
+           3. Get pointer to stream table entry corresponding to master stream id
+           4. Populate the stream table entry, with stage1/2 configuration.
+           5. Invalidate all SMMU config and tlb entries, so that stream table is accessed,
+              at the next memory access from a master.
+  @param master_attr - structured data about the master (like streamid, smmu index).
+  @param pgt_desc - page table base and translation attributes
+  @return status
+**/
+uint64_t val_smmu_map(smmu_master_attributes_t master_attr, pgt_descriptor_t pgt_desc)
+{
+    uint64_t status;
+
+    /* Stream and context descriptor tables belong to the driver, they are
+     * freed by val_smmu_unmap() and val_smmu_stop(), not by the rule scope.
+     */
+    val_memory_scope_suspend();
+    status = smmu_map(master_attr, pgt_desc);
+    val_memory_scope_resume();
+
+    return status;
+}
+
 
 uint32_t val_smmu_config_ste_dcp(smmu_master_attributes_t master_attr, uint32_t value)
 {
@@ -1398,11 +1416,7 @@ void val_smmu_stop(void)
     val_memory_free(g_smmu);
 }
 
-/**
-  @brief  Scan all available SMMUs in the system and initialize all v3.x SMMUs
-  @return Initialzation status
-**/
-uint32_t val_smmu_init(void)
+static uint32_t smmu_init_all(void)
 {
     uint32_t smmu_version;
     g_num_smmus = val_iovirt_get_smmu_info(SMMU_NUM_CTRL, 0);
@@ -1438,6 +1452,22 @@ uint32_t val_smmu_init(void)
     return 0;
 }
 
+/**
+  @brief  Scan all available SMMUs in the system and initialize all v3.x SMMUs
+  @return Initialzation status
+**/
+uint32_t val_smmu_init(void)
+{
+    uint32_t status;
+
+    /* The SMMU state is used for the rest of the run */
+    val_memory_scope_suspend();
+    status = smmu_init_all();
+    val_memory_scope_resume();
+
+    return status;
+}
+
 /**
   @brief  Get info about SMMU features.
   @param type - ID of the info requested.
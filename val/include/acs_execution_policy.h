@@ -28,8 +28,12 @@
  * - print verbosity and MMIO-print enablement
  * - PCIe/CXL behavior hints
  * - wakeup/watchdog/timer timeout controls
+ * - scaling of the wait deadlines of tests and VAL
  * - crypto-extension and EL1 trap workarounds
  * - system last-level cache hinting
+ * - opt-in parked secondary PE worker pool
+ * - checkpoint/resume of rule execution across resets
+ * - destination of the machine-readable rule result stream
  */
 typedef struct acs_execution_policy {
     uint32_t pcie_p2p;
@@ -41,6 +45,11 @@ typedef struct acs_execution_policy {
     uint32_t timeout_pass;
     uint32_t timeout_fail;
     uint32_t timer_timeout_us;
+    /*
+     * Percentage applied to the wait budgets given to val_deadline_start(),
+     * for platforms much slower (models) or faster than the defaults assume.
+     */
+    uint32_t timeout_scale;
     uint32_t crypto_support;
     /*
      * System last-level cache hint used by MPAM and related tests:
@@ -54,8 +63,39 @@ typedef struct acs_execution_policy {
      * not safely expose them. Compose with EL1SKIPTRAP_* flags.
      */
     uint32_t el1skiptrap_mask;
+    /*
+     * Keep secondary PEs parked in WFE between payloads instead of a PSCI
+     * CPU_ON/CPU_OFF round trip per payload. 0 keeps the PSCI path.
+     */
+    uint32_t pe_pool;
+    /*
+     * Checkpoint progress after each top-level rule through the PAL and, on
+     * start, resume from a checkpoint left by a run that did not complete.
+     */
+    uint32_t resume;
+    /*
+     * Destination of the JSON-lines rule result records, independent of
+     * the print verbosity. Use ACS_RESULT_SINK_* values.
+     */
+    uint32_t result_sink;
 } acs_execution_policy_t;
 
+/* Rule result record destinations, see rule_result_sink.c */
+#define ACS_RESULT_SINK_NONE    0  /* no records */
+#define ACS_RESULT_SINK_MEMORY  1  /* kept in a VAL buffer, address printed at the end */
+#define ACS_RESULT_SINK_PAL     2  /* streamed through pal_result_sink_write() */
+
+/*
+ * Lowest print level compiled into the image, set with
+ * -DACS_PRINT_MIN_LEVEL=<1..6> (1 = TRACE keeps every print). val_print() and
+ * pal_print_msg() calls with a constant level below it fold away together
+ * with their format strings, so print_level cannot bring them back.
+ */
+#ifndef ACS_PRINT_MIN_LEVEL
+#define ACS_PRINT_MIN_LEVEL     1
+#endif
+#define ACS_PRINT_COMPILED_IN(level)  ((level) >= ACS_PRINT_MIN_LEVEL)
+
 void acs_reset_execution_policy(void);
 acs_execution_policy_t *acs_get_execution_policy_mut(void);
 const acs_execution_policy_t *acs_get_execution_policy(void);
@@ -69,8 +109,12 @@ bool acs_policy_get_pcie_skip_dp_nic_ms(void);
 uint32_t acs_policy_get_timeout_pass(void);
 uint32_t acs_policy_get_timeout_fail(void);
 uint32_t acs_policy_get_timer_timeout_us(void);
+uint32_t acs_policy_get_timeout_scale(void);
 uint32_t acs_policy_get_crypto_support(void);
 uint32_t acs_policy_get_sys_last_lvl_cache(void);
 uint32_t acs_policy_get_el1skiptrap_mask(void);
+uint32_t acs_policy_get_pe_pool(void);
+uint32_t acs_policy_get_resume(void);
+uint32_t acs_policy_get_result_sink(void);
 
 #endif /* __ACS_EXECUTION_POLICY_H__ */
@@ -35,4 +35,12 @@ typedef struct {
 acs_test_status_counters_t *acs_get_test_status(void);
 void acs_reset_test_status(void);
 
+/* Platform activity counters sampled by the rule profiler */
+typedef struct {
+    uint64_t pe_wakeups;          /* Secondary PE wake-ups via val_execute_on_pe() */
+    uint64_t mmio_accesses;       /* Accesses through val_mmio_read*()/val_mmio_write*() */
+} acs_activity_counters_t;
+
+acs_activity_counters_t *acs_get_activity_counters(void);
+
 #endif /* __ACS_INTERFACE_H__ */
@@ -52,6 +52,56 @@ uint32_t val_memory_page_size(void);
 uint32_t val_memory_check_for_persistent_mem(void);
 uint32_t val_memory_set_wb_executable(void *addr, uint32_t size);
 
+/*
+ * Allocation scope. While a scope is open, buffers allocated through the VAL
+ * memory and DMA allocators are recorded, and the ones still held when the
+ * scope is closed are released. The orchestrator opens a scope around each
+ * test entry so that a rule cannot leak memory into the rules after it.
+ * Allocations that must outlive the rule, such as VAL caches filled on first
+ * use, are dropped from the scope with val_memory_scope_keep(). VAL one-time
+ * init, such as the SMMU and ITS setup, runs with the recording suspended.
+ */
+#define MEM_SCOPE_MAX_RECORDS  512
+
+#define MEM_SCOPE_POOL       0  /* val_memory_alloc, val_memory_calloc */
+#define MEM_SCOPE_PAGES      1  /* val_memory_alloc_pages */
+#define MEM_SCOPE_ALIGNED    2  /* val_aligned_alloc */
+#define MEM_SCOPE_CACHEABLE  3  /* val_memory_alloc_cacheable */
+#define MEM_SCOPE_DMA        4  /* val_dma_mem_alloc */
+
+typedef struct {
+  uint32_t count;      /* allocations released, or kept, at the close */
+  uint32_t untracked;  /* allocations not recorded, the record table was full */
+  uint64_t bytes;      /* requested size of those allocations */
+} val_memory_scope_report_t;
+
+void val_memory_scope_open(void);
+void val_memory_scope_close(val_memory_scope_report_t *report, bool release);
+void val_memory_scope_keep(void *addr);
+void val_memory_scope_suspend(void);
+void val_memory_scope_resume(void);
+void val_memory_scope_track(uint32_t kind, void *addr, uint64_t aux, uint32_t size,
+                            uint32_t arg, uint32_t flags);
+void val_memory_scope_untrack(void *addr);
+
+/*
+ * Physically contiguous buffers aligned to a translation block of the 4KB
+ * granule, for tests whose bandwidth or latency results must not depend on
+ * TLB misses. A buffer covers whole blocks, so a stage 1 table that maps the
+ * memory with block descriptors, and any table built over the buffer with
+ * val_pgt_create(), needs one TLB entry per block instead of per page.
+ */
+#define MEM_CONTIG_2MB       0x1  /* level 2 block */
+#define MEM_CONTIG_1GB       0x2  /* level 1 block, falls back to 2MB */
+
+#define MEM_BLOCK_SIZE_2MB   0x200000ULL
+#define MEM_BLOCK_SIZE_1GB   0x40000000ULL
+
+void *val_memory_alloc_contig(uint32_t size, uint32_t flags, uint64_t *block_size);
+void val_memory_free_contig(void *addr);
+uint64_t val_memory_get_block_size(void *addr);
+void val_memory_contig_benchmark(void);
+
 uint32_t m001_entry(uint32_t num_pe);
 uint32_t m002_entry(uint32_t num_pe);
 uint32_t m003_entry(uint32_t num_pe);
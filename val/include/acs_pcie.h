@@ -165,6 +165,26 @@ typedef struct {
   pcie_device_attr device[];         ///< in the format of Segment/Bus/Dev/Func
 } pcie_device_bdf_table;
 
+/* Capability IDs below these limits are answered from the capability index */
+#define PCIE_CAP_INDEX_MAX_CID   32
+#define PCIE_CAP_INDEX_MAX_ECID  64
+
+/* Capability lists of one Function, read once when the BDF table is created */
+typedef struct {
+  uint32_t bdf;
+  uint32_t cap_present;                          ///< bit n set if capability ID n is present
+  uint64_t ecap_present;                         ///< bit n set if ext capability ID n is present
+  uint32_t cap_miss;                             ///< status of a lookup of an absent capability
+  uint32_t ecap_miss;                            ///< status of a lookup of an absent ext capability
+  uint8_t  cap_offset[PCIE_CAP_INDEX_MAX_CID];   ///< offset of the first instance of each ID
+  uint16_t ecap_offset[PCIE_CAP_INDEX_MAX_ECID];
+} pcie_cap_index_entry;
+
+typedef struct {
+  uint32_t num_entries;
+  pcie_cap_index_entry entry[];      ///< sorted by bdf
+} pcie_cap_index;
+
 void     val_pcie_write_cfg(uint32_t bdf, uint32_t offset, uint32_t data);
 void     val_pcie_io_write_cfg(uint32_t bdf, uint32_t offset, uint32_t data);
 uint32_t val_pcie_read_cfg(uint32_t bdf, uint32_t offset, uint32_t *data);
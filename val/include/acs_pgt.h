@@ -74,6 +74,8 @@
 uint32_t val_pgt_create(memory_region_descriptor_t *mem_desc, pgt_descriptor_t *pgt_desc);
 void val_pgt_destroy(pgt_descriptor_t pgt_desc);
 uint64_t val_pgt_get_attributes(pgt_descriptor_t pgt_desc, uint64_t virtual_address, uint64_t *attributes);
+uint32_t val_pgt_get_block_size(pgt_descriptor_t pgt_desc, uint64_t virtual_address,
+                                uint64_t *block_size);
 uint64_t val_pgt_ioremap_attr(pgt_descriptor_t pgt_desc,
                               uint64_t addr,
                               uint64_t size,
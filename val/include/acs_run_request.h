@@ -39,6 +39,7 @@
  * - requested architecture selection
  * - requested level filter mode and value
  * - requested software-view mask
+ * - optional time budget and per-rule cost profile for quick runs
  *
  * The *_owned flags indicate whether this request object owns the dynamically
  * allocated list storage and therefore must free it during release.
@@ -56,10 +57,13 @@ typedef struct acs_run_request {
     uint32_t   level_filter_mode; /* LEVEL_FILTER_MODE_e */
     uint32_t   level_value;       /* numeric value interpreted per-arch */
     uint32_t   bsa_sw_view_mask;  /* bit (1<<SW_OS | 1<<SW_HYP | 1<<SW_PS) */
+    uint64_t   time_budget_us;    /* 0 for no budget */
+    uint32_t  *rule_cost_us;      /* RULE_ID_SENTINEL entries, 0 where unknown */
     bool       rule_list_owned;
     bool       skip_rule_list_owned;
     bool       execute_modules_owned;
     bool       skip_modules_owned;
+    bool       rule_cost_owned;
 } acs_run_request_t;
 
 /*
@@ -24,12 +24,20 @@
 #include "acs_common.h"
 
 
+/*
+ * Per-PE mailbox, each in its own cache writeback granule of the shared region.
+ * The payload fields are written by the PE that wakes this PE and status by the
+ * PE itself, so readers clean and invalidate the granule, never only invalidate.
+ */
 typedef struct {
-  uint64_t    data0;
-  uint64_t    data1;
-  uint32_t    status;
+  uint64_t          data0;   /* payload address, val_set_test_data */
+  uint64_t          data1;   /* payload argument */
+  val_test_status_t status;  /* val_set_status */
+  uint32_t          seq;     /* bumped by val_set_test_data */
 }VAL_SHARED_MEM_t;
 
+volatile VAL_SHARED_MEM_t *val_shared_mem_entry(uint32_t index);
+
 uint64_t
 val_pe_reg_read(uint32_t reg_id);
 
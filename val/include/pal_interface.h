@@ -792,6 +792,22 @@ void     pal_print(uint64_t data);
 void     pal_uart_print(int log, const char *fmt, ...);
 void     pal_print_raw(uint64_t addr, char8_t *string, uint64_t data);
 void     pal_uart_putc(char c);
+void     pal_print_flush(void);
+uint32_t pal_print_get_stats(uint64_t *stalled, uint64_t *dropped);
+
+/* Heap statistics, sizes include the allocator block metadata */
+typedef struct {
+  uint64_t heap_size;
+  uint64_t in_use;          /* bytes held by allocated blocks */
+  uint64_t peak_in_use;     /* high-water mark of in_use */
+  uint64_t largest_free;    /* largest free block */
+  uint32_t free_blocks;
+  uint32_t alloc_count;     /* allocations currently outstanding */
+  uint32_t alloc_failures;
+  uint32_t fragmentation;   /* percent of free bytes outside the largest free block */
+} PAL_HEAP_STATS;
+
+uint32_t pal_mem_get_heap_stats(PAL_HEAP_STATS *stats);
 uint32_t pal_strncmp(char8_t *str1, char8_t *str2, uint32_t len);
 void     pal_mmu_add_mmap(void);
 void    *pal_mmu_get_mmap_list(void);
@@ -811,6 +827,14 @@ void     pal_mem_allocate_shared(uint32_t num_pe, uint32_t sizeofentry);
 void     pal_mem_free_shared(void);
 uint64_t pal_mem_get_shared_addr(void);
 
+/* Persistent checkpoint of rule based execution progress */
+uint32_t pal_checkpoint_save(void *buffer, uint32_t size);
+uint32_t pal_checkpoint_load(void *buffer, uint32_t *size);
+uint32_t pal_checkpoint_clear(void);
+
+/* Machine-readable rule result stream (file or secondary UART) */
+uint32_t pal_result_sink_write(const char8_t *buf, uint32_t len);
+
 uint32_t pal_mmio_read(uint64_t addr);
 uint8_t  pal_mmio_read8(uint64_t addr);
 uint16_t pal_mmio_read16(uint64_t addr);
@@ -28,6 +28,18 @@
 #define INVALID_IDX 0xFFFFFFFF
 #define RULE_REFERENCE_PATH_MAX_DEPTH 10
 
+/* Rule bitset sizing, one bit per RULE_ID_e */
+#define RULE_BITSET_WORD_BITS 64U
+#define RULE_BITSET_WORDS     \
+    ((RULE_ID_SENTINEL + RULE_BITSET_WORD_BITS - 1U) / RULE_BITSET_WORD_BITS)
+
+/* Upper bound for per-arch level enum values, rule_lookup.c checks every arch fits */
+#define RULE_ARCH_LEVEL_MAX   ((uint32_t)SBSA_LEVEL_SENTINEL)
+#define RULE_ARCH_SW_VIEW_MAX 3U
+
+/* Upper bound on rules and modules listed in the profile summary */
+#define RULE_PROFILE_TOP_N_MAX 32U
+
 /* ----------------------------  Struct  Definations --------------------------------------------*/
 
 typedef uint32_t (*test_entry_fn_t)(uint32_t);
@@ -40,6 +52,7 @@ typedef struct {
     RULE_FLAG_e      flag;
     uint32_t         test_num;
     char8_t          platform_bitmask;
+    char8_t          attr;          /* RULE_ATTR_e bits */
     char8_t          rule_desc[RULE_DESC_SIZE];
 } rule_test_map_t;
 
@@ -85,20 +98,96 @@ typedef struct {
     PFDI_LEVEL_e level;
 } pfdi_rule_entry_t;
 
+/* RULE_ID_e indexed bitset used for rule selection */
+typedef struct {
+    uint64_t word[RULE_BITSET_WORDS];
+} rule_bitset_t;
+
+/* Dense per-arch rule metadata, indexed by RULE_ID_e.
+ * level_rules[l] and sw_view_rules[v] hold the arch rules at level l and
+ * software view v, so level and view filters reduce to bitset operations.
+ */
+typedef struct {
+    uint32_t      arch;           /* ARCH_SEL_e this index was built for */
+    uint32_t      fr_level;       /* *_LEVEL_FR of the arch, 0 if not applicable */
+    bool          has_sw_view;    /* true if entries carry a SOFTWARE_VIEW_e */
+    rule_bitset_t rules;          /* rules present in the arch rule list */
+    rule_bitset_t level_rules[RULE_ARCH_LEVEL_MAX];
+    rule_bitset_t sw_view_rules[RULE_ARCH_SW_VIEW_MAX];
+} rule_arch_index_t;
+
+/* Accumulated cost of a rule or module, see rule_profile.c */
+typedef struct {
+    uint64_t ticks;          /* virtual counter ticks spent in the test entry */
+    uint64_t pe_wakeups;     /* secondary PE wake-ups issued */
+    uint64_t mmio_accesses;  /* val_mmio_* accesses issued */
+    uint32_t runs;           /* test entry calls (rules per module for modules) */
+} rule_profile_t;
+
+/* Counter snapshot taken before a test entry call */
+typedef struct {
+    uint64_t start_ticks;
+    uint64_t pe_wakeups;
+    uint64_t mmio_accesses;
+} rule_profile_sample_t;
+
 /* ---------------------------- Helper functions declarations ---------------------------------- */
 void     quick_sort_rule_list(RULE_ID_e *rule_list, uint32_t list_size);
 uint32_t check_module_init(MODULE_NAME_e module_id);
 uint32_t alias_rule_map_get_index(RULE_ID_e alias_rule_id);
+uint32_t rule_id_from_name(const char *name);
 void     print_rule_test_start(uint32_t rule_enum, uint32_t indent);
 void     print_rule_test_status(uint32_t rule_enum, uint32_t indent, uint32_t status);
 void     rule_status_map_reset(void);
-bool     rule_in_list(RULE_ID_e rid, const RULE_ID_e *list, uint32_t count);
 void     print_pal_validation_info(uint32_t rule_enum, uint32_t indent);
 void     rule_reference_path_reset(void);
 bool     rule_reference_path_contains(RULE_ID_e rule_id);
 bool     rule_reference_path_push(RULE_ID_e rule_id);
 void     rule_reference_path_pop(void);
 const RULE_ID_e *rule_reference_path_get(void);
+void     rule_bitset_clear(rule_bitset_t *set);
+void     rule_bitset_or(rule_bitset_t *dst, const rule_bitset_t *src);
+void     rule_bitset_andnot(rule_bitset_t *dst, const rule_bitset_t *src);
+void     rule_bitset_set_list(rule_bitset_t *set, const RULE_ID_e *list, uint32_t count);
+uint32_t rule_bitset_count(const rule_bitset_t *set);
+uint32_t rule_bitset_to_list(const rule_bitset_t *set, RULE_ID_e *list, uint32_t max_count);
+const rule_bitset_t *rule_module_bitset_get(uint32_t module_id);
+const rule_arch_index_t *rule_arch_index_get(uint32_t arch);
+void     rule_profile_reset(void);
+void     rule_profile_begin(rule_profile_sample_t *sample);
+void     rule_profile_end(RULE_ID_e rule_id, const rule_profile_sample_t *sample);
+void     rule_profile_add(RULE_ID_e rule_id, uint64_t ticks, uint64_t pe_wakeups,
+                          uint64_t mmio_accesses);
+const rule_profile_t *rule_profile_get(RULE_ID_e rule_id);
+uint32_t rule_checkpoint_restore(const RULE_ID_e *rule_list, uint32_t list_size,
+                                 uint32_t *resume_index, bool *interrupted);
+void     rule_checkpoint_save(const RULE_ID_e *rule_list, uint32_t list_size,
+                              uint32_t next_index);
+void     rule_checkpoint_clear(void);
+uint32_t rule_cost_profile_parse(const char8_t *text, uint32_t len, uint32_t *cost_us);
+uint32_t rule_budget_apply(acs_run_request_t *ctx, const rule_bitset_t *skip);
+void     rule_budget_start(void);
+bool     rule_budget_exhausted(uint64_t budget_us);
+void     rule_result_sink_open(void);
+void     rule_result_begin(uint32_t rule_id, uint32_t indent);
+void     rule_result_record(uint32_t rule_id, uint32_t indent, uint32_t status);
+void     rule_result_sink_close(void);
+const char *rule_result_sink_buffer(uint32_t *len);
+
+/* Set/test a single rule bit. Out of range ids are ignored/reported absent. */
+static inline void rule_bitset_set(rule_bitset_t *set, uint32_t rule_id)
+{
+    if (rule_id < RULE_ID_SENTINEL)
+        set->word[rule_id / RULE_BITSET_WORD_BITS] |= (1ULL << (rule_id % RULE_BITSET_WORD_BITS));
+}
+
+static inline bool rule_bitset_test(const rule_bitset_t *set, uint32_t rule_id)
+{
+    if (rule_id >= RULE_ID_SENTINEL)
+        return 0;
+    return (set->word[rule_id / RULE_BITSET_WORD_BITS] >>
+            (rule_id % RULE_BITSET_WORD_BITS)) & 1ULL;
+}
 
 /* ---------------------------- Externs ---------------------------- */
 extern uint32_t rule_status_map[RULE_ID_SENTINEL];
@@ -1048,6 +1048,14 @@ typedef enum {
     ALIAS_RULE
 } RULE_FLAG_e;
 
+/* Attribute bits for rule_test_map_t.attr */
+typedef enum {
+    RULE_ATTR_NONE          = 0,
+    RULE_ATTR_STATEFUL      = 1 << 0,  /* Result depends on system state, never reuse */
+    RULE_ATTR_PE_POWER      = 1 << 1   /* Drives PE power states through PSCI, needs
+                                          secondary PEs off between payloads */
+} RULE_ATTR_e;
+
 /* SBSA levels enum */
 typedef enum {
     SBSA_LEVEL_3  = 3,
@@ -39,17 +39,37 @@
  * Note: val_print can be overridden by defining FAST_PRINT_ENABLE in
  * platform_override_fvp.h, provided a FASTPRINT implementation is available
  * in the PAL layer.
+ *
+ * Calls below ACS_PRINT_MIN_LEVEL are removed at compile time, see
+ * acs_execution_policy.h.
  */
 #if defined(TARGET_BAREMETAL) && defined(FAST_PRINT_ENABLE)
 #define val_print(level, ...)                         \
     do {                                              \
-        if ((level) >= acs_policy_get_print_level())  \
+        if (ACS_PRINT_COMPILED_IN(level) &&           \
+            (level) >= acs_policy_get_print_level())  \
             pal_vfastprint(__VA_ARGS__);              \
     } while (0)
+#elif defined(TARGET_BAREMETAL) && defined(ACS_BINARY_LOG)
+/*
+ * Binary log mode: records below INFO are kept unformatted in the binary
+ * log ring at any verbosity (see val_binlog.c), records from INFO up are
+ * printed as usual.
+ */
+#define val_print(level, ...)                                    \
+    do {                                                         \
+        if (ACS_PRINT_COMPILED_IN(level)) {                      \
+            if ((level) < INFO)                                  \
+                val_binlog_record((level), __VA_ARGS__);         \
+            else if ((level) >= acs_policy_get_print_level())    \
+                val_printf((level), __VA_ARGS__);                \
+        }                                                        \
+    } while (0)
 #else
 #define val_print(level, ...)                     \
     do {                                          \
-        if ((level) >= acs_policy_get_print_level()) \
+        if (ACS_PRINT_COMPILED_IN(level) &&       \
+            (level) >= acs_policy_get_print_level()) \
             val_printf((level), __VA_ARGS__);     \
     } while (0)
 #endif
@@ -72,6 +92,20 @@
 #define TIMER_TIMEOUT_DEFAULT                   1000000   /*minimum timeout set
                                                           by default for timer tests (1s)*/
 
+/* Wait budgets in microseconds for val_deadline_start(), scaled by the
+   timeout_scale of the execution policy. They replace the TIMEOUT_LARGE,
+   TIMEOUT_MEDIUM and TIMEOUT_SMALL loop counts for waits on an event. */
+#ifndef TIMEOUT_LARGE_US
+#define TIMEOUT_LARGE_US                        2000000
+#endif
+#ifndef TIMEOUT_MEDIUM_US
+#define TIMEOUT_MEDIUM_US                       100000
+#endif
+#ifndef TIMEOUT_SMALL_US
+#define TIMEOUT_SMALL_US                        500
+#endif
+#define TIMEOUT_SCALE_DEFAULT                   100       /*timeout_scale in percent*/
+
 /* EL1 skip-trap param defines (-el1skiptrap) */
 #define EL1SKIPTRAP_PMSIDR   (1u << 0)
 #define EL1SKIPTRAP_CNTPCT   (1u << 1)
@@ -102,7 +136,7 @@ typedef char char8_t;
 
 /* GENERIC VAL APIs */
 void val_allocate_shared_mem(void);
-uintptr_t val_get_status_region_base(void);
+void val_shared_mem_sync_all(void);
 void val_free_shared_mem(void);
 //void val_print(uint32_t level, char8_t *string, uint64_t data);
 void val_print_raw(uint64_t uart_addr, uint32_t level, char8_t *string, uint64_t data);
@@ -111,6 +145,8 @@ void val_print_test_start(char8_t *string);
 void val_print_test_end(uint32_t status, char8_t *string);
 void val_set_test_data(uint32_t index, uint64_t addr, uint64_t test_data);
 void val_get_test_data(uint32_t index, uint64_t *data0, uint64_t *data1);
+uint32_t val_get_test_data_seq(uint32_t index);
+uint32_t val_get_test_timeouts(void);
 void val_dump_dtb(void);
 void view_print_info(uint32_t view);
 void val_log_context(char8_t *file, char8_t *func, uint32_t line);
@@ -118,11 +154,32 @@ uint32_t val_exit_acs(void);
 
 /* Print consolidated ACS test status summary from global counters */
 void val_print_acs_test_status_summary(void);
+/* Print the slowest rules/modules of a rule based run */
+#define RULE_PROFILE_TOP_N 10
+void val_print_rule_profile(uint32_t top_n);
 
 uint32_t execute_tests(void);
 uint64_t val_time_delay_ms(uint64_t time_ms);
 uint64_t val_get_platform_time_us(void);
 
+/* Deadline on the generic timer, see val_deadline_start() */
+typedef struct {
+  uint64_t end;          /* counter value at which the deadline expires */
+  uint64_t backoff;      /* counter ticks waited before the next check */
+  uint64_t backoff_max;
+  bool     expired;
+} val_deadline_t;
+
+void val_deadline_start(val_deadline_t *deadline, uint64_t timeout_us);
+bool val_deadline_expired(val_deadline_t *deadline);
+bool val_deadline_wait_event(val_deadline_t *deadline);
+bool val_deadline_timed_out(const val_deadline_t *deadline);
+void val_deadline_wait_us(uint64_t timeout_us);
+#ifndef TARGET_LINUX
+uint64_t val_wait_event_stream_enable(void);
+void val_wait_event_stream_restore(uint64_t ctl);
+#endif
+
 /* VAL PE APIs */
 typedef enum {
   PE_FEAT_MPAM,
@@ -135,6 +192,15 @@ void     val_pe_cache_clean_invalidate_range(uint64_t start_addr, uint64_t lengt
 void     val_pe_cache_invalidate_range(uint64_t start_addr, uint64_t length);
 void     val_pe_free_info_table(void);
 void     val_execute_on_pe(uint32_t index, void (*payload)(void), uint64_t args);
+uint32_t val_pe_wake(uint32_t index, void (*payload)(void), uint64_t args);
+uint32_t val_pe_pool_init(uint32_t num_pe);
+void     val_pe_pool_park(uint32_t index);
+uint32_t val_pe_pool_dispatch(uint32_t index, void (*payload)(void), uint64_t args);
+void     val_pe_pool_release(void);
+bool     val_pe_has_lse_atomics(void);
+uint32_t val_pe_atomic_add(volatile uint32_t *addr, uint32_t value);
+void     val_pe_spin_lock(volatile uint32_t *lock);
+void     val_pe_spin_unlock(volatile uint32_t *lock);
 void     val_smbios_create_info_table(uint64_t *smbios_info_table);
 void     val_smbios_free_info_table(void);
 
@@ -146,6 +212,7 @@ uint32_t val_pe_get_pmu_gsiv(uint32_t index);
 uint32_t val_pe_get_gmain_gsiv(uint32_t index);
 uint32_t val_pe_get_gicc_trbe_interrupt(uint32_t index);
 uint32_t val_pe_get_index_mpid(uint64_t mpid);
+void     val_pe_set_self_index(uint32_t index);
 uint32_t val_pe_install_esr(uint32_t exception_type, void (*esr)(uint64_t, void *));
 uint32_t val_pe_get_primary_index(void);
 uint32_t val_get_pe_architecture(uint32_t index);
@@ -558,6 +625,7 @@ void val_cache_free_info_table(void);
 uint64_t val_cache_get_info(CACHE_INFO_e type, uint32_t cache_index);
 uint32_t val_cache_get_llc_index(void);
 uint32_t val_cache_get_pe_l1_cache_res(uint32_t res_index);
+uint64_t val_pe_get_cluster_key(uint32_t index);
 uint32_t val_cache_get_associativity(uint64_t cache_id);
 uint64_t val_get_primary_mpidr(void);
 
@@ -30,6 +30,30 @@ void *val_memcpy(void *dst, void *src, uint32_t len);
 
 void val_memory_set(void *dst, uint32_t size, uint8_t value);
 
+/*
+ * Copy loops selectable by tests that use a copy to generate memory traffic.
+ * val_memcpy uses VAL_MEMCPY_LDP. Buffers whose addresses differ modulo 8 are
+ * copied a byte at a time by every variant.
+ */
+typedef enum {
+  VAL_MEMCPY_BYTE,    /* byte loads and stores */
+  VAL_MEMCPY_WORD,    /* 64-bit loads and stores */
+  VAL_MEMCPY_LDP,     /* 64 bytes per iteration with LDP/STP */
+  VAL_MEMCPY_SIMD,    /* 64 bytes per iteration with LDP/STP of Q registers */
+  VAL_MEMCPY_NT,      /* 64 bytes per iteration with LDNP/STNP */
+  VAL_MEMCPY_VARIANT_COUNT
+} val_memcpy_variant_t;
+
+uint32_t val_memcpy_variant_supported(val_memcpy_variant_t variant);
+
+void *val_memcpy_variant(void *dst, void *src, uint32_t len, val_memcpy_variant_t variant);
+
+void *val_memcpy_nt(void *dst, void *src, uint32_t len);
+
+void val_memory_zero(void *dst, uint32_t size);
+
+void val_memcpy_benchmark(void);
+
 uint32_t val_strncmp(char8_t *str1, char8_t *str2, uint32_t length);
 
 char *val_strcat(char *dest, const char *src, size_t output_buff_size);
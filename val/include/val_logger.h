@@ -31,6 +31,17 @@ uint32_t val_printf(print_verbosity_t verbosity, const char *msg, ...);
 uint32_t val_log_get_indent(void);
 void val_log_set_indent(uint32_t indent);
 
+void val_log_replay(const char *buf, uint32_t len);
+
+/* Per-PE log rings, records of secondary PEs are printed by the primary PE */
+uint32_t val_log_ring_init(uint32_t num_pe);
+void val_log_ring_flush(void);
+void val_log_ring_release(void);
+
+/* Binary log (ACS_BINARY_LOG), decoded by tools/scripts/decode_binlog.py */
+void val_binlog_record(print_verbosity_t verbosity, const char *msg, ...);
+void val_binlog_dump(void);
+
 void val_mem_copy(char *dest, const char *src, size_t len);
 
 #endif /* VAL_LOG_H */
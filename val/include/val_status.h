@@ -102,6 +102,10 @@ typedef struct {
 void val_data_cache_ops_by_va(addr_t addr, uint32_t type);
 void     val_set_status(uint32_t index, uint32_t status);
 uint32_t val_get_status(uint32_t index);
+uint32_t val_get_status_nosync(uint32_t index);
+#if !defined(TARGET_LINUX)
+uint32_t val_status_get_done_seq(void);
+#endif
 void     test_report_status(uint32_t status);
 
 #endif /* VAL_STATUS_H */
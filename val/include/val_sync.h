@@ -0,0 +1,82 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+#ifndef VAL_SYNC_H
+#define VAL_SYNC_H
+
+#include "pal_interface.h"
+
+/*
+ * Synchronization of test payloads running on several PEs.
+ *
+ * The objects live in memory shared by the PEs, normally a static of the
+ * test, and are set up by the primary PE before it wakes the secondaries.
+ * Each object fills its own cache line so that PEs working on one object do
+ * not contend with another. The atomics use the Armv8.1 LSE instructions
+ * when the PE implements them, exclusive load/store pairs otherwise, so the
+ * memory must be Normal cacheable with the MMU and caches enabled.
+ */
+
+#define VAL_SYNC_LINE_SIZE      64
+#define VAL_SYNC_GATE_LEAD_US   20     /* default time from the last arrival to the release */
+
+/* Sense-reversing barrier, reusable for any number of rounds */
+typedef struct {
+  volatile uint32_t count;    /* PEs arrived in the current round */
+  volatile uint32_t sense;    /* flipped by the last PE of each round */
+  uint32_t          num_pe;
+} __attribute__((aligned(VAL_SYNC_LINE_SIZE))) val_sync_barrier_t;
+
+typedef enum {
+  VAL_SYNC_REDUCE_SUM,
+  VAL_SYNC_REDUCE_MIN,
+  VAL_SYNC_REDUCE_MAX
+} val_sync_reduce_op_t;
+
+/* Reduction of one uint64_t per PE, reusable for any number of rounds */
+typedef struct {
+  val_sync_barrier_t barrier;
+  volatile uint64_t  value[2] __attribute__((aligned(VAL_SYNC_LINE_SIZE)));
+                              /* combined value, indexed by the barrier sense */
+  uint32_t           op;
+} __attribute__((aligned(VAL_SYNC_LINE_SIZE))) val_sync_reduce_t;
+
+/* Start gate, releases all PEs at the same generic counter value */
+typedef struct {
+  volatile uint32_t count;    /* PEs arrived */
+  uint32_t          num_pe;
+  volatile uint64_t release;  /* CNTVCT value of the release, 0 until all arrived */
+  uint64_t          lead_ticks;
+} __attribute__((aligned(VAL_SYNC_LINE_SIZE))) val_sync_gate_t;
+
+uint32_t val_sync_atomic_add32(volatile uint32_t *addr, uint32_t value);
+uint64_t val_sync_atomic_add64(volatile uint64_t *addr, uint64_t value);
+uint64_t val_sync_atomic_min64(volatile uint64_t *addr, uint64_t value);
+uint64_t val_sync_atomic_max64(volatile uint64_t *addr, uint64_t value);
+
+void     val_sync_barrier_init(val_sync_barrier_t *barrier, uint32_t num_pe);
+uint32_t val_sync_barrier_wait(val_sync_barrier_t *barrier);
+
+void     val_sync_reduce_init(val_sync_reduce_t *reduce, uint32_t num_pe,
+                              val_sync_reduce_op_t op);
+uint32_t val_sync_reduce(val_sync_reduce_t *reduce, uint64_t value, uint64_t *result);
+
+void     val_sync_gate_init(val_sync_gate_t *gate, uint32_t num_pe, uint64_t lead_us);
+uint32_t val_sync_gate_wait(val_sync_gate_t *gate);
+
+void     val_sync_benchmark(uint32_t max_pe);
+
+#endif /* VAL_SYNC_H */
@@ -27,6 +27,7 @@ SYSREG_READ_FUNC(id_aa64dfr0_el1)
 SYSREG_READ_FUNC(id_aa64dfr1_el1)
 
 SYSREG_READ_FUNC(ctr_el0)
+SYSREG_READ_FUNC(dczid_el0)
 
 SYSREG_READ_FUNC(midr_el1)
 SYSREG_READ_FUNC(mpidr_el1)
@@ -58,6 +59,9 @@ SYSREG_READ_FUNC(vtcr_el2)
 SYSREG_RW_FUNCS(vpidr_el2)
 SYSREG_RW_FUNCS(vmpidr_el2)
 
+SYSREG_RW_FUNCS(tpidr_el1)
+SYSREG_RW_FUNCS(tpidr_el2)
+
 SYSREG_READ_FUNC(pmbidr_el1)
 SYSREG_READ_FUNC(pmsidr_el1)
 SYSREG_READ_FUNC(lorid_el1)
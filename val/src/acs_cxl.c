@@ -325,6 +325,9 @@ val_cxl_create_default_component_table(void)
   if (g_cxl_component_table == NULL)
     return ACS_STATUS_ERR;
 
+  /* Built on first use, possibly by a rule, and kept for the run */
+  val_memory_scope_keep(g_cxl_component_table);
+
   for (i = 0; i < CXL_COMPONENT_TABLE_SZ; i++)
     ((uint8_t *)g_cxl_component_table)[i] = 0;
 
@@ -1427,6 +1430,9 @@ val_cxl_map_hdm_address(uint64_t base, uint64_t length, volatile uint64_t **virt
   if (!aligned_va)
     return ACS_STATUS_ERR;
 
+  /* The VA stays mapped to the range after the rule */
+  val_memory_scope_keep(aligned_va);
+
   mem_desc[0].virtual_address  = (uint64_t)aligned_va;
   mem_desc[0].physical_address = aligned_base;
   mem_desc[0].length           = aligned_length;
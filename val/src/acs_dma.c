@@ -18,6 +18,7 @@
 #include "acs_val.h"
 #include "acs_common.h"
 #include "acs_dma.h"
+#include "acs_memory.h"
 #include "pal_interface.h"
 #include "val_interface.h"
 #include "acs_pgt.h"
@@ -147,9 +148,14 @@ val_dma_mem_alloc(void **buffer, uint32_t size, uint32_t dev_index, uint32_t fla
 {
 
   void *ap = NULL;
+  uint64_t status;
 
   ap = (void *)val_dma_get_info(DMA_PORT_INFO, dev_index);
-  return pal_dma_mem_alloc(buffer, size, ap, flags, dma_addr);
+  status = pal_dma_mem_alloc(buffer, size, ap, flags, dma_addr);
+  if (status == 0)
+    val_memory_scope_track(MEM_SCOPE_DMA, *buffer, (uint64_t)*dma_addr, size, dev_index, flags);
+
+  return status;
 
 }
 
@@ -171,6 +177,7 @@ val_dma_mem_free(void *buffer, dma_addr_t mem_dma, uint32_t size, uint32_t dev_i
 
   void *ap = NULL;
 
+  val_memory_scope_untrack(buffer);
   ap = (void *)val_dma_get_info(DMA_PORT_INFO, dev_index);
   pal_dma_mem_free(buffer, mem_dma, size, ap, flags);
 
@@ -29,6 +29,7 @@ void acs_reset_execution_policy(void)
         .timeout_fail = WAKEUP_WD_PASS_TIMEOUT_DEFAULT *
                         WAKEUP_WD_FAILSAFE_TIMEOUT_MULTIPLIER,
         .timer_timeout_us = TIMER_TIMEOUT_DEFAULT,
+        .timeout_scale = TIMEOUT_SCALE_DEFAULT,
         .crypto_support = 1u,
     };
 }
@@ -93,6 +94,11 @@ uint32_t acs_policy_get_timer_timeout_us(void)
     return g_execution_policy.timer_timeout_us;
 }
 
+uint32_t acs_policy_get_timeout_scale(void)
+{
+    return g_execution_policy.timeout_scale;
+}
+
 uint32_t acs_policy_get_crypto_support(void)
 {
     return g_execution_policy.crypto_support;
@@ -107,3 +113,18 @@ uint32_t acs_policy_get_el1skiptrap_mask(void)
 {
     return g_execution_policy.el1skiptrap_mask;
 }
+
+uint32_t acs_policy_get_pe_pool(void)
+{
+    return g_execution_policy.pe_pool;
+}
+
+uint32_t acs_policy_get_resume(void)
+{
+    return g_execution_policy.resume;
+}
+
+uint32_t acs_policy_get_result_sink(void)
+{
+    return g_execution_policy.result_sink;
+}
@@ -376,54 +376,29 @@ val_exerciser_check_firmware_handle_support(void)
     return pal_exerciser_check_firmware_handle_support();
 }
 
-/**
-  @brief Initialize Exerciser test prerequisites and cache the result
-
-  Builds the PCIe BDF table, validates platform hierarchy, discovers Exerciser
-  instances, initializes and disables SMMU contexts, and configures ITS once.
-  Subsequent calls return the cached status from the first invocation.
-  The encoded outcome for the last attempt can be queried via
-  val_exerciser_get_init_result() to surface WARN vs SKIP to rule-based flows.
-
-  @return ACS_STATUS_PASS on success
-  @return ACS_STATUS_SKIP if prerequisites are not met (no ECAM/BDF/Exerciser,
-          invalid hierarchy, SMMU/ITS init failure)
-**/
-uint32_t val_exerciser_test_init(void)
+/* One-time exerciser, SMMU and ITS setup for val_exerciser_test_init() */
+static uint32_t exerciser_test_setup(void)
 {
-/* For non-rule based build the init is done by val_*bsa_exerciser_execute_tests */
-#ifndef COMPILE_RB_EXE
-    g_exerciser_init_result = RESULT_PASS;
-    return ACS_STATUS_PASS;
-#endif
-    static uint32_t status = ACS_STATUS_UNKNOWN;
     uint32_t num_instances = 0;
     uint32_t num_smmu = 0;
     uint32_t instance = 0;
 
-    /* If init already performed return stored status */
-    if (status != ACS_STATUS_UNKNOWN) {
-        return status;
-    }
-
     g_exerciser_init_result = RESULT_PASS;
 
     /* Build BDF table for all PCIe devices */
     if (val_pcie_create_device_bdf_table()) {
         val_print(WARN,
                   "\n       Create BDF Table Failed, Skipping Exerciser tests...");
-        status = ACS_STATUS_SKIP;
         g_exerciser_init_result = RESULT_SKIP(0);
-        return status;
+        return ACS_STATUS_SKIP;
     }
 
     if (pcie_bdf_table_list_flag == 1) {
         val_print(WARN,
                   "\n     *** Created device list with valid bdf doesn't match with the"
                   " platform pcie device hierarchy, Skipping exerciser tests ***\n");
-        status = ACS_STATUS_SKIP;
         g_exerciser_init_result = RESULT_SKIP(0);
-        return status;
+        return ACS_STATUS_SKIP;
     }
 
     val_print(TRACE, "\n      Starting Exerciser Setup\n");
@@ -431,18 +406,16 @@ uint32_t val_exerciser_test_init(void)
     val_exerciser_create_info_table();
     num_instances = val_exerciser_get_info(EXERCISER_NUM_CARDS);
     if (num_instances == 0) {
-        status = ACS_STATUS_SKIP;
         g_exerciser_init_result = RESULT_WARNING(1);
-        return status;
+        return ACS_STATUS_SKIP;
     }
 
     /* Initialize SMMU and disable all contexts initially */
     val_print(TRACE, "\n      Initializing SMMU\n");
     if (val_smmu_init() == ACS_STATUS_ERR) {
         val_print(ERROR, "\n     val_smmu_init() failed \n");
-        status = ACS_STATUS_SKIP;
         g_exerciser_init_result = RESULT_SKIP(0);
-        return status;
+        return ACS_STATUS_SKIP;
     }
 
     num_smmu = val_iovirt_get_smmu_info(SMMU_NUM_CTRL, 0);
@@ -455,14 +428,47 @@ uint32_t val_exerciser_test_init(void)
         val_print(TRACE, "\n      Initializing ITS\n");
         if (val_gic_its_configure() == ACS_STATUS_ERR) {
             val_print(ERROR, "\n     val_gic_its_configure() failed \n");
-            status = ACS_STATUS_SKIP;
             g_exerciser_init_result = RESULT_SKIP(0);
-            return status;
+            return ACS_STATUS_SKIP;
         }
         g_its_init = 1;
     }
 
-    status = ACS_STATUS_PASS;
+    return ACS_STATUS_PASS;
+}
+
+/**
+  @brief Initialize Exerciser test prerequisites and cache the result
+
+  Builds the PCIe BDF table, validates platform hierarchy, discovers Exerciser
+  instances, initializes and disables SMMU contexts, and configures ITS once.
+  Subsequent calls return the cached status from the first invocation.
+  The encoded outcome for the last attempt can be queried via
+  val_exerciser_get_init_result() to surface WARN vs SKIP to rule-based flows.
+
+  @return ACS_STATUS_PASS on success
+  @return ACS_STATUS_SKIP if prerequisites are not met (no ECAM/BDF/Exerciser,
+          invalid hierarchy, SMMU/ITS init failure)
+**/
+uint32_t val_exerciser_test_init(void)
+{
+/* For non-rule based build the init is done by val_*bsa_exerciser_execute_tests */
+#ifndef COMPILE_RB_EXE
+    g_exerciser_init_result = RESULT_PASS;
+    return ACS_STATUS_PASS;
+#endif
+    static uint32_t status = ACS_STATUS_UNKNOWN;
+
+    /* If init already performed return stored status */
+    if (status != ACS_STATUS_UNKNOWN) {
+        return status;
+    }
+
+    /* The tables built here are used by every exerciser rule after this one */
+    val_memory_scope_suspend();
+    status = exerciser_test_setup();
+    val_memory_scope_resume();
+
     return status;
 }
 
@@ -19,6 +19,7 @@
 #include "acs_gic.h"
 #include "acs_gic_support.h"
 #include "acs_common.h"
+#include "acs_memory.h"
 #include "acs_pcie.h"
 #include "acs_iovirt.h"
 #include "acs_exception.h"
@@ -192,20 +193,11 @@ uint32_t val_gic_end_of_interrupt(uint32_t int_id)
   return 0;
 }
 
-/**
-  @brief   This function gets list of ITS in the system and ITS initialization
-           1. Caller       -  Application Layer
-           2. Prerequisite -  val_gic_create_info_table
-  @param   None
-  @return  Status
-**/
-uint32_t val_gic_its_configure()
+/* ITS discovery and init for val_gic_its_configure() */
+static uint32_t gic_its_configure(void)
 {
   uint32_t Status;
 
-  /* Return early if GIC ITS init was done previously */
-  if (g_its_init)
-      return 0;
 
   if (pal_target_is_dt())
     return ACS_STATUS_SKIP;
@@ -285,6 +277,29 @@ its_fail:
   return ACS_STATUS_ERR;
 }
 
+/**
+  @brief   This function gets list of ITS in the system and ITS initialization
+           1. Caller       -  Application Layer
+           2. Prerequisite -  val_gic_create_info_table
+  @param   None
+  @return  Status
+**/
+uint32_t val_gic_its_configure()
+{
+  uint32_t Status;
+
+  /* Return early if GIC ITS init was done previously */
+  if (g_its_init)
+      return 0;
+
+  /* Rules may configure the ITS, its tables are used for the rest of the run */
+  val_memory_scope_suspend();
+  Status = gic_its_configure();
+  val_memory_scope_resume();
+
+  return Status;
+}
+
 /**
   @brief   This function gets ITS Index in g_gic_its_info for its_id
            1. Caller       -  VAL Layer
@@ -22,7 +22,11 @@
 #include "acs_mmu.h"
 #include "acs_pe.h"
 #include "acs_pgt.h"
+#include "acs_dma.h"
 #include "val_interface.h"
+#ifndef TARGET_LINUX
+#include "val_sysreg_pmu_reg.h"
+#endif
 
 MEMORY_INFO_TABLE  *g_memory_info_table;
 extern IOREMMAP_LIST *ioremmap_list;
@@ -33,6 +37,33 @@ extern IOREMMAP_LIST *ioremmap_list;
 
 #define CHECK_ADDR_52BIT(addr) (((uint64_t)(addr)) & ~ADDR_52BIT_MASK)
 
+#define MEM_BENCH_CONTIG_SIZE    (8 * 1024 * 1024)
+#define MEM_BENCH_PASSES         16
+#define MEM_PMU_L1D_TLB_REFILL   0x05
+#define MEM_PMU_TYPER_NSH        (1ULL << 27)  /* count at EL2 */
+#define MEM_PMCR_N_SHIFT         11
+#define MEM_PMCR_N_MASK          0x1F
+#define MEM_PMCR_E               (1ULL << 0)
+
+/* Allocation made while a scope is open, see val_memory_scope_open() */
+typedef struct {
+  void     *addr;
+  uint64_t aux;      /* physical address of cacheable, DMA address of DMA buffers */
+  uint32_t kind;     /* MEM_SCOPE_* */
+  uint32_t size;     /* bytes, pages for MEM_SCOPE_PAGES */
+  uint32_t arg;      /* BDF of cacheable, controller index of DMA buffers */
+  uint32_t flags;    /* DMA flags */
+} mem_scope_record_t;
+
+static struct {
+  volatile uint32_t  lock;
+  volatile uint32_t  open;
+  volatile uint32_t  suspended;
+  uint32_t           count;
+  uint32_t           untracked;
+  mem_scope_record_t record[MEM_SCOPE_MAX_RECORDS];
+} g_mem_scope;
+
 
 #ifdef TARGET_BAREMETAL
 /**
@@ -277,7 +308,10 @@ val_memory_unmap(void *ptr)
 void *
 val_memory_alloc(uint32_t size)
 {
-  return pal_mem_alloc(size);
+  void *addr = pal_mem_alloc(size);
+
+  val_memory_scope_track(MEM_SCOPE_POOL, addr, 0, size, 0, 0);
+  return addr;
 }
 
 /**
@@ -291,7 +325,10 @@ val_memory_alloc(uint32_t size)
 void *
 val_memory_calloc(uint32_t num, uint32_t size)
 {
-  return pal_mem_calloc(num, size);
+  void *addr = pal_mem_calloc(num, size);
+
+  val_memory_scope_track(MEM_SCOPE_POOL, addr, 0, num * size, 0, 0);
+  return addr;
 }
 
 /**
@@ -304,6 +341,7 @@ val_memory_calloc(uint32_t num, uint32_t size)
 void
 val_memory_free(void *addr)
 {
+  val_memory_scope_untrack(addr);
   pal_mem_free(addr);
 }
 
@@ -355,7 +393,10 @@ uint32_t val_memory_page_size(void)
 void *
 val_memory_alloc_pages(uint32_t num_pages)
 {
-    return pal_mem_alloc_pages(num_pages);
+    void *addr = pal_mem_alloc_pages(num_pages);
+
+    val_memory_scope_track(MEM_SCOPE_PAGES, addr, 0, num_pages, 0, 0);
+    return addr;
 }
 
 /**
@@ -369,6 +410,7 @@ val_memory_alloc_pages(uint32_t num_pages)
 void
 val_memory_free_pages(void *addr, uint32_t num_pages)
 {
+    val_memory_scope_untrack(addr);
     pal_mem_free_pages(addr, num_pages);
 }
 
@@ -383,9 +425,10 @@ val_memory_free_pages(void *addr, uint32_t num_pages)
 void
 *val_aligned_alloc(uint32_t alignment, uint32_t size)
 {
+  void *addr = pal_aligned_alloc(alignment, size);
 
-  return pal_aligned_alloc(alignment, size);
-
+  val_memory_scope_track(MEM_SCOPE_ALIGNED, addr, 0, size, 0, 0);
+  return addr;
 }
 
 /**
@@ -398,9 +441,117 @@ void
 void
 val_memory_free_aligned(void *addr)
 {
+  val_memory_scope_untrack(addr);
   pal_mem_free_aligned(addr);
 }
 
+/**
+  @brief  Allocates a physically contiguous buffer aligned to, and covering
+          whole, translation blocks of the requested size. When no such
+          buffer is available the next smaller block size is tried, down to
+          the page size.
+
+  @param  size        Requested size in bytes.
+  @param  flags       MEM_CONTIG_2MB or MEM_CONTIG_1GB.
+  @param  block_size  Size of the stage 1 descriptor that maps the start of
+                      the buffer, 0 if not known. May be NULL.
+
+  @return Pointer to the buffer, NULL if allocation failed. Free it with
+          val_memory_free_contig.
+**/
+void *
+val_memory_alloc_contig(uint32_t size, uint32_t flags, uint64_t *block_size)
+{
+  uint64_t page = val_memory_page_size();
+  uint64_t align;
+  uint64_t len;
+  void *addr = NULL;
+
+  if (flags & MEM_CONTIG_1GB)
+      align = MEM_BLOCK_SIZE_1GB;
+  else if (flags & MEM_CONTIG_2MB)
+      align = MEM_BLOCK_SIZE_2MB;
+  else
+      align = page;
+
+#ifdef TARGET_UEFI
+  /* pal_aligned_alloc pads the pool request by the alignment, so a 1GB block
+     would cost up to 2GB of memory. Use 2MB blocks at most. */
+  if (align > MEM_BLOCK_SIZE_2MB)
+      align = MEM_BLOCK_SIZE_2MB;
+#endif
+
+  while (1) {
+      len = ((uint64_t)size + align - 1) & ~(align - 1);
+      if (len <= 0xFFFFFFFFULL)
+          addr = val_aligned_alloc((uint32_t)align, (uint32_t)len);
+      if (addr != NULL || align <= page)
+          break;
+      align = (align > MEM_BLOCK_SIZE_2MB) ? MEM_BLOCK_SIZE_2MB : page;
+  }
+
+  if (addr == NULL) {
+      val_print(DEBUG, "\n       Contiguous buffer of 0x%x bytes not allocated", size);
+      return NULL;
+  }
+
+  if (block_size != NULL)
+      *block_size = val_memory_get_block_size(addr);
+
+  val_print(TRACE, "\n       Contiguous buffer 0x%llx", (uint64_t)addr);
+  val_print(TRACE, " aligned to 0x%llx", align);
+  return addr;
+}
+
+/**
+  @brief  Free a buffer allocated by val_memory_alloc_contig.
+
+  @param  *addr   pointer to the buffer
+
+  @return None
+**/
+void
+val_memory_free_contig(void *addr)
+{
+  val_memory_free_aligned(addr);
+}
+
+/**
+  @brief  Returns the size of the block or page descriptor of the current
+          stage 1 translation table that maps an address.
+
+  @param  *addr   virtual address
+
+  @return Size in bytes, 0 if the address is not mapped or the tables cannot
+          be walked.
+**/
+uint64_t
+val_memory_get_block_size(void *addr)
+{
+#ifndef TARGET_LINUX
+  pgt_descriptor_t pgt_desc;
+  uint64_t ttbr;
+  uint64_t size;
+
+  val_memory_set(&pgt_desc, sizeof(pgt_desc), 0);
+  pgt_desc.stage = PGT_STAGE1;
+
+  if (val_pe_reg_read_tcr(0 /*for TTBR0*/, &pgt_desc.tcr))
+      return 0;
+  if (val_pe_reg_read_ttbr(0 /*TTBR0*/, &ttbr))
+      return 0;
+
+  pgt_desc.pgt_base = (ttbr & AARCH64_TTBR_ADDR_MASK);
+  if (val_pgt_get_block_size(pgt_desc, (uint64_t)addr, &size))
+      return 0;
+
+  return size;
+#else
+  (void)addr;
+  return 0;
+#endif
+}
+
 /**
   @brief  Sets memory page with WB executable.
 
@@ -514,7 +665,11 @@ val_get_max_memory()
 void *
 val_memory_alloc_cacheable(uint32_t bdf, uint32_t size, void **pa)
 {
-  return pal_mem_alloc_cacheable(bdf, size, pa);
+  void *addr = pal_mem_alloc_cacheable(bdf, size, pa);
+
+  if (addr != NULL)
+    val_memory_scope_track(MEM_SCOPE_CACHEABLE, addr, (uint64_t)*pa, size, bdf, 0);
+  return addr;
 }
 
 /**
@@ -530,6 +685,7 @@ val_memory_alloc_cacheable(uint32_t bdf, uint32_t size, void **pa)
 void
 val_memory_free_cacheable(uint32_t bdf, uint32_t size, void *va, void *pa)
 {
+  val_memory_scope_untrack(va);
   pal_mem_free_cacheable(bdf, size, va, pa);
 }
 
@@ -586,3 +742,319 @@ val_mem_issue_dsb(void)
 #endif
     return;
 }
+
+#ifndef TARGET_LINUX
+/**
+  @brief  Touch one byte in every page of a buffer MEM_BENCH_PASSES times and
+          count the L1 data TLB refills with PMU event counter 0.
+
+  @param  buf   Buffer
+  @param  size  Buffer size in bytes
+
+  @return Refills per pass, or generic counter ticks per pass when the PE
+          does not count L1D_TLB_REFILL (see mem_bench_has_tlb_event).
+**/
+static uint64_t
+mem_bench_walk_pages(volatile uint8_t *buf, uint32_t size)
+{
+  uint32_t page = val_memory_page_size();
+  uint64_t pmcr = read_pmcr_el0();
+  uint64_t cntenset = read_pmcntenset_el0();
+  uint64_t typer = read_pmevtypern_el0(0);
+  uint64_t start;
+  uint64_t count;
+  uint32_t pass;
+  uint32_t offset;
+
+  write_pmcntenclr_el0(1);
+  write_pmevtypern_el0(0, MEM_PMU_L1D_TLB_REFILL | MEM_PMU_TYPER_NSH);
+  write_pmevcntrn_el0(0, 0);
+  write_pmcntenset_el0(1);
+  write_pmcr_el0(pmcr | MEM_PMCR_E);
+  isb();
+
+  start = virtualcounter_read();
+  for (pass = 0; pass < MEM_BENCH_PASSES; pass++) {
+      for (offset = 0; offset < size; offset += page)
+          (void)buf[offset];
+  }
+  dsbsy();
+  count = read_pmevcntrn_el0(0);
+  if (!(read_pmceid0_el0() & (1ULL << MEM_PMU_L1D_TLB_REFILL)))
+      count = virtualcounter_read() - start;
+
+  /* Give the counter back as the PMU tests expect to find it */
+  write_pmcntenclr_el0(1);
+  write_pmevtypern_el0(0, typer);
+  write_pmcntenset_el0(cntenset);
+  write_pmcr_el0(pmcr);
+  isb();
+
+  return count / MEM_BENCH_PASSES;
+}
+
+/**
+  @brief  Compares a page aligned buffer with a val_memory_alloc_contig
+          buffer: prints the stage 1 block size that maps each and the L1
+          data TLB refills of a walk over all of its pages.
+          1. Caller       - Orchestrator, with ACS_MEM_BENCHMARK
+          2. Prerequisite - MMU enabled
+
+  @param  None
+
+  @return None
+**/
+void
+val_memory_contig_benchmark(void)
+{
+  uint32_t page = val_memory_page_size();
+  uint32_t has_event;
+  uint8_t *paged;
+  uint8_t *contig;
+  uint64_t block;
+
+  if (((read_pmcr_el0() >> MEM_PMCR_N_SHIFT) & MEM_PMCR_N_MASK) == 0) {
+      val_print(INFO, "\n TLB refills: no PMU event counter");
+      return;
+  }
+  has_event = (read_pmceid0_el0() & (1ULL << MEM_PMU_L1D_TLB_REFILL)) != 0;
+
+  /* One page past a page alignment, so the buffer straddles block boundaries */
+  paged = val_aligned_alloc(page, MEM_BENCH_CONTIG_SIZE + page);
+  contig = val_memory_alloc_contig(MEM_BENCH_CONTIG_SIZE, MEM_CONTIG_2MB, &block);
+  if (paged == NULL || contig == NULL) {
+      val_print(WARN, "\n TLB refills: buffers not allocated");
+      goto free_buffers;
+  }
+
+  val_print(INFO, "\n %s for a walk over %d KB",
+            has_event ? "L1D TLB refills" : "Generic counter ticks",
+            MEM_BENCH_CONTIG_SIZE / 1024);
+  val_print(INFO, "\n   page aligned : %8ld", mem_bench_walk_pages(paged + page,
+            MEM_BENCH_CONTIG_SIZE));
+  val_print(INFO, ", mapped with 0x%lx blocks", val_memory_get_block_size(paged + page));
+  val_print(INFO, "\n   contiguous   : %8ld", mem_bench_walk_pages(contig,
+            MEM_BENCH_CONTIG_SIZE));
+  val_print(INFO, ", mapped with 0x%lx blocks", block);
+
+free_buffers:
+  if (paged != NULL)
+      val_memory_free_aligned(paged);
+  if (contig != NULL)
+      val_memory_free_contig(contig);
+}
+#endif
+
+/**
+  @brief  Open an allocation scope. Buffers allocated through the VAL memory
+          and DMA allocators from now on, by any PE, are recorded until
+          val_memory_scope_close().
+
+  @param  None
+
+  @return None
+**/
+void
+val_memory_scope_open(void)
+{
+  val_pe_spin_lock(&g_mem_scope.lock);
+  g_mem_scope.count = 0;
+  g_mem_scope.untracked = 0;
+  g_mem_scope.open = 1;
+  val_pe_spin_unlock(&g_mem_scope.lock);
+}
+
+/**
+  @brief  Close the allocation scope and release, newest first, the buffers
+          allocated in it that were not freed or kept.
+
+  @param  report   Released allocations and their size. May be NULL.
+  @param  release  0 to close the scope without releasing the buffers, when
+                   a PE may still be using them.
+
+  @return None
+**/
+void
+val_memory_scope_close(val_memory_scope_report_t *report, bool release)
+{
+  mem_scope_record_t *rec;
+  uint32_t count;
+  uint32_t released;
+  uint32_t untracked;
+  uint64_t bytes = 0;
+
+  val_pe_spin_lock(&g_mem_scope.lock);
+  g_mem_scope.open = 0;
+  count = g_mem_scope.count;
+  untracked = g_mem_scope.untracked;
+  g_mem_scope.count = 0;
+  val_pe_spin_unlock(&g_mem_scope.lock);
+
+  released = count;
+
+  /* The scope is closed, so the frees below do not look for their record */
+  while (count != 0) {
+      rec = &g_mem_scope.record[--count];
+      if (!release) {
+          if (rec->kind == MEM_SCOPE_PAGES)
+              bytes += (uint64_t)rec->size * val_memory_page_size();
+          else
+              bytes += rec->size;
+          continue;
+      }
+
+      switch (rec->kind) {
+      case MEM_SCOPE_PAGES:
+          bytes += (uint64_t)rec->size * val_memory_page_size();
+          val_print(TRACE, "\n       Releasing %d pages", rec->size);
+          val_print(TRACE, " at 0x%llx", (uint64_t)rec->addr);
+          val_memory_free_pages(rec->addr, rec->size);
+          break;
+      case MEM_SCOPE_ALIGNED:
+          bytes += rec->size;
+          val_print(TRACE, "\n       Releasing aligned 0x%llx", (uint64_t)rec->addr);
+          val_memory_free_aligned(rec->addr);
+          break;
+      case MEM_SCOPE_CACHEABLE:
+          bytes += rec->size;
+          val_print(TRACE, "\n       Releasing cacheable 0x%llx", (uint64_t)rec->addr);
+          val_memory_free_cacheable(rec->arg, rec->size, rec->addr, (void *)rec->aux);
+          break;
+      case MEM_SCOPE_DMA:
+          bytes += rec->size;
+          val_print(TRACE, "\n       Releasing DMA buffer 0x%llx", (uint64_t)rec->addr);
+          val_dma_mem_free(rec->addr, (dma_addr_t)rec->aux, rec->size, rec->arg, rec->flags);
+          break;
+      default:
+          bytes += rec->size;
+          val_print(TRACE, "\n       Releasing 0x%llx", (uint64_t)rec->addr);
+          val_memory_free(rec->addr);
+          break;
+      }
+  }
+
+  if (report != NULL) {
+      report->count = released;
+      report->untracked = untracked;
+      report->bytes = bytes;
+  }
+}
+
+/**
+  @brief  Drop an allocation from the open scope so that it outlives it.
+          Used for VAL data that is set up on first use and kept for the
+          rest of the run. No effect when no scope is open.
+
+  @param  addr  Address returned by the allocator.
+
+  @return None
+**/
+void
+val_memory_scope_keep(void *addr)
+{
+  val_memory_scope_untrack(addr);
+}
+
+/**
+  @brief  Stop recording allocations in the open scope, for VAL one-time
+          init whose buffers are kept for the rest of the run. Calls nest,
+          each one is paired with val_memory_scope_resume().
+
+  @param  None
+
+  @return None
+**/
+void
+val_memory_scope_suspend(void)
+{
+  val_pe_spin_lock(&g_mem_scope.lock);
+  g_mem_scope.suspended++;
+  val_pe_spin_unlock(&g_mem_scope.lock);
+}
+
+/**
+  @brief  Undo one val_memory_scope_suspend().
+
+  @param  None
+
+  @return None
+**/
+void
+val_memory_scope_resume(void)
+{
+  val_pe_spin_lock(&g_mem_scope.lock);
+  if (g_mem_scope.suspended != 0)
+      g_mem_scope.suspended--;
+  val_pe_spin_unlock(&g_mem_scope.lock);
+}
+
+/**
+  @brief  Record an allocation in the open scope. Called by the VAL
+          allocators. No effect when no scope is open or it is suspended.
+
+  @param  kind   MEM_SCOPE_* allocator the buffer came from.
+  @param  addr   Address returned by the allocator, NULL is ignored.
+  @param  aux    Physical or DMA address needed to free the buffer.
+  @param  size   Size in bytes, number of pages for MEM_SCOPE_PAGES.
+  @param  arg    BDF or DMA controller index needed to free the buffer.
+  @param  flags  DMA flags needed to free the buffer.
+
+  @return None
+**/
+void
+val_memory_scope_track(uint32_t kind, void *addr, uint64_t aux, uint32_t size,
+                       uint32_t arg, uint32_t flags)
+{
+  mem_scope_record_t *rec;
+
+  if (!g_mem_scope.open || (addr == NULL))
+      return;
+
+  val_pe_spin_lock(&g_mem_scope.lock);
+  if (g_mem_scope.open && !g_mem_scope.suspended) {
+      if (g_mem_scope.count < MEM_SCOPE_MAX_RECORDS) {
+          rec = &g_mem_scope.record[g_mem_scope.count++];
+          rec->addr = addr;
+          rec->aux = aux;
+          rec->kind = kind;
+          rec->size = size;
+          rec->arg = arg;
+          rec->flags = flags;
+      } else {
+          g_mem_scope.untracked++;
+      }
+  }
+  val_pe_spin_unlock(&g_mem_scope.lock);
+}
+
+/**
+  @brief  Remove the record of a buffer that is being freed. Called by the
+          VAL free functions. No effect when no scope is open or the buffer
+          was allocated outside the scope.
+
+  @param  addr  Address of the buffer.
+
+  @return None
+**/
+void
+val_memory_scope_untrack(void *addr)
+{
+  uint32_t i;
+
+  if (!g_mem_scope.open || (addr == NULL))
+      return;
+
+  val_pe_spin_lock(&g_mem_scope.lock);
+  /* Buffers are mostly freed in reverse order, search from the newest */
+  for (i = g_mem_scope.count; i != 0; i--) {
+      if (g_mem_scope.record[i - 1].addr == addr)
+          break;
+  }
+  if (i != 0) {
+      /* Keep the records in allocation order for the release */
+      for (; i < g_mem_scope.count; i++)
+          g_mem_scope.record[i - 1] = g_mem_scope.record[i];
+      g_mem_scope.count--;
+  }
+  val_pe_spin_unlock(&g_mem_scope.lock);
+}
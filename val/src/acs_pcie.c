@@ -31,11 +31,14 @@
 pcie_bdf_list_t *pcie_pheripherals_bdf_list = NULL;
 PCIE_INFO_TABLE *g_pcie_info_table;
 pcie_device_bdf_table *g_pcie_bdf_table;
+pcie_cap_index *g_pcie_cap_index;
 
 uint32_t pcie_bdf_table_list_flag;
 uint32_t g_pcie_integrated_devices;
 uint64_t pal_get_mcfg_ptr(void);
 
+static void pcie_cap_index_create(void);
+
 /**
   @brief   This API reads 32-bit data from PCIe config space pointed by Bus,
            Device, Function and register offset.
@@ -656,6 +659,9 @@ val_pcie_create_device_bdf_table()
   /* Sanity Check : Confirm all EP (normal, integrated) have a rootport */
   val_pcie_populate_device_rootport();
 
+  /* Capability lookups of the enumerated Functions no longer access config space */
+  pcie_cap_index_create();
+
   val_print(INFO,
     "\nPCIE_INFO: Number of BDFs found      :    %d", g_pcie_bdf_table->num_entries);
 
@@ -971,7 +977,7 @@ val_pcie_device_port_type(uint32_t bdf)
 }
 
 /**
-  @brief  Find a Function's config capability offset matching it's input parameter
+  @brief  Walk a Function's capability list in config space for the capability
           cid. cid_offset set to the matching cpability offset w.r.t. zero.
 
   @param  bdf        - Segment/Bus/Dev/Func in the format of PCIE_CREATE_BDF
@@ -981,8 +987,8 @@ val_pcie_device_port_type(uint32_t bdf)
   @return PCIE_CAP_NOT_FOUND, if there was a failure in finding required capability.
           PCIE_SUCCESS, if the search was successful.
 **/
-uint32_t
-val_pcie_find_capability(uint32_t bdf, uint32_t cid_type, uint32_t cid, uint32_t *cid_offset)
+static uint32_t
+pcie_walk_capability(uint32_t bdf, uint32_t cid_type, uint32_t cid, uint32_t *cid_offset)
 {
 
   uint32_t reg_value;
@@ -1033,6 +1039,220 @@ val_pcie_find_capability(uint32_t bdf, uint32_t cid_type, uint32_t cid, uint32_t
   return PCIE_CAP_NOT_FOUND;
 }
 
+/**
+  @brief  Returns the capability index entry of a Function.
+
+  @param  bdf  - Segment/Bus/Dev/Func in the format of PCIE_CREATE_BDF
+  @return Index entry, NULL if the Function is not indexed.
+**/
+static pcie_cap_index_entry *
+pcie_cap_index_lookup(uint32_t bdf)
+{
+  uint32_t low;
+  uint32_t high;
+  uint32_t mid;
+
+  if (g_pcie_cap_index == NULL)
+      return NULL;
+
+  low = 0;
+  high = g_pcie_cap_index->num_entries;
+  while (low < high)
+  {
+      mid = low + (high - low) / 2;
+      if (g_pcie_cap_index->entry[mid].bdf == bdf)
+          return &g_pcie_cap_index->entry[mid];
+      if (g_pcie_cap_index->entry[mid].bdf < bdf)
+          low = mid + 1;
+      else
+          high = mid;
+  }
+
+  return NULL;
+}
+
+/**
+  @brief  Find a Function's config capability offset matching it's input parameter
+          cid. cid_offset set to the matching cpability offset w.r.t. zero.
+          Functions in the BDF table are answered from the capability index
+          without config space accesses, others walk the capability list.
+
+  @param  bdf        - Segment/Bus/Dev/Func in the format of PCIE_CREATE_BDF
+  @param  cid_type   - PCI capability or Extended PCIe capability
+  @param  cid        - Capability ID
+  @param  cid_offset - On return, points to cid offset in Function config space
+  @return PCIE_CAP_NOT_FOUND, if there was a failure in finding required capability.
+          PCIE_SUCCESS, if the search was successful.
+**/
+uint32_t
+val_pcie_find_capability(uint32_t bdf, uint32_t cid_type, uint32_t cid, uint32_t *cid_offset)
+{
+  pcie_cap_index_entry *entry;
+  uint32_t status;
+  uint32_t offset = 0;
+#ifdef ACS_PCIE_CAP_INDEX_CHECK
+  uint32_t hw_status;
+  uint32_t hw_offset = 0;
+#endif
+
+  entry = pcie_cap_index_lookup(bdf);
+
+  if (entry != NULL && cid_type == PCIE_CAP && cid < PCIE_CAP_INDEX_MAX_CID) {
+      status = entry->cap_miss;
+      if (entry->cap_present & (1U << cid)) {
+          offset = entry->cap_offset[cid];
+          status = PCIE_SUCCESS;
+      }
+  } else if (entry != NULL && cid_type == PCIE_ECAP && cid < PCIE_CAP_INDEX_MAX_ECID) {
+      status = entry->ecap_miss;
+      if (entry->ecap_present & (1ULL << cid)) {
+          offset = entry->ecap_offset[cid];
+          status = PCIE_SUCCESS;
+      }
+  } else
+      return pcie_walk_capability(bdf, cid_type, cid, cid_offset);
+
+#ifdef ACS_PCIE_CAP_INDEX_CHECK
+  /* Debug builds confirm the index still matches the hardware */
+  hw_status = pcie_walk_capability(bdf, cid_type, cid, &hw_offset);
+  if (hw_status != status || (status == PCIE_SUCCESS && hw_offset != offset)) {
+      val_print(ERROR, "\n       Capability index mismatch for BDF 0x%x", bdf);
+      val_print(ERROR, " %s", (cid_type == PCIE_CAP) ? "cap" : "ecap");
+      val_print(ERROR, " 0x%x:", cid);
+      val_print(ERROR, " index 0x%x", offset);
+      val_print(ERROR, " status 0x%x,", status);
+      val_print(ERROR, " hardware 0x%x", hw_offset);
+      val_print(ERROR, " status 0x%x", hw_status);
+  }
+#endif
+
+  if (status == PCIE_SUCCESS)
+      *cid_offset = offset;
+
+  return status;
+}
+
+/**
+  @brief  Reads both capability lists of a Function into an index entry.
+          Only the first instance of each capability ID is recorded, as
+          pcie_walk_capability returns.
+
+  @param  bdf    - Segment/Bus/Dev/Func in the format of PCIE_CREATE_BDF
+  @param  entry  - Index entry to fill
+  @return PCIE_SUCCESS, or a failure status if the lists could not be read,
+          in which case lookups of this Function keep walking config space.
+**/
+static uint32_t
+pcie_cap_index_fill(uint32_t bdf, pcie_cap_index_entry *entry)
+{
+  uint32_t reg_value;
+  uint32_t next_cap_offset;
+  uint32_t id;
+  uint32_t hops;
+
+  val_memory_set(entry, sizeof(pcie_cap_index_entry), 0);
+  entry->bdf = bdf;
+  entry->cap_miss = PCIE_CAP_NOT_FOUND;
+  entry->ecap_miss = PCIE_CAP_NOT_FOUND;
+
+  if (val_pcie_read_cfg(bdf, TYPE01_CPR, &reg_value) != PCIE_SUCCESS ||
+      reg_value == PCIE_UNKNOWN_RESPONSE)
+      return PCIE_UNKNOWN_RESPONSE;
+
+  /* A list longer than the config space can hold is looped, leave it to the walk */
+  hops = 0;
+  next_cap_offset = (reg_value & TYPE01_CPR_MASK);
+  while (next_cap_offset)
+  {
+      if (++hops > (PCIE_ECAP_START / 4))
+          return PCIE_CAP_NOT_FOUND;
+
+      val_pcie_read_cfg(bdf, next_cap_offset, &reg_value);
+      id = reg_value & PCIE_CIDR_MASK;
+      if (id < PCIE_CAP_INDEX_MAX_CID && !(entry->cap_present & (1U << id))) {
+          entry->cap_present |= (1U << id);
+          entry->cap_offset[id] = (uint8_t)next_cap_offset;
+      }
+      next_cap_offset = ((reg_value >> PCIE_NCPR_SHIFT) & PCIE_NCPR_MASK);
+  }
+
+  hops = 0;
+  next_cap_offset = PCIE_ECAP_START;
+  while (next_cap_offset)
+  {
+      if (++hops > (PCIE_ECAP_NCPR_MASK / 4))
+          return PCIE_CAP_NOT_FOUND;
+
+      val_pcie_read_cfg(bdf, next_cap_offset, &reg_value);
+
+      /* The walk fails from here on, capabilities after this point are not reachable */
+      if (reg_value == PCIE_UNKNOWN_RESPONSE) {
+          entry->ecap_miss = PCIE_UNKNOWN_RESPONSE;
+          break;
+      }
+
+      id = reg_value & PCIE_ECAP_CIDR_MASK;
+      if (id < PCIE_CAP_INDEX_MAX_ECID && !(entry->ecap_present & (1ULL << id))) {
+          entry->ecap_present |= (1ULL << id);
+          entry->ecap_offset[id] = (uint16_t)next_cap_offset;
+      }
+      next_cap_offset = ((reg_value >> PCIE_ECAP_NCPR_SHIFT) & PCIE_ECAP_NCPR_MASK);
+  }
+
+  return PCIE_SUCCESS;
+}
+
+/**
+  @brief  Creates the capability index of the Functions in the BDF table, so
+          that val_pcie_find_capability makes no config space accesses for them.
+          1. Caller       -  val_pcie_create_device_bdf_table
+          2. Prerequisite -  g_pcie_bdf_table populated
+
+  @param  None
+  @return None. Without an index capability lookups walk config space.
+**/
+static void
+pcie_cap_index_create(void)
+{
+  pcie_cap_index *index;
+  pcie_cap_index_entry entry;
+  uint32_t tbl_index;
+  uint32_t pos;
+
+  if (g_pcie_cap_index != NULL || g_pcie_bdf_table->num_entries == 0)
+      return;
+
+  index = pal_mem_alloc(sizeof(pcie_cap_index) +
+                        g_pcie_bdf_table->num_entries * sizeof(pcie_cap_index_entry));
+  if (index == NULL) {
+      val_print(WARN, "\n       PCIe capability index not allocated");
+      return;
+  }
+
+  index->num_entries = 0;
+  for (tbl_index = 0; tbl_index < g_pcie_bdf_table->num_entries; tbl_index++)
+  {
+      if (pcie_cap_index_fill(g_pcie_bdf_table->device[tbl_index].bdf,
+                              &index->entry[index->num_entries])) {
+          val_print(DEBUG, "\n       BDF 0x%x capability lists not indexed",
+                    g_pcie_bdf_table->device[tbl_index].bdf);
+          continue;
+      }
+
+      /* Enumeration order is ascending within an ECAM, so this rarely shifts */
+      pos = index->num_entries++;
+      while (pos > 0 && index->entry[pos - 1].bdf > index->entry[pos].bdf) {
+          val_memcpy(&entry, &index->entry[pos], sizeof(entry));
+          val_memcpy(&index->entry[pos], &index->entry[pos - 1], sizeof(entry));
+          val_memcpy(&index->entry[pos - 1], &entry, sizeof(entry));
+          pos--;
+      }
+  }
+
+  g_pcie_cap_index = index;
+  val_print(DEBUG, "\n       PCIe capability index: %d Functions", index->num_entries);
+}
+
 /**
   @brief  Disables bus master by clearing Bus Master Enable bit in the command register.
           When BME bit is clear, it disables the ability of a Function to issue Memory
@@ -1466,8 +1686,249 @@ uint32_t val_pcie_bitfield_check(uint32_t bdf, uint64_t *bitfield_entry)
   return 0;
 }
 
+/**
+  @brief  Returns the register a bit-field entry lives in, as a sort key of
+          reg_type, capability ID and word aligned offset.
+
+  @param  bf_entry - Bit-field entry
+  @return Register key
+**/
+static uint64_t
+pcie_bitfield_reg_key(pcie_cfgreg_bitfield_entry *bf_entry)
+{
+  uint64_t id = 0;
+
+  if (bf_entry->reg_type == PCIE_CAP)
+      id = bf_entry->cap_id;
+  else if (bf_entry->reg_type == PCIE_ECAP)
+      id = bf_entry->ecap_id;
+
+  return ((uint64_t)bf_entry->reg_type << 32) | (id << 16) |
+         (bf_entry->reg_offset & ~WORD_ALIGN_MASK);
+}
+
+/**
+  @brief  Builds the check plan of a bit-field table: the entry indices sorted
+          by register, keeping table order within a register.
+
+  @param  bf_info_table        - table of registers and their bit-fields
+  @param  num_bitfield_entries - Number of entries
+  @return Entry indices, NULL if not allocated. Free with val_memory_free.
+**/
+static uint32_t *
+pcie_bitfield_plan_create(pcie_cfgreg_bitfield_entry *bf_info_table,
+                          uint32_t num_bitfield_entries)
+{
+  uint32_t *plan;
+  uint32_t index;
+  uint32_t pos;
+  uint32_t temp;
+
+  plan = val_memory_alloc(num_bitfield_entries * sizeof(uint32_t));
+  if (plan == NULL)
+      return NULL;
+
+  /* Insertion sort is stable and the tables are already mostly grouped */
+  for (index = 0; index < num_bitfield_entries; index++)
+  {
+      pos = index;
+      plan[pos] = index;
+      while (pos > 0 && pcie_bitfield_reg_key(&bf_info_table[plan[pos - 1]]) >
+                        pcie_bitfield_reg_key(&bf_info_table[plan[pos]])) {
+          temp = plan[pos - 1];
+          plan[pos - 1] = plan[pos];
+          plan[pos] = temp;
+          pos--;
+      }
+  }
+
+  return plan;
+}
+
+/**
+  @brief  Reports a bit-field check failure.
+
+  @param  bdf      - Segment/Bus/Dev/Func in the format of PCIE_CREATE_BDF
+  @param  err_str  - Error string of the entry
+  @param  value    - Value found
+  @param  expected - Value expected
+  @return Return 0 if the error string is a warning, else 1.
+**/
+static uint32_t
+pcie_bitfield_report(uint32_t bdf, char *err_str, uint32_t value, uint32_t expected)
+{
+  val_print(ERROR, "\n       BDF 0x%x  ", bdf);
+  val_print(ERROR, err_str);
+  val_print(ERROR, " 0x%x", value);
+  val_print(ERROR, " instead of 0x%x", expected);
+  if (!val_strncmp(err_str, "WARNING", WARN_STR_LEN))
+      return 0;
+  return 1;
+}
+
+/**
+  @brief  Checks all bit-fields of one register of a Function, with the same
+          checks as val_pcie_bitfield_check. The register is read, written
+          back and re-read once, and each bit-field value is checked against
+          that read. Attributes are checked one bit-field at a time, and the
+          register is restored whenever a check changed it.
+
+  @param  bdf          - Segment/Bus/Dev/Func in the format of PCIE_CREATE_BDF
+  @param  dp_type      - Device/port type of the Function
+  @param  bf_table     - Bit-field table
+  @param  plan         - Entry indices of the register
+  @param  count        - Number of entry indices
+  @param  num_pass     - Incremented for each bit-field that passes
+  @param  num_fails    - Incremented for each bit-field that fails
+  @return None
+**/
+static void
+pcie_bitfield_check_register(uint32_t bdf, uint32_t dp_type,
+                             pcie_cfgreg_bitfield_entry *bf_table, uint32_t *plan,
+                             uint32_t count, uint32_t *num_pass, uint32_t *num_fails)
+{
+  pcie_cfgreg_bitfield_entry *bf_entry;
+  uint32_t applicable = 0;
+  uint32_t cap_base = 0;
+  uint32_t status = PCIE_SUCCESS;
+  uint32_t id = 0;
+  uint32_t offset;
+  uint32_t reg_value;
+  uint32_t rsvdp_value = 0;
+  uint32_t rsvdp = 0;
+  uint32_t expected;
+  uint32_t value;
+  uint32_t shift;
+  uint32_t mask;
+  uint32_t fail;
+  uint32_t index;
+
+  for (index = 0; index < count; index++)
+      if (dp_type & bf_table[plan[index]].dev_port_bitmask)
+          applicable++;
+
+  /* No bit-field of this register applies to the Function */
+  if (applicable == 0)
+      return;
+
+  bf_entry = &bf_table[plan[0]];
+  switch (bf_entry->reg_type)
+  {
+      case HEADER:
+          break;
+      case PCIE_CAP:
+          status = val_pcie_find_capability(bdf, PCIE_CAP, bf_entry->cap_id, &cap_base);
+          id = bf_entry->cap_id;
+          break;
+      case PCIE_ECAP:
+          status = val_pcie_find_capability(bdf, PCIE_ECAP, bf_entry->ecap_id, &cap_base);
+          id = bf_entry->ecap_id;
+          break;
+      default:
+          val_print(ERROR, "\n       Invalid reg_type  0x%x", bf_entry->reg_type);
+          *num_fails += applicable;
+          return;
+  }
+
+  if (status != PCIE_SUCCESS)
+  {
+      val_print(ERROR, "\n       PCIe Capability 0x%x", id);
+      val_print(ERROR, " not found for BDF 0x%x", bdf);
+      *num_fails += applicable;
+      return;
+  }
+
+  offset = cap_base + (bf_entry->reg_offset & ~WORD_ALIGN_MASK);
+
+  /* To prevent status bits are clear when write 1, just clear it firstly */
+  val_pcie_read_cfg(bdf, offset, &reg_value);
+  val_pcie_write_cfg(bdf, offset, reg_value);
+  val_pcie_read_cfg(bdf, offset, &reg_value);
+
+  for (index = 0; index < count; index++)
+  {
+      bf_entry = &bf_table[plan[index]];
+      if (!(dp_type & bf_entry->dev_port_bitmask))
+          continue;
+
+      shift = REG_SHIFT(bf_entry->reg_offset & WORD_ALIGN_MASK, bf_entry->start);
+      mask = REG_MASK(bf_entry->end, bf_entry->start);
+
+      /* Check if bit-field value is proper */
+      if (((reg_value >> shift) & mask) != bf_entry->cfg_value)
+      {
+          fail = pcie_bitfield_report(bdf, bf_entry->err_str1, (reg_value >> shift) & mask,
+                                      bf_entry->cfg_value);
+          *num_fails += fail;
+          *num_pass += !fail;
+          continue;
+      }
+
+      /* Check if bit-field attribute is proper */
+      switch (bf_entry->attr)
+      {
+          case HW_INIT:
+          case READ_ONLY:
+          case STICKY_RO:
+              /* Software must not alter these bits */
+              val_pcie_write_cfg(bdf, offset, reg_value ^ (mask << shift));
+              val_pcie_read_cfg(bdf, offset, &value);
+              expected = reg_value;
+              break;
+          case RSVDP_RO:
+              /* Software must preserve the value read to write to these bits,
+                 the write is the same for every RsvdP bit-field */
+              if (!rsvdp) {
+                  val_pcie_write_cfg(bdf, offset, reg_value);
+                  val_pcie_read_cfg(bdf, offset, &rsvdp_value);
+                  rsvdp = 1;
+              }
+              /* Software must return 0 when read */
+              value = ((rsvdp_value >> shift) & mask) << shift;
+              expected = 0;
+              break;
+          case RSVDZ_RO:
+              /* Software must use 0b to write to these bits */
+              val_pcie_write_cfg(bdf, offset, reg_value & ~(mask << shift));
+              val_pcie_read_cfg(bdf, offset, &value);
+              expected = reg_value;
+              break;
+          case READ_WRITE:
+          case STICKY_RW:
+              /* Software can alter these bits, toggle the required bits and write to register */
+              expected = reg_value ^ (mask << shift);
+              val_pcie_write_cfg(bdf, offset, expected);
+              val_pcie_read_cfg(bdf, offset, &value);
+              break;
+          default:
+              val_print(ERROR, "\n       Invalid Attribute  0x%x  ", bf_entry->attr);
+              (*num_fails)++;
+              continue;
+      }
+
+      /* Restore the original register value for the next bit-field */
+      if (bf_entry->attr != RSVDP_RO && value != reg_value)
+          val_pcie_write_cfg(bdf, offset, reg_value);
+
+      fail = 0;
+      if (value != expected)
+          fail = pcie_bitfield_report(bdf, bf_entry->err_str2, value >> shift,
+                                      expected >> shift);
+
+      if (fail) {
+          (*num_fails)++;
+      } else {
+          if (value == expected)
+              val_print(TRACE, "\n       BDF 0x%x  PASS", bdf);
+          (*num_pass)++;
+      }
+  }
+}
+
 /**
   @brief  Returns if a PCIe config register bitfields are as per bsa specification.
+          Entries are checked one register at a time, see
+          pcie_bitfield_check_register.
 
   @param  bf_info_table - table of registers and their bit-fields for checking
   @param  num_bitfield_entries - Number of entries
@@ -1485,13 +1946,21 @@ val_pcie_register_bitfields_check(uint64_t *bf_info_table, uint32_t num_bitfield
   uint32_t num_fails;
   uint32_t num_pass;
   uint32_t index;
+  uint32_t count;
+  uint32_t *plan;
+  pcie_cfgreg_bitfield_entry *bf_table;
   pcie_cfgreg_bitfield_entry *bf_entry;
 
   num_fails = num_pass = tbl_index = 0;
+  bf_table = (pcie_cfgreg_bitfield_entry *)bf_info_table;
 
   val_print(TRACE, "\n       Number of bit-field entries to check %d",
             num_bitfield_entries);
 
+  plan = pcie_bitfield_plan_create(bf_table, num_bitfield_entries);
+  if (plan == NULL)
+      val_print(DEBUG, "\n       Bit-field plan not allocated, checking entries one by one");
+
   while (tbl_index < g_pcie_bdf_table->num_entries)
   {
       bdf = g_pcie_bdf_table->device[tbl_index++].bdf;
@@ -1502,6 +1971,22 @@ val_pcie_register_bitfields_check(uint64_t *bf_info_table, uint32_t num_bitfield
       /* Get the Function's device/port type from bdf */
       dp_type = val_pcie_device_port_type(bdf);
 
+      if (plan != NULL)
+      {
+          for (index = 0; index < num_bitfield_entries; index += count)
+          {
+              count = 1;
+              while (index + count < num_bitfield_entries &&
+                     pcie_bitfield_reg_key(&bf_table[plan[index + count]]) ==
+                     pcie_bitfield_reg_key(&bf_table[plan[index]]))
+                  count++;
+
+              pcie_bitfield_check_register(bdf, dp_type, bf_table, &plan[index], count,
+                                           &num_pass, &num_fails);
+          }
+          continue;
+      }
+
       /* Set variables to iterate over all bit-field entries */
       bf_entry = (pcie_cfgreg_bitfield_entry *)&(bf_info_table[0]);
 
@@ -1528,6 +2013,9 @@ val_pcie_register_bitfields_check(uint64_t *bf_info_table, uint32_t num_bitfield
       }
   }
 
+  if (plan != NULL)
+      val_memory_free(plan);
+
   /* Return register check status */
   if (num_pass > 0 || num_fails > 0)
       return num_fails;
@@ -2448,6 +2936,8 @@ pcie_bdf_list_t *val_pcie_get_pcie_peripheral_bdf_list(void)
                 );
       return NULL;
   }
+  /* Prepared on first use by a rule and returned to later rules */
+  val_memory_scope_keep(pcie_pheripherals_bdf_list);
 
   /* Init the bdf count */
   pcie_pheripherals_bdf_list->count = 0;
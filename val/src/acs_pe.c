@@ -677,6 +677,32 @@ val_cache_get_pe_l1_cache_res(uint32_t res_index)
   }
 }
 
+/**
+  @brief  This API returns a key that groups PEs by cluster. From the PPTT
+          cache hierarchy, it is the index of the first shared cache above
+          the level 1 cache of the PE. Without cache information, the MPIDR
+          affinity above Aff0 is used.
+  @param  index - PE index.
+  @return Cluster key, equal for PEs of the same cluster.
+**/
+uint64_t val_pe_get_cluster_key(uint32_t index)
+{
+  PE_INFO_ENTRY *entry = &g_pe_info_table->pe_info[index];
+  uint32_t cache_idx;
+
+  if (g_cache_info_table != NULL && g_cache_info_table->num_of_cache != 0) {
+      cache_idx = entry->level_1_res[0];
+      while (cache_idx < g_cache_info_table->num_of_cache) {
+          if (!g_cache_info_table->cache_info[cache_idx].is_private)
+              return cache_idx;
+          cache_idx = g_cache_info_table->cache_info[cache_idx].next_level_index;
+      }
+  }
+
+  /* Kept apart from the cache indexes above */
+  return (1ull << 40) | ((entry->mpidr & MPIDR_AFF_MASK) >> 8);
+}
+
 /**
   @brief   This API checks whether the requested PE feature is implemented or not.
   @param   pe_feature - PE feature to be checked.
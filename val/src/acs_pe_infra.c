@@ -22,6 +22,9 @@
 #include "acs_exception.h"
 #include "val_interface.h"
 #include "pal_interface.h"
+#ifndef TARGET_LINUX
+#include "acs_memory.h"
+#endif
 
 PE_SMBIOS_PROCESSOR_INFO_TABLE *g_smbios_info_table;
 int32_t gPsciConduit;
@@ -38,9 +41,135 @@ PE_INFO_TABLE *g_pe_info_table;
 **/
 ARM_SMC_ARGS g_smc_args;
 
+#ifndef TARGET_LINUX
+/*
+ * Parked secondary PE worker pool (opt-in, see val_pe_pool_init()).
+ *
+ * A secondary PE brought up with PSCI CPU_ON does not switch itself off after
+ * its payload while the pool is active. It waits in WFE on its mailbox, and
+ * val_execute_on_pe() hands it the next payload with SEV instead of another
+ * CPU_ON/CPU_OFF round trip through the firmware. The PE waits for the
+ * sequence number of its shared mailbox to move (val_set_test_data()).
+ */
+#define PE_POOL_OFF        0  /* not parked, use PSCI CPU_ON */
+#define PE_POOL_PARKED     1  /* waiting in WFE for a payload */
+#define PE_POOL_RUNNING    2  /* executing a payload handed over by the pool */
+
+#define PE_POOL_SLOT_SIZE  64 /* one cache line per PE */
+
+typedef struct {
+  volatile uint32_t state;  /* PE_POOL_* written by the secondary PE */
+  volatile uint32_t exit;   /* set with the last post, switch off */
+  uint8_t           pad[PE_POOL_SLOT_SIZE - (2 * sizeof(uint32_t))];
+} val_pe_pool_slot_t;
+
+typedef struct {
+  uint32_t            num_pe;
+  val_pe_pool_slot_t *slot;  /* indexed by PE index */
+} val_pe_pool_t;
+
+static val_pe_pool_t *g_pe_pool;
+#endif
+
 /* global variable to store primary PE index */
 uint32_t g_primary_pe_index = ACS_INVALID_INDEX;
 
+#ifndef TARGET_LINUX
+/*
+ * MPIDR to PE index lookup.
+ *
+ * g_pe_affinity_hash is an open addressing table indexed by a hash of the
+ * MPIDR affinity fields, holding PE info entry + 1 (0 for an empty slot). It is
+ * built once by val_pe_create_info_table() and read-only afterwards.
+ *
+ * Each PE also keeps its own index in TPIDR_ELx, tagged with its affinity so
+ * that a value left by firmware, or lost over a power down, is never taken
+ * for a cached index.
+ */
+#define PE_AFF_COMPACT(mpidr)    ((uint32_t)(((mpidr) & 0xFFFFFF) | (((mpidr) >> 8) & 0xFF000000)))
+#define PE_SELF_INDEX_TAG        0xAC5Eull
+#define PE_SELF_INDEX_TAG_SHIFT  16
+#define PE_SELF_INDEX_AFF_SHIFT  32
+#define PE_SELF_INDEX_MASK       0xFFFF
+
+static uint32_t *g_pe_affinity_hash;
+static uint32_t  g_pe_affinity_hash_mask;
+
+/**
+  @brief   Hash of the affinity fields of an MPIDR value.
+  @param   mpid - MPIDR affinity bits
+  @return  Hash value, to be masked with the table size
+**/
+static inline uint32_t
+val_pe_affinity_hash(uint64_t mpid)
+{
+  return (PE_AFF_COMPACT(mpid) * 0x9E3779B1u) >> 8;
+}
+
+/**
+  @brief   Builds the MPIDR to PE index hash table from g_pe_info_table.
+           The linear walk is used if the table cannot be allocated.
+  @param   None
+  @return  None
+**/
+static void
+val_pe_build_affinity_hash(void)
+{
+  uint32_t num_pe = g_pe_info_table->header.num_of_pe;
+  uint32_t size = 1;
+  uint32_t slot;
+  uint32_t i;
+  uint32_t *hash;
+
+  /* At most half full, so a lookup mostly hits on the first probe */
+  while (size < (2 * num_pe))
+      size <<= 1;
+
+  hash = val_memory_calloc(size, sizeof(uint32_t));
+  if (hash == NULL) {
+      val_print(DEBUG, "\n       PE affinity lookup table not allocated");
+      return;
+  }
+  val_memory_scope_keep(hash);
+
+  for (i = 0; i < num_pe; i++) {
+      slot = val_pe_affinity_hash(g_pe_info_table->pe_info[i].mpidr) & (size - 1);
+      while (hash[slot] != 0)
+          slot = (slot + 1) & (size - 1);
+      hash[slot] = i + 1;
+  }
+
+  val_pe_cache_clean_invalidate_range((uint64_t)(uintptr_t)hash, size * sizeof(uint32_t));
+
+  g_pe_affinity_hash_mask = size - 1;
+  g_pe_affinity_hash = hash;
+  val_data_cache_ops_by_va((addr_t)&g_pe_affinity_hash_mask, CLEAN_AND_INVALIDATE);
+  val_data_cache_ops_by_va((addr_t)&g_pe_affinity_hash, CLEAN_AND_INVALIDATE);
+}
+
+/**
+  @brief   Caches the index of the calling PE in TPIDR_ELx for
+           val_pe_get_index_mpid(val_pe_get_mpid()).
+           1. Caller       -  VAL, on each PE as it starts
+           2. Prerequisite -  val_pe_create_info_table
+  @param   index - Index of the calling PE
+  @return  None
+**/
+void
+val_pe_set_self_index(uint32_t index)
+{
+  uint64_t tag;
+
+  tag = ((uint64_t)PE_AFF_COMPACT(val_pe_get_mpid()) << PE_SELF_INDEX_AFF_SHIFT) |
+        (PE_SELF_INDEX_TAG << PE_SELF_INDEX_TAG_SHIFT) | (index & PE_SELF_INDEX_MASK);
+
+  if (get_current_el() == 2)
+      write_tpidr_el2(tag);
+  else
+      write_tpidr_el1(tag);
+}
+#endif
+
 /**
   @brief   This API will call PAL layer to fill in the PE information
            into the g_pe_info_table pointer.
@@ -81,6 +210,10 @@ val_pe_create_info_table(uint64_t *pe_info_table)
   pal_pe_create_info_table(g_pe_info_table);
   val_data_cache_ops_by_va((addr_t)&g_pe_info_table, CLEAN_AND_INVALIDATE);
 
+#ifndef TARGET_LINUX
+  val_pe_build_affinity_hash();
+#endif
+
   val_print(INFO, "\nPE_INFO: Number of PE detected       : %4d", val_pe_get_num());
 
   if (val_pe_get_num() == 0) {
@@ -101,6 +234,9 @@ val_print(INFO, "\nPrimary PE: MIDR_EL1                 :    0x%llx",
 
       g_primary_pe_index = val_pe_get_index_mpid(g_primary_mpidr);
   }
+#ifndef TARGET_LINUX
+  val_pe_set_self_index(val_pe_get_index_mpid(val_pe_get_mpid()));
+#endif
   val_print(DEBUG, "\nPE_INFO: Primary PE index       : %4d",
             g_primary_pe_index);
 
@@ -120,6 +256,12 @@ val_pe_free_info_table(void)
     if (g_pe_info_table != NULL) {
         pal_mem_free_aligned((void *)g_pe_info_table);
         g_pe_info_table = NULL;
+#ifndef TARGET_LINUX
+        if (g_pe_affinity_hash != NULL) {
+            val_memory_free(g_pe_affinity_hash);
+            g_pe_affinity_hash = NULL;
+        }
+#endif
     }
     else {
       val_print(DEBUG,
@@ -193,7 +335,10 @@ val_pe_get_mpid_index(uint32_t index)
 
 
 /**
-  @brief   This API returns the index of the PE whose MPIDR matches with the input MPIDR
+  @brief   This API returns the index of the PE whose MPIDR matches with the input MPIDR.
+           The index of the calling PE comes from TPIDR_ELx, other PEs are
+           looked up in the affinity hash table, with the linear walk of
+           the PE info table as fallback.
            1. Caller       -  Test Suite, VAL
            2. Prerequisite -  val_create_peinfo_table
   @param   mpid - the mpidr value of pE whose index is returned.
@@ -205,6 +350,35 @@ val_pe_get_index_mpid(uint64_t mpid)
 
   PE_INFO_ENTRY *entry;
   uint32_t i = g_pe_info_table->header.num_of_pe;
+#ifndef TARGET_LINUX
+  uint64_t self;
+  uint32_t slot;
+  uint32_t index;
+
+  /* Who am I: one register read */
+  self = (get_current_el() == 2) ? read_tpidr_el2() : read_tpidr_el1();
+  if (((self >> PE_SELF_INDEX_TAG_SHIFT) & 0xFFFF) == PE_SELF_INDEX_TAG &&
+      (uint32_t)(self >> PE_SELF_INDEX_AFF_SHIFT) == PE_AFF_COMPACT(mpid))
+      return (uint32_t)(self & PE_SELF_INDEX_MASK);
+
+  if (g_pe_affinity_hash != NULL) {
+      slot = val_pe_affinity_hash(mpid) & g_pe_affinity_hash_mask;
+      while (1) {
+          val_data_cache_ops_by_va((addr_t)&g_pe_affinity_hash[slot], INVALIDATE);
+          index = g_pe_affinity_hash[slot];
+          if (index == 0)
+              return 0x0;  //Not found, same failsafe as the walk below
+
+          entry = &g_pe_info_table->pe_info[index - 1];
+          val_data_cache_ops_by_va((addr_t)&entry->mpidr, INVALIDATE);
+          val_data_cache_ops_by_va((addr_t)&entry->pe_num, INVALIDATE);
+          if (entry->mpidr == mpid)
+              return entry->pe_num;
+
+          slot = (slot + 1) & g_pe_affinity_hash_mask;
+      }
+  }
+#endif
 
   entry = g_pe_info_table->pe_info;
 
@@ -223,6 +397,249 @@ val_pe_get_index_mpid(uint64_t mpid)
 }
 
 
+#ifndef TARGET_LINUX
+/**
+  @brief   Returns the worker pool as last published by the primary PE.
+  @param   None
+  @return  Worker pool, NULL if the pool is not active
+**/
+static val_pe_pool_t *
+val_pe_pool_get(void)
+{
+  val_data_cache_ops_by_va((addr_t)&g_pe_pool, INVALIDATE);
+  return g_pe_pool;
+}
+
+/**
+  @brief   Sets up the parked secondary PE worker pool.
+           Secondary PEs join the pool when they finish a payload started
+           with PSCI CPU_ON, so bring-up stays lazy.
+           1. Caller       -  Rule orchestrator
+           2. Prerequisite -  val_create_peinfo_table, val_allocate_shared_mem
+  @param   num_pe - Number of PEs in the system
+  @return  ACS_STATUS_PASS if the pool is active, ACS_STATUS_ERR otherwise
+**/
+uint32_t
+val_pe_pool_init(uint32_t num_pe)
+{
+  val_pe_pool_t *pool;
+
+  if (val_pe_pool_get() != NULL)
+      return ACS_STATUS_PASS;
+
+  pool = val_memory_alloc(sizeof(val_pe_pool_t));
+  if (pool == NULL)
+      return ACS_STATUS_ERR;
+
+  pool->slot = val_aligned_alloc(PE_POOL_SLOT_SIZE, num_pe * sizeof(val_pe_pool_slot_t));
+  if (pool->slot == NULL) {
+      val_memory_free(pool);
+      return ACS_STATUS_ERR;
+  }
+
+  /* The pool outlives a rule that sets it up, val_pe_pool_release() frees it */
+  val_memory_scope_keep(pool);
+  val_memory_scope_keep(pool->slot);
+
+  pool->num_pe = num_pe;
+  val_memory_set(pool->slot, num_pe * sizeof(val_pe_pool_slot_t), 0);
+  val_pe_cache_clean_invalidate_range((uint64_t)(uintptr_t)pool->slot,
+                                      num_pe * sizeof(val_pe_pool_slot_t));
+  val_pe_cache_clean_invalidate_range((uint64_t)(uintptr_t)pool, sizeof(val_pe_pool_t));
+
+  g_pe_pool = pool;
+  val_data_cache_ops_by_va((addr_t)&g_pe_pool, CLEAN_AND_INVALIDATE);
+  return ACS_STATUS_PASS;
+}
+
+/**
+  @brief   Parks the calling secondary PE in WFE and runs the payloads posted
+           to its mailbox, until the pool is released.
+           1. Caller       -  val_test_entry
+           2. Prerequisite -  val_pe_pool_init
+  @param   index - Index of the calling PE
+  @return  None, returns when the PE must be switched off
+**/
+void
+val_pe_pool_park(uint32_t index)
+{
+  val_pe_pool_t *pool = val_pe_pool_get();
+  val_pe_pool_slot_t *slot;
+  void (*vector)(uint64_t args);
+  uint64_t test_arg;
+  uint32_t seen;
+
+  if (pool == NULL || index >= pool->num_pe)
+      return;
+
+  slot = &pool->slot[index];
+  seen = val_get_test_data_seq(index);
+
+  while (1) {
+      slot->state = PE_POOL_PARKED;
+      val_data_cache_ops_by_va((addr_t)slot, CLEAN_AND_INVALIDATE);
+
+      /* A post between the read of seq and WFE leaves the event set */
+      do {
+          wfe();
+      } while (val_get_test_data_seq(index) == seen);
+
+      seen = val_get_test_data_seq(index);
+      val_data_cache_ops_by_va((addr_t)slot, CLEAN_AND_INVALIDATE);
+      if (slot->exit)
+          break;
+
+      slot->state = PE_POOL_RUNNING;
+      val_data_cache_ops_by_va((addr_t)slot, CLEAN_AND_INVALIDATE);
+
+      val_get_test_data(index, (uint64_t *)&vector, &test_arg);
+      vector(test_arg);
+
+      /* A payload may post to its own mailbox (wake-up tree relay), nothing
+         else posts to a PE that is not parked */
+      seen = val_get_test_data_seq(index);
+  }
+
+  slot->state = PE_POOL_OFF;
+  val_data_cache_ops_by_va((addr_t)slot, CLEAN_AND_INVALIDATE);
+}
+
+/**
+  @brief   Records the pool state of a PE woken with PSCI CPU_ON, so that
+           the PE is waited for until it parks after its payload.
+           1. Caller       -  val_pe_wake
+           2. Prerequisite -  None
+  @param   index - Index of the PE
+  @param   state - PE_POOL_RUNNING before CPU_ON, PE_POOL_OFF if it failed
+  @return  None
+**/
+static void
+val_pe_pool_set_state(uint32_t index, uint32_t state)
+{
+  val_pe_pool_t *pool = val_pe_pool_get();
+
+  if (pool == NULL || index >= pool->num_pe)
+      return;
+
+  pool->slot[index].state = state;
+  val_data_cache_ops_by_va((addr_t)&pool->slot[index], CLEAN_AND_INVALIDATE);
+}
+
+/**
+  @brief   Hands a payload to a secondary PE parked in the worker pool.
+           A PE still running its previous payload is waited for until it
+           parks, it must not be woken with PSCI CPU_ON.
+           1. Caller       -  val_execute_on_pe
+           2. Prerequisite -  val_pe_pool_init
+  @param   index      - Index of the PE
+  @param   payload    - Function pointer of the test to be executed on the PE
+  @param   test_input - arguments to be passed to the test
+  @return  ACS_STATUS_PASS if posted, ACS_STATUS_SKIP if the PE is not in
+           the pool, ACS_STATUS_FAIL if it did not finish its previous payload
+**/
+uint32_t
+val_pe_pool_dispatch(uint32_t index, void (*payload)(void), uint64_t test_input)
+{
+  val_pe_pool_t *pool = val_pe_pool_get();
+  val_pe_pool_slot_t *slot;
+  val_deadline_t deadline;
+
+  if (pool == NULL || index >= pool->num_pe)
+      return ACS_STATUS_SKIP;
+
+  slot = &pool->slot[index];
+  val_deadline_start(&deadline, TIMEOUT_LARGE_US);
+  do {
+      val_data_cache_ops_by_va((addr_t)slot, CLEAN_AND_INVALIDATE);
+  } while (slot->state == PE_POOL_RUNNING && !val_deadline_expired(&deadline));
+
+  if (slot->state == PE_POOL_RUNNING)
+      return ACS_STATUS_FAIL;
+  if (slot->state != PE_POOL_PARKED)
+      return ACS_STATUS_SKIP;
+
+  slot->state = PE_POOL_RUNNING;
+  val_data_cache_ops_by_va((addr_t)slot, CLEAN_AND_INVALIDATE);
+
+  /* Bumps the mailbox sequence the parked PE waits on */
+  val_set_test_data(index, (uint64_t)payload, test_input);
+  val_mem_issue_dsb();
+  sev();
+
+  return ACS_STATUS_PASS;
+}
+
+/**
+  @brief   Switches off the PEs parked in the worker pool with PSCI CPU_OFF
+           and releases the pool. PEs still running a payload are waited for
+           until they park. Memory is kept if a PE did not come back from its
+           payload, since it may still park on its mailbox.
+           1. Caller       -  Rule orchestrator
+           2. Prerequisite -  None
+  @param   None
+  @return  None
+**/
+void
+val_pe_pool_release(void)
+{
+  val_pe_pool_t *pool = val_pe_pool_get();
+  val_pe_pool_slot_t *slot;
+  val_deadline_t deadline;
+  uint32_t stalled = 0;
+  uint32_t i;
+
+  if (pool == NULL)
+      return;
+
+  /* Let running payloads return while the pool is published, so they park */
+  for (i = 0; i < pool->num_pe; i++) {
+      slot = &pool->slot[i];
+      val_deadline_start(&deadline, TIMEOUT_LARGE_US);
+      do {
+          val_data_cache_ops_by_va((addr_t)slot, CLEAN_AND_INVALIDATE);
+      } while (slot->state == PE_POOL_RUNNING && !val_deadline_expired(&deadline));
+
+      if (slot->state == PE_POOL_RUNNING) {
+          val_print(WARN, "\n       PE index %d still running a payload, not parked", i);
+          stalled = 1;
+      }
+  }
+
+  /* PEs finishing a payload from now on switch off instead of parking */
+  g_pe_pool = NULL;
+  val_data_cache_ops_by_va((addr_t)&g_pe_pool, CLEAN_AND_INVALIDATE);
+
+  for (i = 0; i < pool->num_pe; i++) {
+      slot = &pool->slot[i];
+      val_data_cache_ops_by_va((addr_t)slot, CLEAN_AND_INVALIDATE);
+      if (slot->state != PE_POOL_PARKED)
+          continue;
+
+      slot->exit = 1;
+      val_data_cache_ops_by_va((addr_t)slot, CLEAN_AND_INVALIDATE);
+      val_set_test_data(i, 0, 0);
+      val_mem_issue_dsb();
+      sev();
+
+      val_deadline_start(&deadline, TIMEOUT_LARGE_US);
+      do {
+          val_data_cache_ops_by_va((addr_t)slot, CLEAN_AND_INVALIDATE);
+      } while (slot->state != PE_POOL_OFF && !val_deadline_expired(&deadline));
+
+      if (val_deadline_timed_out(&deadline)) {
+          val_print(WARN, "\n       PE index %d did not leave the worker pool", i);
+          stalled = 1;
+      }
+  }
+
+  if (stalled)
+      return;
+
+  val_memory_free_aligned(pool->slot);
+  val_memory_free(pool);
+}
+#endif
+
 /**
   @brief   'C' Entry point for Secondary PE.
            Uses PSCI_CPU_OFF to switch off PE after payload execution.
@@ -239,10 +656,20 @@ val_test_entry(void)
   uint64_t test_arg;
   ARM_SMC_ARGS smc_args;
   void (*vector)(uint64_t args);
+  uint32_t index = val_pe_get_index_mpid(val_pe_get_mpid());
 
-  val_get_test_data(val_pe_get_index_mpid(val_pe_get_mpid()), (uint64_t *)&vector, &test_arg);
+#ifndef TARGET_LINUX
+  /* Later "who am I" queries of the payloads read TPIDR_ELx */
+  val_pe_set_self_index(index);
+#endif
+  val_get_test_data(index, (uint64_t *)&vector, &test_arg);
   vector(test_arg);
 
+#ifndef TARGET_LINUX
+  /* Wait for more payloads while the worker pool is active */
+  val_pe_pool_park(index);
+#endif
+
   // We have completed our TEST code. So, switch off the PE now
   smc_args.Arg0 = ARM_SMC_ID_PSCI_CPU_OFF;
   smc_args.Arg1 = val_pe_get_mpid();
@@ -251,56 +678,275 @@ val_test_entry(void)
 
 
 /**
-  @brief   This API initiates the execution of a test on a secondary PE.
-           Uses PSCI_CPU_ON to wake a secondary PE
-           1. Caller       -  Test Suite
+  @brief   Wakes a secondary PE with PSCI CPU_ON to run a payload.
+           The mailbox is written once: a PE that parks in the worker pool
+           while CPU_ON is retried must not see its sequence move again.
+           1. Caller       -  val_pe_wake
            2. Prerequisite -  val_create_peinfo_table
   @param   index - Index of the PE to be woken up
   @param   payload - Function pointer of the test to be executed on the PE
   @param   test_input - arguments to be passed to the test.
-  @return  None
+  @return  PSCI CPU_ON return value
 **/
-void
-val_execute_on_pe(uint32_t index, void (*payload)(void), uint64_t test_input)
+static int64_t
+val_pe_wake_psci(uint32_t index, void (*payload)(void), uint64_t test_input)
 {
+  ARM_SMC_ARGS smc_args;
+  val_deadline_t deadline;
 
-  int timeout = TIMEOUT_LARGE;
-  if (index > g_pe_info_table->header.num_of_pe) {
-      val_print(ERROR, "\n       Input Index exceeds Num of PE %x", index);
-      val_report_status(index, RESULT_FAIL(0xFF), NULL);
-      return;
-  }
+  /* Set the TEST function pointer in a shared memory location. This location is
+     read by the Secondary PE (val_test_entry()) and executes the test. */
+  val_set_test_data(index, (uint64_t)payload, test_input);
+#ifndef TARGET_LINUX
+  /* The PE parks in the worker pool once the payload returns */
+  val_pe_pool_set_state(index, PE_POOL_RUNNING);
+#endif
 
+  /* A PE that is still switching itself off reports ALREADY_ON, retry */
+  val_deadline_start(&deadline, TIMEOUT_LARGE_US);
   do {
-      g_smc_args.Arg0 = ARM_SMC_ID_PSCI_CPU_ON_AARCH64;
+      smc_args.Arg0 = ARM_SMC_ID_PSCI_CPU_ON_AARCH64;
+      smc_args.Arg1 = val_pe_get_mpid_index(index);
+      pal_pe_execute_payload(&smc_args);
+  } while (smc_args.Arg0 == (uint64_t)ARM_SMC_PSCI_RET_ALREADY_ON &&
+           !val_deadline_expired(&deadline));
 
-      /* Set the TEST function pointer in a shared memory location. This location is
-         read by the Secondary PE (val_test_entry()) and executes the test. */
-      g_smc_args.Arg1 = val_pe_get_mpid_index(index);
+#ifndef TARGET_LINUX
+  if (smc_args.Arg0 != 0)
+      val_pe_pool_set_state(index, PE_POOL_OFF);
+#endif
+
+  return (int64_t)smc_args.Arg0;
+}
 
-      val_set_test_data(index, (uint64_t)payload, test_input);
-      pal_pe_execute_payload(&g_smc_args);
+/**
+  @brief   This API initiates the execution of a test on a secondary PE and
+           reports whether the PE was woken. On failure the status of the
+           PE is set as val_execute_on_pe() always did.
+           The PSCI arguments are local so that PEs relaying a wake-up tree
+           (val_run_test_payload) can issue CPU_ON concurrently.
+           1. Caller       -  VAL
+           2. Prerequisite -  val_create_peinfo_table
+  @param   index - Index of the PE to be woken up
+  @param   payload - Function pointer of the test to be executed on the PE
+  @param   test_input - arguments to be passed to the test.
+  @return  ACS_STATUS_PASS if the PE runs the payload, ACS_STATUS_SKIP if it
+           was already on, ACS_STATUS_FAIL otherwise
+**/
+uint32_t
+val_pe_wake(uint32_t index, void (*payload)(void), uint64_t test_input)
+{
+  int64_t ret = ARM_SMC_PSCI_RET_ALREADY_ON;
+  uint32_t status = ACS_STATUS_SKIP;
 
-  } while (g_smc_args.Arg0 == (uint64_t)ARM_SMC_PSCI_RET_ALREADY_ON && timeout--);
+  if (index >= g_pe_info_table->header.num_of_pe) {
+      val_print(ERROR, "\n       Input Index exceeds Num of PE %x", index);
+      val_report_status(index, RESULT_FAIL(0xFF), NULL);
+      return ACS_STATUS_FAIL;
+  }
 
-  if (g_smc_args.Arg0 == (uint64_t)ARM_SMC_PSCI_RET_ALREADY_ON) {
+#ifndef TARGET_LINUX
+  /* A pooled PE takes the payload from its mailbox, no PSCI call needed */
+  status = val_pe_pool_dispatch(index, payload, test_input);
+  if (status == ACS_STATUS_PASS)
+      return ACS_STATUS_PASS;
+#endif
+
+  /* A pooled PE still running its previous payload is reported as already on */
+  if (status == ACS_STATUS_SKIP)
+      ret = val_pe_wake_psci(index, payload, test_input);
+
+  if (ret == ARM_SMC_PSCI_RET_ALREADY_ON) {
       val_print(ERROR, "\n       PSCI_CPU_ON: cpu already on");
       val_print(WARN, "\n       WARNING: Skipping test for PE index %d "
                               "since it is already on\n", index);
 
-      val_set_status(index, RESULT_SKIP(0x120 - (int)g_smc_args.Arg0));
-      return;
+      val_set_status(index, RESULT_SKIP(0x120 - (int)ret));
+      return ACS_STATUS_SKIP;
   }
   else {
-      if(g_smc_args.Arg0 == 0) {
+      if(ret == 0) {
           val_print(TRACE, "\n       PSCI_CPU_ON: success");
-          return;
+          return ACS_STATUS_PASS;
       }
       else
-          val_print(ERROR, "\n       PSCI_CPU_ON: failure[%d]", g_smc_args.Arg0);
+          val_print(ERROR, "\n       PSCI_CPU_ON: failure[%d]", ret);
+
+  }
+  val_set_status(index, RESULT_FAIL(0x120 - (int)ret));
+  return ACS_STATUS_FAIL;
+}
+
+/**
+  @brief   This API initiates the execution of a test on a secondary PE.
+           Uses PSCI_CPU_ON to wake a secondary PE
+           1. Caller       -  Test Suite
+           2. Prerequisite -  val_create_peinfo_table
+  @param   index - Index of the PE to be woken up
+  @param   payload - Function pointer of the test to be executed on the PE
+  @param   test_input - arguments to be passed to the test.
+  @return  None
+**/
+void
+val_execute_on_pe(uint32_t index, void (*payload)(void), uint64_t test_input)
+{
+  if (val_pe_wake(index, payload, test_input) == ACS_STATUS_PASS)
+      acs_get_activity_counters()->pe_wakeups++;
+}
+
+#ifndef TARGET_LINUX
+#define PE_SCTLR_M  (1ULL << 0)
+#define PE_SCTLR_C  (1ULL << 2)
+
+#define PE_ISAR0_ATOMIC_SHIFT   20
+#define PE_ISAR0_ATOMIC_MASK    0xF
+#define PE_ISAR0_ATOMIC_LSE     2
+
+#define PE_LSE_UNKNOWN          0
+#define PE_LSE_ABSENT           1
+#define PE_LSE_PRESENT          2
+
+/* All PEs compute the same value, so a race on the first use is harmless */
+static volatile uint32_t g_pe_lse;
+
+/**
+  @brief   Tell whether exclusive accesses can be used on the calling PE. With
+           the MMU or the data cache off all memory is Device or Non-cacheable,
+           where an exclusive store may never succeed. This is the case before
+           the apps enable the MMU, and for the whole run of an
+           ACS_ENABLE_MMU=0 build.
+  @return  1 if the MMU and the data cache are on, 0 otherwise
+**/
+static uint32_t
+pe_exclusives_usable(void)
+{
+  uint64_t sctlr = (get_current_el() == 2) ? read_sctlr_el2() : read_sctlr_el1();
+
+  return (sctlr & (PE_SCTLR_M | PE_SCTLR_C)) == (PE_SCTLR_M | PE_SCTLR_C);
+}
+#endif
+
+/**
+  @brief   This API tells whether the PE implements the Armv8.1 LSE atomic
+           instructions, from ID_AA64ISAR0_EL1.Atomic.
+           1. Caller       -  VAL
+           2. Prerequisite -  None
+  @return  true if LSE atomics can be used
+**/
+bool
+val_pe_has_lse_atomics(void)
+{
+#ifndef TARGET_LINUX
+  if (g_pe_lse == PE_LSE_UNKNOWN)
+      g_pe_lse = (((read_id_aa64isar0_el1() >> PE_ISAR0_ATOMIC_SHIFT) &
+                   PE_ISAR0_ATOMIC_MASK) >= PE_ISAR0_ATOMIC_LSE) ?
+                 PE_LSE_PRESENT : PE_LSE_ABSENT;
+
+  return g_pe_lse == PE_LSE_PRESENT;
+#else
+  return false;
+#endif
+}
+
+/**
+  @brief   This API atomically adds a value to a 32-bit word shared between PEs,
+           with acquire and release semantics. Uses LDADDAL when LSE atomics
+           are implemented, an exclusive loop otherwise. While the MMU or the
+           data cache is off on the calling PE it is a plain add.
+           1. Caller       -  VAL
+           2. Prerequisite -  None
+  @param   addr  - Address of the shared word
+  @param   value - Value to add
+  @return  Value of the word before the add
+**/
+uint32_t
+val_pe_atomic_add(volatile uint32_t *addr, uint32_t value)
+{
+#ifndef TARGET_LINUX
+  uint32_t old, tmp, fail;
+
+  if (!pe_exclusives_usable()) {
+      old = *addr;
+      *addr = old + value;
+      return old;
+  }
 
+  if (val_pe_has_lse_atomics()) {
+      __asm__ volatile(
+          ".arch_extension lse\n"
+          "ldaddal %w1, %w0, [%2]\n"
+          : "=r"(old)
+          : "r"(value), "r"(addr)
+          : "memory");
+      return old;
   }
-  val_set_status(index, RESULT_FAIL(0x120 - (int)g_smc_args.Arg0));
+
+  __asm__ volatile(
+      "1: ldaxr %w0, [%3]\n"
+      "   add   %w1, %w0, %w4\n"
+      "   stlxr %w2, %w1, [%3]\n"
+      "   cbnz  %w2, 1b\n"
+      : "=&r"(old), "=&r"(tmp), "=&r"(fail)
+      : "r"(addr), "r"(value)
+      : "memory");
+
+  return old;
+#else
+  uint32_t old = *addr;
+
+  *addr = old + value;
+  return old;
+#endif
+}
+
+/**
+  @brief   This API acquires a spin lock shared between PEs. While the MMU or
+           the data cache is off on the calling PE the lock word is only set,
+           callers are then serialized no more than they were without it.
+           1. Caller       -  VAL
+           2. Prerequisite -  None
+  @param   lock - Address of the lock word, 0 when free
+  @return  None
+**/
+void
+val_pe_spin_lock(volatile uint32_t *lock)
+{
+#ifndef TARGET_LINUX
+  uint32_t tmp, fail;
+
+  if (!pe_exclusives_usable()) {
+      *lock = 1;
+      return;
+  }
+
+  __asm__ volatile(
+      "1: ldaxr %w0, [%2]\n"
+      "   cbnz  %w0, 1b\n"
+      "   stxr  %w1, %w3, [%2]\n"
+      "   cbnz  %w1, 1b\n"
+      : "=&r"(tmp), "=&r"(fail)
+      : "r"(lock), "r"(1)
+      : "memory");
+#else
+  *lock = 1;
+#endif
+}
+
+/**
+  @brief   This API releases a spin lock taken with val_pe_spin_lock.
+           1. Caller       -  VAL
+           2. Prerequisite -  val_pe_spin_lock
+  @param   lock - Address of the lock word
+  @return  None
+**/
+void
+val_pe_spin_unlock(volatile uint32_t *lock)
+{
+#ifndef TARGET_LINUX
+  __asm__ volatile("stlr wzr, [%0]\n" : : "r"(lock) : "memory");
+#else
+  *lock = 0;
+#endif
 }
 
 /**
@@ -406,6 +1052,9 @@ val_pe_default_esr(uint64_t interrupt_type, void *context)
       val_print(WARN, "\n        FAR reported = 0x%llx", val_pe_get_far(context));
       val_print(WARN, "\n        ESR reported = 0x%llx", val_pe_get_esr(context));
     }
+
+    /* Get the report out in case the handler does not return */
+    pal_print_flush();
 #endif
 
     val_set_status(index, RESULT_FAIL(1));
@@ -401,6 +401,8 @@ uint64_t val_pgt_ioremap_attr(pgt_descriptor_t pgt_desc,
     if (flag) {
        /*Adding to list to revert back the attribute during unmap*/
        IOREMMAP_LIST *lst = val_memory_alloc(sizeof(IOREMMAP_LIST));
+       /* Freed by val_memory_unmap(), which may come in a later rule */
+       val_memory_scope_keep(lst);
        lst->next = ioremmap_list;
        lst->phy_addr = addr;
        lst->vir_addr = va;
@@ -505,6 +507,8 @@ uint32_t fill_translation_table(tt_descriptor_t tt_desc, memory_region_descripto
                 "\n       fill_translation_table: page allocation failed");
                 return ACS_STATUS_ERR;
             }
+            /* Live as long as the mapping, not the rule that created it */
+            val_memory_scope_keep(tt_base_next_level);
             val_memory_set(tt_base_next_level, page_size, 0);
 
             /* If we are splitting an existing BLOCK descriptor into a TABLE,
@@ -632,6 +636,8 @@ uint32_t val_pgt_create(memory_region_descriptor_t *mem_desc, pgt_descriptor_t *
             val_print(ERROR, "\n       val_pgt_create: page allocation failed");
             return ACS_STATUS_ERR;
         }
+        /* An SMMU may still walk the table after the rule, val_pgt_destroy() frees it */
+        val_memory_scope_keep(tt_base);
         val_memory_set(tt_base, page_size, 0);
     }
     else
@@ -760,6 +766,57 @@ uint64_t val_pgt_get_attributes(pgt_descriptor_t pgt_desc, uint64_t virtual_addr
     }
 }
 
+/**
+  @brief Get the size of the block or page descriptor that maps a virtual address.
+  @param pgt_desc - page table base and translation attributes.
+  @param virtual_address - virtual address to look up.
+  @param block_size - output size in bytes, the page size for a page descriptor.
+  @return status
+**/
+uint32_t val_pgt_get_block_size(pgt_descriptor_t pgt_desc, uint64_t virtual_address,
+                                uint64_t *block_size)
+{
+    uint32_t ias, index, num_pgt_levels, this_level, level_bits;
+    uint32_t bits_at_this_level, bits_remaining;
+    uint64_t val64, tt_base_phys, *tt_base_virt;
+    uint32_t page_size_log2 = pgt_desc.tcr.tg_size_log2;
+
+    if (block_size == NULL || !pgt_desc.pgt_base || !page_size_log2)
+        return ACS_STATUS_ERR;
+
+    ias = (uint32_t)ADDR_WIDTH_64BIT - pgt_desc.tcr.tsz;
+
+    level_bits = page_size_log2 - 3;
+    num_pgt_levels = (ias - page_size_log2 + level_bits - 1)/level_bits;
+    this_level = 4 - num_pgt_levels;
+    bits_remaining = (num_pgt_levels - 1) * level_bits + page_size_log2;
+    bits_at_this_level = ias - bits_remaining;
+    tt_base_phys = pgt_desc.pgt_base;
+
+    while (1) {
+        index = (virtual_address >> bits_remaining) & ((0x1u << bits_at_this_level) - 1);
+        tt_base_virt = (uint64_t *)val_memory_phys_to_virt(tt_base_phys);
+        if (!tt_base_virt)
+            return ACS_STATUS_ERR;
+
+        val64 = tt_base_virt[index];
+        if (IS_PGT_ENTRY_INVALID(val64))
+            return ACS_STATUS_ERR;
+
+        if ((this_level == 3 && IS_PGT_ENTRY_PAGE(val64)) || IS_PGT_ENTRY_BLOCK(val64)) {
+            *block_size = 0x1ull << bits_remaining;
+            return 0;
+        }
+        if (this_level == 3)
+            return ACS_STATUS_ERR;
+
+        tt_base_phys = val64 & (((0x1ull << (ias - page_size_log2)) - 1) << page_size_log2);
+        ++this_level;
+        bits_remaining -= bits_at_this_level;
+        bits_at_this_level = level_bits;
+    }
+}
+
 /**
   @brief  This API free the translation table
 
@@ -40,6 +40,8 @@ void acs_release_run_request(acs_run_request_t *ctx)
         val_memory_free(ctx->execute_modules);
     if (ctx->skip_modules_owned && ctx->skip_modules != NULL)
         val_memory_free(ctx->skip_modules);
+    if (ctx->rule_cost_owned && ctx->rule_cost_us != NULL)
+        val_memory_free(ctx->rule_cost_us);
 
     *ctx = (acs_run_request_t){0};
 }
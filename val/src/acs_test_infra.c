@@ -22,9 +22,16 @@
 #include "pal_interface.h"
 #include "val_interface.h"
 #include "val_status.h"
+#include "acs_memory.h"
+#ifndef TARGET_LINUX
+#include "val_sysreg_timer.h"
+#endif
 
 uint32_t g_override_skip;
 static acs_test_status_counters_t g_rule_test_stats;
+static acs_activity_counters_t g_activity_stats;
+/* PEs failed by val_wait_for_test_completion() for not completing in time */
+static uint32_t g_test_timeouts;
 /**
   @brief  Print standardized log context prefix.
           1. Caller       - Application/VAL layers
@@ -172,6 +179,9 @@ val_print_acs_test_status_summary(void)
             stats->not_implemented);
   val_print(INFO, "---------------------------------\n");
 
+#if defined(COMPILE_RB_EXE) && !defined(TARGET_LINUX)
+  val_print_rule_profile(RULE_PROFILE_TOP_N);
+#endif
 }
 
 /**
@@ -207,6 +217,7 @@ val_print_raw(uint64_t uart_address, uint32_t level, char8_t *string, uint64_t d
 uint8_t
 val_mmio_read8(addr_t addr)
 {
+  g_activity_stats.mmio_accesses++;
   return pal_mmio_read8(addr);
 
 }
@@ -224,6 +235,7 @@ val_mmio_read8(addr_t addr)
 uint16_t
 val_mmio_read16(addr_t addr)
 {
+  g_activity_stats.mmio_accesses++;
   return pal_mmio_read16(addr);
 
 }
@@ -241,6 +253,7 @@ val_mmio_read16(addr_t addr)
 uint32_t
 val_mmio_read(addr_t addr)
 {
+  g_activity_stats.mmio_accesses++;
   return pal_mmio_read(addr);
 
 }
@@ -258,6 +271,7 @@ val_mmio_read(addr_t addr)
 uint64_t
 val_mmio_read64(addr_t addr)
 {
+  g_activity_stats.mmio_accesses++;
   return pal_mmio_read64(addr);
 
 }
@@ -276,7 +290,7 @@ val_mmio_read64(addr_t addr)
 void
 val_mmio_write8(addr_t addr, uint8_t data)
 {
-
+  g_activity_stats.mmio_accesses++;
   pal_mmio_write8(addr, data);
 }
 
@@ -294,7 +308,7 @@ val_mmio_write8(addr_t addr, uint8_t data)
 void
 val_mmio_write16(addr_t addr, uint16_t data)
 {
-
+  g_activity_stats.mmio_accesses++;
   pal_mmio_write16(addr, data);
 }
 
@@ -312,7 +326,7 @@ val_mmio_write16(addr_t addr, uint16_t data)
 void
 val_mmio_write(addr_t addr, uint32_t data)
 {
-
+  g_activity_stats.mmio_accesses++;
   pal_mmio_write(addr, data);
 }
 /**
@@ -329,7 +343,7 @@ val_mmio_write(addr_t addr, uint32_t data)
 void
 val_mmio_write64(addr_t addr, uint64_t data)
 {
-
+  g_activity_stats.mmio_accesses++;
   pal_mmio_write64(addr, data);
 }
 
@@ -462,8 +476,40 @@ val_initialize_test(uint32_t test_num, char8_t *desc, uint32_t num_pe)
 }
 #endif /* COMPILE_RB_EXE */
 
+/* Line-aligned base and per-PE stride of the shared mailbox array */
+static uintptr_t g_shared_mem_base;
+static uint32_t  g_shared_mem_stride;
+
 /**
-  @brief  Allocate memory which is to be shared across PEs
+  @brief  Returns the cache writeback granule of the PE from CTR_EL0.CWG,
+          the DminLine size when CWG is not reported.
+
+  @param  None
+
+  @result Granule size in bytes
+**/
+static uint32_t
+val_shared_mem_granule(void)
+{
+#ifndef TARGET_LINUX
+  uint64_t ctr = val_pe_reg_read(CTR_EL0);
+  uint32_t cwg = (ctr >> 24) & 0xf;
+
+  if (cwg != 0)
+      return 4U << cwg;
+
+  return 4U << ((ctr >> 16) & 0xf);
+#else
+  return 64;
+#endif
+}
+
+/**
+  @brief  Allocate memory which is to be shared across PEs.
+          Each PE gets a mailbox in its own cache writeback granule, so that
+          cache maintenance on one mailbox never touches a neighbour's entry,
+          and the mailboxes form one array that can be invalidated with a
+          single ranged operation.
 
   @param  None
 
@@ -473,23 +519,63 @@ void
 val_allocate_shared_mem()
 {
   uint32_t num_pe = val_pe_get_num();
+  uint32_t granule = val_shared_mem_granule();
+  uint32_t stride;
+  uintptr_t base;
+
+  stride = (sizeof(VAL_SHARED_MEM_t) + granule - 1) & ~(granule - 1);
 
-  uint32_t total_size =
-        (num_pe * sizeof(VAL_SHARED_MEM_t)) +
-        (num_pe * sizeof(val_test_status_t));
+  /* One extra granule to align the base of the array */
+  pal_mem_allocate_shared(1, (num_pe * stride) + granule);
 
-  pal_mem_allocate_shared(1, total_size);
+  base = (uintptr_t)pal_mem_get_shared_addr();
+  if (base == 0) {
+      g_shared_mem_base = 0;
+      return;
+  }
 
+  g_shared_mem_base = (base + granule - 1) & ~(uintptr_t)(granule - 1);
+  g_shared_mem_stride = stride;
+  val_memory_set((void *)g_shared_mem_base, num_pe * stride, 0);
+  val_pe_cache_clean_invalidate_range(g_shared_mem_base, num_pe * stride);
+
+  val_data_cache_ops_by_va((addr_t)&g_shared_mem_base, CLEAN_AND_INVALIDATE);
+  val_data_cache_ops_by_va((addr_t)&g_shared_mem_stride, CLEAN_AND_INVALIDATE);
 }
 
-uintptr_t val_get_status_region_base(void)
+/**
+  @brief  Returns the shared mailbox of a PE.
+          1. Caller       - VAL
+          2. Prerequisite - val_allocate_shared_mem
+
+  @param  index  PE index
+
+  @result Mailbox of the PE
+**/
+volatile VAL_SHARED_MEM_t *
+val_shared_mem_entry(uint32_t index)
 {
-    uintptr_t base = (uintptr_t)pal_mem_get_shared_addr();
-    uint32_t npe = val_pe_get_num();
+  return (volatile VAL_SHARED_MEM_t *)(g_shared_mem_base +
+                                       ((uintptr_t)index * g_shared_mem_stride));
+}
+
+/**
+  @brief  Cleans and invalidates the shared mailboxes of all PEs with one
+          ranged operation, for a reader about to scan them. A mailbox is
+          written by its PE and by the PEs that wake it, so a plain
+          invalidate could discard a store that is not cleaned yet.
+          1. Caller       - VAL
+          2. Prerequisite - val_allocate_shared_mem
+
+  @param  None
 
-    /* Status region starts after ACS data region */
-    base += (uintptr_t)(npe * sizeof(VAL_SHARED_MEM_t));
-    return base;
+  @result None
+**/
+void
+val_shared_mem_sync_all(void)
+{
+  val_pe_cache_clean_invalidate_range(g_shared_mem_base,
+                                      (uint64_t)val_pe_get_num() * g_shared_mem_stride);
 }
 
 /**
@@ -506,12 +592,14 @@ val_free_shared_mem()
 {
 
   pal_mem_free_shared();
+  g_shared_mem_base = 0;
 }
 
 /**
   @brief  This function sets the address of the test entry and the test
           argument to the shared address space which is picked up by the
-          secondary PE identified by index.
+          secondary PE identified by index. The sequence number of the
+          mailbox is bumped so the PE can tell a new payload from the last.
           1. Caller       - VAL
           2. Prerequisite - val_allocate_shared_mem
 
@@ -526,20 +614,19 @@ val_set_test_data(uint32_t index, uint64_t addr, uint64_t test_data)
 {
   volatile VAL_SHARED_MEM_t *mem;
 
-  if(index > val_pe_get_num())
+  if(index >= val_pe_get_num())
   {
       val_print(ERROR, "\n Incorrect PE index = %d", index);
       return;
   }
 
-  mem = (VAL_SHARED_MEM_t *)pal_mem_get_shared_addr();
-  mem = mem + index;
+  mem = val_shared_mem_entry(index);
 
   mem->data0 = addr;
   mem->data1 = test_data;
+  mem->seq++;
 
-  val_data_cache_ops_by_va((addr_t)&mem->data0, CLEAN_AND_INVALIDATE);
-  val_data_cache_ops_by_va((addr_t)&mem->data1, CLEAN_AND_INVALIDATE);
+  val_data_cache_ops_by_va((addr_t)mem, CLEAN_AND_INVALIDATE);
 }
 
 /**
@@ -561,41 +648,300 @@ val_get_test_data(uint32_t index, uint64_t *data0, uint64_t *data1)
 
   volatile VAL_SHARED_MEM_t *mem;
 
-  if(index > val_pe_get_num())
+  if(index >= val_pe_get_num())
   {
       val_print(ERROR, "\n Incorrect PE index = %d", index);
       return;
   }
 
-  mem = (VAL_SHARED_MEM_t *) pal_mem_get_shared_addr();
-  mem = mem + index;
+  mem = val_shared_mem_entry(index);
 
-  val_data_cache_ops_by_va((addr_t)&mem->data0, INVALIDATE);
-  val_data_cache_ops_by_va((addr_t)&mem->data1, INVALIDATE);
+  val_data_cache_ops_by_va((addr_t)mem, CLEAN_AND_INVALIDATE);
 
   *data0 = mem->data0;
   *data1 = mem->data1;
 
 }
 
+/**
+  @brief  This API returns the sequence number of the mailbox of a PE,
+          bumped by every val_set_test_data.
+          1. Caller       - VAL
+          2. Prerequisite - val_allocate_shared_mem
+
+  @param index   PE index
+
+  @return    Sequence number
+ **/
+uint32_t
+val_get_test_data_seq(uint32_t index)
+{
+  volatile VAL_SHARED_MEM_t *mem = val_shared_mem_entry(index);
+
+  val_data_cache_ops_by_va((addr_t)mem, CLEAN_AND_INVALIDATE);
+  return mem->seq;
+}
+
+/* Longest wait between two checks of a deadline, bounds how late a
+   condition that became true is noticed */
+#define VAL_DEADLINE_BACKOFF_MAX_US  64
+
+#ifdef TARGET_LINUX
+/* Time charged per check of a deadline, the Linux build has no counter
+   access and counts checks instead */
+#define VAL_DEADLINE_NS_PER_CHECK    100
+#endif
+
+/**
+  @brief  Starts a deadline on the generic timer. The wait budget is scaled
+          by the timeout_scale of the execution policy, so that a timeout
+          means the same time on every platform. Use with:
+
+            val_deadline_start(&deadline, TIMEOUT_LARGE_US);
+            while (!val_deadline_expired(&deadline) && <condition>)
+                ;
+            if (val_deadline_timed_out(&deadline))
+                <timeout handling>
+
+  @param deadline    Deadline to start
+  @param timeout_us  Wait budget in microseconds
+
+  @return None
+ **/
+void
+val_deadline_start(val_deadline_t *deadline, uint64_t timeout_us)
+{
+  uint32_t scale = acs_policy_get_timeout_scale();
+#ifndef TARGET_LINUX
+  uint64_t freq;
+  uint64_t ticks;
+#endif
+
+  if (scale == 0)
+      scale = TIMEOUT_SCALE_DEFAULT;
+  timeout_us = (timeout_us * scale) / 100;
+
+  deadline->expired = 0;
+  deadline->backoff = 0;
+
+#ifndef TARGET_LINUX
+  freq = read_cntfrq_el0();
+  ticks = (timeout_us / 1000000) * freq + ((timeout_us % 1000000) * freq) / 1000000;
+
+  deadline->end = virtualcounter_read() + ticks;
+  deadline->backoff_max = (VAL_DEADLINE_BACKOFF_MAX_US * freq) / 1000000;
+  /* Keep the backoff small against short budgets */
+  if (deadline->backoff_max > ticks / 16)
+      deadline->backoff_max = ticks / 16;
+#else
+  deadline->end = (timeout_us * 1000) / VAL_DEADLINE_NS_PER_CHECK;
+  deadline->backoff_max = 0;
+#endif
+}
+
+/**
+  @brief  Checks a deadline started with val_deadline_start. While the
+          deadline has not expired, each check waits for an exponentially
+          growing number of counter ticks, up to VAL_DEADLINE_BACKOFF_MAX_US,
+          so that long waits do not keep hammering the polled location.
+          Once expired, the deadline stays expired.
+
+  @param deadline  Deadline to check
+
+  @return true if the deadline expired
+ **/
+bool
+val_deadline_expired(val_deadline_t *deadline)
+{
+#ifndef TARGET_LINUX
+  uint64_t now;
+  uint64_t wait_end;
+
+  if (deadline->expired)
+      return 1;
+
+  now = virtualcounter_read();
+  if (now >= deadline->end) {
+      deadline->expired = 1;
+      return 1;
+  }
+
+  if (deadline->backoff != 0) {
+      wait_end = now + deadline->backoff;
+      if (wait_end > deadline->end)
+          wait_end = deadline->end;
+      while (virtualcounter_read() < wait_end)
+          ;
+  }
+
+  /* The first check does not wait, then 1, 2, 4.. ticks */
+  if (deadline->backoff == 0)
+      deadline->backoff = 1;
+  else if (deadline->backoff < deadline->backoff_max)
+      deadline->backoff *= 2;
+  if (deadline->backoff > deadline->backoff_max)
+      deadline->backoff = deadline->backoff_max;
+#else
+  if (deadline->expired)
+      return 1;
+
+  if (deadline->end == 0) {
+      deadline->expired = 1;
+      return 1;
+  }
+  deadline->end--;
+#endif
+
+  return 0;
+}
+
+/**
+  @brief  Waits in WFE for the next event, for waits on a condition that is
+          signalled with SEV. The caller enables the timer event stream so
+          that an expiry is noticed without an event.
+
+  @param deadline  Deadline of the wait
+
+  @return true if the deadline expired
+ **/
+bool
+val_deadline_wait_event(val_deadline_t *deadline)
+{
+#ifndef TARGET_LINUX
+  if (deadline->expired)
+      return 1;
+
+  if (virtualcounter_read() >= deadline->end) {
+      deadline->expired = 1;
+      return 1;
+  }
+
+  wfe();
+  return 0;
+#else
+  return val_deadline_expired(deadline);
+#endif
+}
+
+/**
+  @brief  Tells whether a wait ended because its deadline expired. Unlike
+          val_deadline_expired, does not check the time again, so a
+          condition met just before the deadline is not taken as a timeout.
+
+  @param deadline  Deadline of the wait
+
+  @return true if val_deadline_expired reported the deadline as expired
+ **/
+bool
+val_deadline_timed_out(const val_deadline_t *deadline)
+{
+  return deadline->expired;
+}
+
+/**
+  @brief  Waits for a scaled number of microseconds on the generic timer.
+          Replaces the empty TIMEOUT_SMALL/MEDIUM/LARGE spin loops.
+
+  @param timeout_us  Time to wait in microseconds, scaled as for
+                     val_deadline_start
+
+  @return None
+ **/
+void
+val_deadline_wait_us(uint64_t timeout_us)
+{
+  val_deadline_t deadline;
+
+  val_deadline_start(&deadline, timeout_us);
+  while (!val_deadline_expired(&deadline))
+      ;
+}
+
+#ifndef TARGET_LINUX
+/* Counter bit whose transitions generate the WFE event stream, about every
+   2^(n+1) ticks. Bounds how late a waiting PE notices its deadline. */
+#define VAL_WAIT_EVENT_STREAM_BIT   9
+#define CNTXCTL_EVNTEN              (1U << 2)
+#define CNTXCTL_EVNTDIR             (1U << 3)
+#define CNTXCTL_EVNTI_SHIFT         4
+#define CNTXCTL_EVNTI_MASK          (0xFU << CNTXCTL_EVNTI_SHIFT)
+
+/**
+  @brief  Enables the generic timer event stream of the current EL so that a
+          PE waiting in WFE also wakes up periodically.
+
+  @param  None
+
+  @return Previous value of the timer control register, to restore
+ **/
+uint64_t
+val_wait_event_stream_enable(void)
+{
+  uint64_t ctl;
+  uint64_t evnt;
+
+  evnt = CNTXCTL_EVNTEN | ((uint64_t)VAL_WAIT_EVENT_STREAM_BIT << CNTXCTL_EVNTI_SHIFT);
+
+  if (get_current_el() == 2) {
+      ctl = read_cnthctl_el2();
+      write_cnthctl_el2((ctl & ~(uint64_t)(CNTXCTL_EVNTI_MASK | CNTXCTL_EVNTDIR)) | evnt);
+  } else {
+      ctl = read_cntkctl_el1();
+      write_cntkctl_el1((ctl & ~(uint64_t)(CNTXCTL_EVNTI_MASK | CNTXCTL_EVNTDIR)) | evnt);
+  }
+  isb();
+
+  return ctl;
+}
+
+/**
+  @brief  Restores the timer control register changed by
+          val_wait_event_stream_enable.
+
+  @param  ctl  Value returned by val_wait_event_stream_enable
+
+  @return None
+ **/
+void
+val_wait_event_stream_restore(uint64_t ctl)
+{
+  if (get_current_el() == 2)
+      write_cnthctl_el2(ctl);
+  else
+      write_cntkctl_el1(ctl);
+  isb();
+}
+#endif
+
 /**
   @brief  This function will wait for all PEs to report their status
-          or we timeout and set a failure for the PE which timed-out
+          or we timeout and set a failure for every PE which timed-out.
+          The PE sleeps in WFE between completions: every result stored by
+          val_set_status() bumps a completion sequence and issues SEV, and
+          the status records are only scanned again when it moved.
           1. Caller       - Application layer
           2. Prerequisite - val_set_status
 
-  @param test_num  Unique test number
-  @param num_pe    Number of PE who are executing this test
-  @param timeout   integer value ob expiry the API will timeout and return
+  @param test_num    Unique test number
+  @param num_pe      Number of PE who are executing this test
+  @param timeout_us  Wait budget per PE in microseconds
 
   @return        None
  **/
 
 static void
-val_wait_for_test_completion(uint32_t test_num, uint32_t num_pe, uint32_t timeout)
+val_wait_for_test_completion(uint32_t test_num, uint32_t num_pe, uint64_t timeout_us)
 {
 
-  uint32_t i = 0, j = 0;
+  val_deadline_t deadline;
+  uint32_t i = 0;
+#ifndef TARGET_LINUX
+  uint32_t first = 0;
+  uint32_t seq;
+  uint64_t ctl;
+#else
+  uint32_t j = 0;
+#endif
 
   val_print(TRACE, "\n       Test_num= %d", test_num);
 
@@ -603,7 +949,42 @@ val_wait_for_test_completion(uint32_t test_num, uint32_t num_pe, uint32_t timeou
   if (num_pe == 1)
       return;
 
-  while(--timeout)
+  val_deadline_start(&deadline, timeout_us * num_pe);
+
+#ifndef TARGET_LINUX
+  ctl = val_wait_event_stream_enable();
+
+  while (1) {
+      /* Read before the scan so a completion during the scan is not missed */
+      seq = val_status_get_done_seq();
+
+      /* PEs below first already completed, resume the scan from there */
+      val_shared_mem_sync_all();
+      while (first < num_pe && !IS_RESULT_PENDING(val_get_status_nosync(first)))
+          first++;
+      if (first == num_pe)
+          break;
+
+      /* Sleep until a PE completes or the event stream ticks */
+      while (val_status_get_done_seq() == seq && !val_deadline_wait_event(&deadline))
+          ;
+
+      if (val_deadline_timed_out(&deadline))
+          break;
+  }
+
+  val_wait_event_stream_restore(ctl);
+
+  //We are here if we timed-out, fail every PE that did not complete
+  for (i = first; i < num_pe; i++) {
+      if (IS_RESULT_PENDING(val_get_status(i))) {
+          val_print(ERROR, "\n       PE index %d did not complete the test", i);
+          val_set_status(i, RESULT_FAIL(0xF));
+          g_test_timeouts++;
+      }
+  }
+#else
+  while (!val_deadline_expired(&deadline))
   {
       j = 0;
       for (i = 0; i < num_pe; i++)
@@ -618,10 +999,201 @@ val_wait_for_test_completion(uint32_t test_num, uint32_t num_pe, uint32_t timeou
   }
   //We are here if we timed-out, set the last index PE as failed
   val_set_status(j-1, RESULT_FAIL(0xF));
+  g_test_timeouts++;
+#endif
+}
+
+/**
+  @brief  Returns the number of PEs that did not complete a test in time,
+          over the run. A PE that timed out may still be running its payload
+          and using the buffers of the test.
+          1. Caller       - Rule orchestrator
+
+  @param  None
+
+  @return Count of timed-out PEs
+ **/
+uint32_t
+val_get_test_timeouts(void)
+{
+  return g_test_timeouts;
+}
+
+#ifndef TARGET_LINUX
+/* PEs woken by each PE of the wake-up tree, and the PE count from which the
+   tree is used. Below it the primary PE wakes every PE itself. */
+#ifndef VAL_WAKE_TREE_FANOUT
+#define VAL_WAKE_TREE_FANOUT   4
+#endif
+#ifndef VAL_WAKE_TREE_MIN_PE
+#define VAL_WAKE_TREE_MIN_PE   8
+#endif
+
+/*
+ * Wake-up tree of val_run_test_payload(). order[0] is the primary PE, and the
+ * PE at position p wakes the PEs at positions p * FANOUT + 1 .. p * FANOUT +
+ * FANOUT before it runs the payload. PEs are ordered by cluster, so siblings
+ * of the tree mostly share a cluster.
+ */
+typedef struct {
+  uint64_t           payload;
+  uint64_t           test_input;
+  uint32_t           num;          /* PEs in order[] */
+  uint32_t           num_pe;       /* num_pe the order was built for */
+  uint32_t           primary;      /* primary PE index the order was built for */
+  volatile uint32_t  woken;        /* wake-ups issued by the tree */
+  uint32_t          *order;
+} val_wake_tree_t;
+
+static val_wake_tree_t g_wake_tree;
+
+/**
+  @brief  Builds the wake-up order of the PEs 0..num_pe-1 for the wake-up
+          tree, the primary PE first and the others sorted by cluster key
+          and MPIDR. The order is kept for later payloads.
+
+  @param num_pe    The number of PEs to run the test on
+  @param my_index  Index of the primary PE
+
+  @return ACS_STATUS_PASS, or ACS_STATUS_ERR if out of memory
+ **/
+static uint32_t
+val_wake_tree_build(uint32_t num_pe, uint32_t my_index)
+{
+  val_wake_tree_t *tree = &g_wake_tree;
+  uint64_t *key;
+  uint64_t cur_key;
+  uint32_t cur;
+  uint32_t count = 0;
+  uint32_t i;
+  uint32_t j;
+
+  if (tree->order != NULL && tree->num_pe == num_pe && tree->primary == my_index)
+      return ACS_STATUS_PASS;
+
+  if (tree->order != NULL) {
+      val_memory_free(tree->order);
+      tree->order = NULL;
+  }
+
+  tree->order = val_memory_alloc((num_pe + 1) * sizeof(uint32_t));
+  key = val_memory_alloc((num_pe + 1) * sizeof(uint64_t));
+  if (tree->order == NULL || key == NULL) {
+      if (tree->order != NULL)
+          val_memory_free(tree->order);
+      if (key != NULL)
+          val_memory_free(key);
+      tree->order = NULL;
+      return ACS_STATUS_ERR;
+  }
+  /* Built once per run, possibly by the first rule that wakes the PEs */
+  val_memory_scope_keep(tree->order);
+
+  tree->order[count++] = my_index;
+  for (i = 0; i < num_pe; i++) {
+      if (i == my_index)
+          continue;
+
+      /* Insertion sort on (cluster key, MPIDR), built once per run */
+      cur = i;
+      cur_key = val_pe_get_cluster_key(i);
+      for (j = count; j > 1; j--) {
+          if (key[j - 1] < cur_key ||
+              (key[j - 1] == cur_key &&
+               val_pe_get_mpid_index(tree->order[j - 1]) < val_pe_get_mpid_index(cur)))
+              break;
+          tree->order[j] = tree->order[j - 1];
+          key[j] = key[j - 1];
+      }
+      tree->order[j] = cur;
+      key[j] = cur_key;
+      count++;
+  }
+
+  val_memory_free(key);
+
+  tree->num = count;
+  tree->num_pe = num_pe;
+  tree->primary = my_index;
+  val_pe_cache_clean_invalidate_range((uint64_t)(uintptr_t)tree->order,
+                                      count * sizeof(uint32_t));
+  return ACS_STATUS_PASS;
+}
+
+static void val_wake_tree_relay(uint64_t pos);
+
+/**
+  @brief  Wakes the children of a position of the wake-up tree. If a child
+          cannot be woken, its own children are woken from here instead, so
+          that one PE failing to start does not hold back its subtree.
+          The subtree is walked in place, without recursion, since relays
+          run on the small stacks of secondary PEs.
+
+  @param tree  Wake-up tree
+  @param pos   Position in the tree of the PE whose children are woken
+
+  @return None
+ **/
+static void
+val_wake_tree_wake_children(val_wake_tree_t *tree, uint32_t pos)
+{
+  uint32_t cur = (pos * VAL_WAKE_TREE_FANOUT) + 1;
+
+  /* Preorder walk below pos, descending only below PEs that failed to wake */
+  while (cur != pos) {
+      if (cur < tree->num) {
+          if (val_pe_wake(tree->order[cur], (void (*)(void))val_wake_tree_relay, cur) ==
+              ACS_STATUS_PASS) {
+              val_pe_atomic_add(&tree->woken, 1);
+          } else if ((cur * VAL_WAKE_TREE_FANOUT) + 1 < tree->num) {
+              cur = (cur * VAL_WAKE_TREE_FANOUT) + 1;
+              continue;
+          }
+      }
+
+      /* Climb past last children, then move on to the next sibling */
+      while (cur != pos && ((cur % VAL_WAKE_TREE_FANOUT) == 0 || cur + 1 >= tree->num))
+          cur = (cur - 1) / VAL_WAKE_TREE_FANOUT;
+      if (cur != pos)
+          cur++;
+  }
+}
+
+/**
+  @brief  Payload run on each PE of the wake-up tree: wakes the subtree of the
+          PE, then restores the test data of the PE and runs the test payload.
+
+  @param pos  Position of the PE in the wake-up tree
+
+  @return None
+ **/
+static void
+val_wake_tree_relay(uint64_t pos)
+{
+  val_wake_tree_t *tree = &g_wake_tree;
+  uint32_t index;
+
+  /* woken is updated by other relays, clean it rather than discard it */
+  val_pe_cache_clean_invalidate_range((uint64_t)(uintptr_t)tree, sizeof(*tree));
+  val_pe_cache_invalidate_range((uint64_t)(uintptr_t)tree->order,
+                                tree->num * sizeof(uint32_t));
+
+  val_wake_tree_wake_children(tree, (uint32_t)pos);
+
+  /* The payload reads its own test data, as when woken directly. The pool
+     park loop takes the sequence again once the payload returns. */
+  index = tree->order[pos];
+  val_set_test_data(index, tree->payload, tree->test_input);
+  ((void (*)(uint64_t))tree->payload)(tree->test_input);
 }
+#endif
 
 /**
-  @brief  This API Executes the payload function on secondary PEs
+  @brief  This API Executes the payload function on secondary PEs.
+          From VAL_WAKE_TREE_MIN_PE PEs, the secondary PEs are woken through a
+          tree in which each woken PE wakes up to VAL_WAKE_TREE_FANOUT more
+          before running the payload, so the start-up takes O(log N)
+          sequential PSCI calls instead of O(N).
           1. Caller       - Application layer
           2. Prerequisite - val_pe_create_info_table
 
@@ -643,13 +1215,30 @@ val_run_test_payload(uint32_t test_num, uint32_t num_pe, void (*payload)(void),
   if (num_pe == 1)
       return;
 
+#ifndef TARGET_LINUX
+  if (num_pe >= VAL_WAKE_TREE_MIN_PE && val_wake_tree_build(num_pe, my_index) == ACS_STATUS_PASS) {
+      g_wake_tree.payload = (uint64_t)payload;
+      g_wake_tree.test_input = test_input;
+      g_wake_tree.woken = 0;
+      val_pe_cache_clean_invalidate_range((uint64_t)(uintptr_t)&g_wake_tree, sizeof(g_wake_tree));
+
+      val_wake_tree_wake_children(&g_wake_tree, 0);
+      val_wait_for_test_completion(test_num, num_pe, TIMEOUT_LARGE_US);
+
+      val_pe_cache_clean_invalidate_range((uint64_t)(uintptr_t)&g_wake_tree,
+                                          sizeof(g_wake_tree));
+      acs_get_activity_counters()->pe_wakeups += g_wake_tree.woken;
+      return;
+  }
+#endif
+
   //Now run the test on all other PE
   for (i = 0; i < num_pe; i++) {
       if (i != my_index)
           val_execute_on_pe(i, payload, test_input);
   }
 
-  val_wait_for_test_completion(test_num, num_pe, TIMEOUT_LARGE);
+  val_wait_for_test_completion(test_num, num_pe, TIMEOUT_LARGE_US);
 }
 
 /**
@@ -754,8 +1343,9 @@ val_check_for_error(uint32_t test_num, uint32_t num_pe, char8_t *ruleid)
   } else {
       /* Start with least severe status */
       overall_status = RESULT_PASS;
+      val_shared_mem_sync_all();
       for (i = 0; i < num_pe; i++) {
-          status = val_get_status(i);
+          status = val_get_status_nosync(i);
           /* Checkpoint info from last PE would be reflected */
           //checkpoint = status & STATUS_MASK;
           //status = (status >> STATE_BIT) & STATE_MASK;
@@ -957,3 +1547,15 @@ void acs_reset_test_status(void)
   g_rule_test_stats.not_implemented   = 0;
   g_rule_test_stats.pal_not_supported = 0;
 }
+
+/**
+  @brief  Get pointer to global platform activity counters.
+          1. Caller       - Rule profiler sampling around test entries
+          2. Prerequisite - None.
+
+  @return Pointer to the shared activity counter structure.
+ **/
+acs_activity_counters_t *acs_get_activity_counters(void)
+{
+  return &g_activity_stats;
+}
@@ -23,34 +23,13 @@ extern char *rule_id_string[RULE_ID_SENTINEL];
 extern char *module_name_string[MODULE_ID_SENTINEL];
 extern const uint32_t alias_rule_map_count;
 extern const alias_rule_map_t alias_rule_map[];
+extern const uint16_t alias_rule_map_index[RULE_ID_SENTINEL];
 extern uint8_t g_current_pal;
 
 static RULE_ID_e rule_reference_path[RULE_REFERENCE_PATH_MAX_DEPTH + 1] = {
     RULE_ID_SENTINEL
 };
 
-/**
- * @brief Check if a rule ID exists in a list.
- *
- * Linear scan of the first `count` entries of `list` to see if any equals
- * `rid`.
- *
- * @param rid   Rule ID to find.
- * @param list  Rule ID array to scan.
- * @param count Number of valid entries in `list`.
- * @return 1 if found; 0 otherwise.
- */
-bool rule_in_list(RULE_ID_e rid, const RULE_ID_e *list, uint32_t count)
-{
-    if (!list || count == 0)
-        return 0;
-    for (uint32_t i = 0; i < count; i++) {
-        if (list[i] == rid)
-            return 1;
-    }
-    return 0;
-}
-
 /**
  * @brief Reset the current rule reference path.
  *
@@ -147,6 +126,145 @@ const RULE_ID_e *rule_reference_path_get(void)
     return rule_reference_path;
 }
 
+/**
+ * @brief Clear all bits of a rule bitset.
+ *
+ * @param set Bitset to clear.
+ */
+void rule_bitset_clear(rule_bitset_t *set)
+{
+    uint32_t i;
+
+    for (i = 0; i < RULE_BITSET_WORDS; i++)
+        set->word[i] = 0;
+}
+
+/**
+ * @brief Union @p src into @p dst (dst |= src).
+ */
+void rule_bitset_or(rule_bitset_t *dst, const rule_bitset_t *src)
+{
+    uint32_t i;
+
+    for (i = 0; i < RULE_BITSET_WORDS; i++)
+        dst->word[i] |= src->word[i];
+}
+
+/**
+ * @brief Remove the rules in @p src from @p dst (dst &= ~src).
+ */
+void rule_bitset_andnot(rule_bitset_t *dst, const rule_bitset_t *src)
+{
+    uint32_t i;
+
+    for (i = 0; i < RULE_BITSET_WORDS; i++)
+        dst->word[i] &= ~src->word[i];
+}
+
+/**
+ * @brief Set the bits of all rule IDs present in a list.
+ *
+ * Out of range IDs (>= RULE_ID_SENTINEL) are ignored.
+ *
+ * @param set   Bitset to update.
+ * @param list  Rule ID array.
+ * @param count Number of valid entries in `list`.
+ */
+void rule_bitset_set_list(rule_bitset_t *set, const RULE_ID_e *list, uint32_t count)
+{
+    uint32_t i;
+
+    if (list == NULL)
+        return;
+
+    for (i = 0; i < count; i++)
+        rule_bitset_set(set, (uint32_t)list[i]);
+}
+
+/**
+ * @brief Count the number of rules set in a bitset.
+ *
+ * @param set Bitset to count.
+ * @return Number of set bits.
+ */
+uint32_t rule_bitset_count(const rule_bitset_t *set)
+{
+    uint32_t i;
+    uint32_t count = 0;
+    uint64_t word;
+
+    for (i = 0; i < RULE_BITSET_WORDS; i++) {
+        /* Clear lowest set bit per iteration, cost is per set bit only */
+        for (word = set->word[i]; word != 0; word &= (word - 1))
+            count++;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Expand a rule bitset into an ascending RULE_ID_e list.
+ *
+ * @param set       Bitset to expand.
+ * @param list      Output array.
+ * @param max_count Capacity of `list`; extra rules are dropped.
+ * @return Number of entries written to `list`.
+ */
+uint32_t rule_bitset_to_list(const rule_bitset_t *set, RULE_ID_e *list, uint32_t max_count)
+{
+    uint32_t i;
+    uint32_t count = 0;
+    uint64_t word;
+
+    if (list == NULL)
+        return 0;
+
+    for (i = 0; i < RULE_BITSET_WORDS; i++) {
+        for (word = set->word[i]; word != 0; word &= (word - 1)) {
+            if (count >= max_count)
+                return count;
+            list[count++] = (RULE_ID_e)(i * RULE_BITSET_WORD_BITS +
+                                        (uint32_t)__builtin_ctzll(word));
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief Get the set of rules that belong to a module.
+ *
+ * The per-module bitsets are derived from rule_test_map on first use, so
+ * module selection (-m / -skipmodule) becomes a word-wide OR/AND-NOT.
+ *
+ * @param module_id MODULE_NAME_e value.
+ * @return Pointer to the module's rule bitset, or NULL if out of range.
+ */
+const rule_bitset_t *rule_module_bitset_get(uint32_t module_id)
+{
+    static rule_bitset_t module_rules[MODULE_ID_SENTINEL];
+    static bool module_rules_built;
+    uint32_t rule_id;
+    uint32_t module;
+
+    if (module_id >= MODULE_ID_SENTINEL)
+        return NULL;
+
+    if (!module_rules_built) {
+        for (module = 0; module < MODULE_ID_SENTINEL; module++)
+            rule_bitset_clear(&module_rules[module]);
+
+        for (rule_id = 0; rule_id < RULE_ID_SENTINEL; rule_id++) {
+            module = (uint32_t)rule_test_map[rule_id].module_id;
+            if (module < MODULE_ID_SENTINEL)
+                rule_bitset_set(&module_rules[module], rule_id);
+        }
+        module_rules_built = 1;
+    }
+
+    return &module_rules[module_id];
+}
+
 /**
  * @brief In-place quicksort for rule ID arrays.
  *
@@ -161,6 +279,15 @@ void quick_sort_rule_list(RULE_ID_e *rule_list, uint32_t list_size)
 {
     if (!rule_list || list_size < 2) return;          /* quick exit */
 
+    /* Lists produced by filter_rule_list_by_cli() are already ascending; the
+       last-element pivot below would degrade to O(n^2) on such input. */
+    uint32_t k;
+    for (k = 1; k < list_size; k++) {
+        if (rule_list[k - 1] > rule_list[k])
+            break;
+    }
+    if (k == list_size) return;
+
     /* Small fixed size stack (32 pairs handle any 32bit length) */
     int lo_stack[32];
     int hi_stack[32];
@@ -240,6 +367,10 @@ print_rule_test_start(uint32_t rule_enum, uint32_t indent)
     static MODULE_NAME_e prev_module = MODULE_UNKNOWN;
     MODULE_NAME_e curr_module = MODULE_UNKNOWN;
 
+#ifndef TARGET_LINUX
+    rule_result_begin(rule_enum, indent);
+#endif
+
     /* Check for module change */
     curr_module = rule_test_map[rule_enum].module_id;
 
@@ -348,6 +479,11 @@ print_rule_test_status(uint32_t rule_enum, uint32_t indent, uint32_t status)
     uint32_t top_level_rule = (indent == 0);
     acs_test_status_counters_t *stats = acs_get_test_status();
 
+#ifndef TARGET_LINUX
+    /* Structured record, emitted regardless of the print verbosity */
+    rule_result_record(rule_enum, indent, status);
+#endif
+
     val_print(INFO, "\n");
     /* Print other PAL(s) that validate this rule */
     if (status == RESULT_PAL_NOT_SUPPORTED) {
@@ -425,9 +561,9 @@ void rule_status_map_reset(void)
 /**
  * @brief Get the index of an alias rule in alias_rule_map.
  *
- * Performs a linear scan over the compile-time `alias_rule_map` and returns
- * the zero-based index of the entry whose `alias_rule_id` matches the input.
- * If no entry matches, returns `INVALID_IDX`.
+ * Uses the generated RULE_ID_e indexed alias_rule_map_index[] table. The
+ * entry is verified against alias_rule_map and a linear scan is used if the
+ * generated table is stale.
  *
  * @param alias_rule_id Alias rule identifier to look up.
  * @return uint32_t Zero-based index in `alias_rule_map`, or `INVALID_IDX` if not found.
@@ -438,6 +574,14 @@ alias_rule_map_get_index(RULE_ID_e alias_rule_id)
 
     uint32_t i;
 
+    if ((uint32_t)alias_rule_id >= RULE_ID_SENTINEL)
+        return INVALID_IDX;
+
+    /* Direct lookup through the generated index */
+    i = alias_rule_map_index[alias_rule_id];
+    if (i < alias_rule_map_count && alias_rule_map[i].alias_rule_id == alias_rule_id)
+        return i;
+
     /* Iterate over all entries in the alias map */
     for (i = 0; i <  alias_rule_map_count; i++) {
         /* Check if the current entry's alias matches the requested ID */
@@ -20,6 +20,8 @@
 #include "val_interface.h"
 #include "acs_pe.h"
 #include "acs_memory.h"
+#include "val_sync.h"
+#include "pal_status.h"
 
 extern uint8_t g_current_pal;
 extern rule_test_map_t rule_test_map[RULE_ID_SENTINEL];
@@ -57,42 +59,25 @@ static uint32_t check_rule_support(RULE_ID_e rule_id)
     return TEST_SUPPORTED; /* supported on current PAL */
 }
 
+/* Rules excluded by -skip / -skipmodule for the current run_tests() call */
+static rule_bitset_t rule_skip_set;
+
 /**
  * @brief Determine if a rule should be skipped based on CLI options.
  *
  * Checks whether the provided rule ID is present in the explicit skip list
  * (-skip) or whether its module is present in the skip-modules list
- * (-skipmodule).
+ * (-skipmodule), using the skip set built by run_tests().
  *
  * @param rule_id Rule identifier to check.
  * @return true (1) if the rule should be skipped, false(0) otherwise.
  */
 static bool is_rule_skipped(const acs_run_request_t *ctx, RULE_ID_e rule_id)
 {
-    uint32_t i;
-    MODULE_NAME_e module;
-
     if (ctx == NULL)
         return 0;
 
-    /* Check explicit rule skip list (-skip) */
-    if (ctx->skip_rule_count > 0 && ctx->skip_rule_list != NULL) {
-        for (i = 0; i < ctx->skip_rule_count; i++) {
-            if (ctx->skip_rule_list[i] == rule_id)
-                return 1;
-        }
-    }
-
-    /* Check module skip list (-skipmodule) */
-    if (ctx->num_skip_modules > 0 && ctx->skip_modules != NULL) {
-        module = rule_test_map[rule_id].module_id;
-        for (i = 0; i < ctx->num_skip_modules; i++) {
-            if (ctx->skip_modules[i] == (uint32_t)module)
-                return 1;
-        }
-    }
-
-    return 0;
+    return rule_bitset_test(&rule_skip_set, (uint32_t)rule_id);
 }
 
 /**
@@ -130,6 +115,216 @@ static uint32_t finalize_alias_status(uint32_t aggregated_status,
     return aggregated_status;
 }
 
+/**
+ * @brief Check whether a rule already has a result in this run.
+ *
+ * Alias rules frequently share children, so the alias graph is treated as a
+ * DAG: once a rule has been executed its status in rule_status_map is served
+ * to every later reference. Rules marked RULE_ATTR_STATEFUL opt out and are
+ * always re-executed.
+ *
+ * @param rule_id Rule identifier to check.
+ * @return true if the recorded status can be reused.
+ */
+static bool is_rule_result_reusable(RULE_ID_e rule_id)
+{
+    if (rule_test_map[rule_id].attr & RULE_ATTR_STATEFUL)
+        return 0;
+
+    return rule_status_map[rule_id] != TEST_STATE_UNKNOWN;
+}
+
+/**
+ * @brief Report a rule whose status is reused from an earlier execution.
+ *
+ * @param rule_id Rule identifier.
+ * @param indent  Indentation for the rule header and status.
+ * @return Recorded rule status.
+ */
+static uint32_t report_reused_rule(RULE_ID_e rule_id, uint32_t indent)
+{
+    uint32_t i;
+    uint32_t status = rule_status_map[rule_id];
+
+    print_rule_test_start(rule_id, indent);
+
+    val_print(INFO, "\n");
+    for (i = 0; i < indent; i++) {
+        val_print(INFO, "    ");
+    }
+    val_print(INFO, "    Result reused from earlier execution of ");
+    val_print(INFO, rule_id_string[rule_id]);
+
+    print_rule_test_status(rule_id, indent, status);
+
+    return status;
+}
+
+#ifndef TARGET_LINUX
+/**
+ * @brief Report a rule completed before the checkpoint of an interrupted run.
+ *
+ * @param rule_id Rule identifier.
+ * @return Restored rule status.
+ */
+static uint32_t report_restored_rule(RULE_ID_e rule_id)
+{
+    uint32_t status = rule_status_map[rule_id];
+
+    print_rule_test_start(rule_id, 0);
+    val_print(INFO, "\n    Result restored from checkpoint");
+    print_rule_test_status(rule_id, 0, status);
+
+    return status;
+}
+
+/**
+ * @brief Report the rule that was running when the previous run was
+ *        interrupted, it is not executed again.
+ *
+ * @param rule_id Rule identifier.
+ * @return Failed rule status.
+ */
+static uint32_t report_interrupted_rule(RULE_ID_e rule_id)
+{
+    uint32_t status = RESULT_FAIL(1);
+
+    print_rule_test_start(rule_id, 0);
+    val_print(ERROR, "\n    Rule did not complete before the previous run was interrupted");
+    rule_status_map[rule_id] = status;
+    print_rule_test_status(rule_id, 0, status);
+
+    return status;
+}
+
+/**
+ * @brief Switch off the parked worker pool PEs before a rule that drives PE
+ *        power states through PSCI, so its payloads start with CPU_ON.
+ *
+ * @param rule_id Rule about to be executed.
+ * @return true if the pool was released and must be set up again after
+ *         the rule.
+ */
+static bool pe_pool_suspend_for_rule(RULE_ID_e rule_id)
+{
+    if (!acs_policy_get_pe_pool())
+        return 0;
+    if (!(rule_test_map[rule_id].attr & RULE_ATTR_PE_POWER) &&
+        rule_test_map[rule_id].module_id != POWER_WAKEUP)
+        return 0;
+
+    val_pe_pool_release();
+    return 1;
+}
+
+/* Memory released, or kept for PEs that timed out, by the allocation scopes */
+static struct {
+    uint32_t rules;
+    uint32_t count;
+    uint64_t bytes;
+    uint32_t kept_count;
+    uint64_t kept_bytes;
+} g_rule_leaks;
+
+/* val_get_test_timeouts() when the allocation scope was opened */
+static uint32_t g_rule_scope_timeouts;
+
+/**
+ * @brief Open the allocation scope around a test entry.
+ */
+static void rule_alloc_scope_open(void)
+{
+    g_rule_scope_timeouts = val_get_test_timeouts();
+    val_memory_scope_open();
+}
+
+/**
+ * @brief Close the allocation scope opened around a test entry, release what
+ *        the rule left allocated and report it. If a PE timed out during the
+ *        test entry, it may still use the buffers, so they are kept.
+ *
+ * @param rule_id Rule whose test entry returned.
+ */
+static void rule_alloc_scope_close(RULE_ID_e rule_id)
+{
+    val_memory_scope_report_t report;
+    bool timed_out = (val_get_test_timeouts() != g_rule_scope_timeouts);
+
+    val_memory_scope_close(&report, !timed_out);
+
+    if (report.untracked != 0)
+        val_print(DEBUG, "\n       %d allocations of the rule not tracked", report.untracked);
+    if (report.count == 0)
+        return;
+
+    if (timed_out) {
+        val_print(WARN, "\n       A PE did not complete, %d allocations", report.count);
+        val_print(WARN, " (%ld bytes) of ", report.bytes);
+        val_print(WARN, rule_id_string[rule_id]);
+        val_print(WARN, " are not released");
+        g_rule_leaks.kept_count += report.count;
+        g_rule_leaks.kept_bytes += report.bytes;
+        return;
+    }
+
+    val_print(DEBUG, "\n       Released %d allocations", report.count);
+    val_print(DEBUG, " (%ld bytes) left by ", report.bytes);
+    val_print(DEBUG, rule_id_string[rule_id]);
+
+    g_rule_leaks.rules++;
+    g_rule_leaks.count += report.count;
+    g_rule_leaks.bytes += report.bytes;
+}
+
+/**
+ * @brief Report console characters that stalled or were dropped by the PAL
+ *        during the run, when the PAL keeps such counters.
+ */
+static void report_console_stats(void)
+{
+    uint64_t stalled = 0;
+    uint64_t dropped = 0;
+
+    if (pal_print_get_stats(&stalled, &dropped) != PAL_STATUS_SUCCESS)
+        return;
+
+    if (dropped != 0)
+        val_print(WARN, "\n Console output: %ld characters dropped", dropped);
+    val_print(DEBUG, "\n Console output: %ld characters stalled", stalled);
+}
+
+/**
+ * @brief Report the memory the allocation scopes released or kept over the run, and
+ *        the PAL heap high-water mark and fragmentation when the PAL keeps
+ *        heap statistics.
+ */
+static void report_heap_stats(void)
+{
+    PAL_HEAP_STATS stats;
+
+    if (g_rule_leaks.rules != 0) {
+        val_print(INFO, "\n Heap: %d rules left allocations,", g_rule_leaks.rules);
+        val_print(INFO, " %d released", g_rule_leaks.count);
+        val_print(INFO, " (%ld bytes)", g_rule_leaks.bytes);
+    }
+    if (g_rule_leaks.kept_count != 0) {
+        val_print(WARN, "\n Heap: %d allocations", g_rule_leaks.kept_count);
+        val_print(WARN, " (%ld bytes) kept for PEs that did not complete",
+                  g_rule_leaks.kept_bytes);
+    }
+
+    if (pal_mem_get_heap_stats(&stats) != PAL_STATUS_SUCCESS)
+        return;
+
+    if (stats.alloc_failures != 0)
+        val_print(WARN, "\n Heap: %d allocations failed", stats.alloc_failures);
+    val_print(DEBUG, "\n Heap: peak %ld of %ld bytes,", stats.peak_in_use, stats.heap_size);
+    val_print(DEBUG, " %ld in %d allocations at the end of the run,", stats.in_use,
+              stats.alloc_count);
+    val_print(DEBUG, " %d%% of free memory fragmented", stats.fragmentation);
+}
+#endif
+
 /**
  * @brief Print alias traversal banner at start/end of child execution.
  *
@@ -167,6 +362,8 @@ static void print_alias_walk_banner(RULE_ID_e rule_id, uint32_t indent, bool sta
  * rule. Recursive child invocations set @p report_self so child rules print
  * their own headers/status. All recursive descendants use a fixed indentation
  * level to keep logs tidy while still surfacing intermediate alias rules.
+ * A child rule that already has a result in this run is not executed again;
+ * its recorded status is reported instead (see is_rule_result_reusable()).
  *
  * @param ctx           Run request containing CLI selections.
  * @param rule_id       Rule to execute.
@@ -195,6 +392,15 @@ static uint32_t execute_rule_recursive(const acs_run_request_t *ctx,
     uint32_t old_log_indent;
     RULE_ID_e child_rule_id;
     const RULE_ID_e *child_rule_list;
+#ifndef TARGET_LINUX
+    rule_profile_sample_t profile_sample;
+    bool pool_suspended;
+#endif
+
+    /* Child rule already executed through another alias, serve its result */
+    if (report_self && is_rule_result_reusable(rule_id)) {
+        return report_reused_rule(rule_id, indent);
+    }
 
     /* Detect accidental alias cycles such as A -> B -> A before descending */
     if (rule_reference_path_contains(rule_id)) {
@@ -243,8 +449,18 @@ static uint32_t execute_rule_recursive(const acs_run_request_t *ctx,
         if (rule_test_map[rule_id].test_entry_id != NULL_ENTRY) {
             old_log_indent = val_log_get_indent();
             val_log_set_indent(indent);
+#ifndef TARGET_LINUX
+            rule_alloc_scope_open();
+            rule_profile_begin(&profile_sample);
+#endif
             precheck_status =
                 test_entry_func_table[rule_test_map[rule_id].test_entry_id](num_pe);
+#ifndef TARGET_LINUX
+            rule_profile_end(rule_id, &profile_sample);
+            rule_alloc_scope_close(rule_id);
+            /* Print what secondary PEs logged during the test entry */
+            val_log_ring_flush();
+#endif
             val_log_set_indent(old_log_indent);
 
             if (GET_STATE(precheck_status) == TEST_FAIL) {
@@ -306,8 +522,22 @@ static uint32_t execute_rule_recursive(const acs_run_request_t *ctx,
         if (test_entry_func_table[rule_test_map[rule_id].test_entry_id] != NULL) {
             old_log_indent = val_log_get_indent();
             val_log_set_indent(indent);
+#ifndef TARGET_LINUX
+            pool_suspended = pe_pool_suspend_for_rule(rule_id);
+            rule_alloc_scope_open();
+            /* Profile the test entry only, not the pool power cycle around it */
+            rule_profile_begin(&profile_sample);
+#endif
             rule_test_status =
                 test_entry_func_table[rule_test_map[rule_id].test_entry_id](num_pe);
+#ifndef TARGET_LINUX
+            rule_profile_end(rule_id, &profile_sample);
+            rule_alloc_scope_close(rule_id);
+            if (pool_suspended)
+                val_pe_pool_init(num_pe);
+            /* Print what secondary PEs logged during the test entry */
+            val_log_ring_flush();
+#endif
             val_log_set_indent(old_log_indent);
         } else {
             val_print(ERROR, "\n\n  Rule failed due to NULL entry \n\r ", 0);
@@ -333,273 +563,209 @@ exit_rule:
 }
 
 /**
- * @brief Filter the provided rule list in place based on CLI selections.
+ * @brief Build the set of rules excluded by -skip and -skipmodule.
+ *
+ * @param ctx  Run request containing CLI selections.
+ * @param skip Output bitset of excluded rules.
+ */
+static void build_rule_skip_set(const acs_run_request_t *ctx, rule_bitset_t *skip)
+{
+    uint32_t i;
+    const rule_bitset_t *module_rules;
+
+    rule_bitset_clear(skip);
+
+    if (ctx == NULL)
+        return;
+
+    /* Explicit rule skip list (-skip) */
+    if (ctx->skip_rule_count > 0 && ctx->skip_rule_list != NULL)
+        rule_bitset_set_list(skip, ctx->skip_rule_list, ctx->skip_rule_count);
+
+    /* Module skip list (-skipmodule) */
+    if (ctx->num_skip_modules > 0 && ctx->skip_modules != NULL) {
+        for (i = 0; i < ctx->num_skip_modules; i++) {
+            module_rules = rule_module_bitset_get(ctx->skip_modules[i]);
+            if (module_rules != NULL)
+                rule_bitset_or(skip, module_rules);
+        }
+    }
+}
+
+/**
+ * @brief Check whether an arch level passes the CLI level filter.
+ *
+ * @param index Dense rule index of the selected arch.
+ * @param ctx   Run request containing the level filter selection.
+ * @param level Level value to check.
+ * @return true if rules at @p level should be kept.
+ */
+static bool is_level_selected(const rule_arch_index_t *index,
+                              const acs_run_request_t *ctx,
+                              uint32_t level)
+{
+    switch (ctx->level_filter_mode) {
+    case LVL_FILTER_FR:
+        /* Treat FR mode as MAX up to FR; archs without FR keep all levels */
+        return (index->fr_level == 0) || (level <= index->fr_level);
+    case LVL_FILTER_ONLY:
+        return level == ctx->level_value;
+    case LVL_FILTER_MAX:
+        return level <= ctx->level_value;
+    default:
+        return 1;
+    }
+}
+
+/**
+ * @brief Build the set of arch rules excluded by level and software view.
+ *
+ * Only rules present in the selected arch rule list can be rejected; rules
+ * outside it are kept, matching the behaviour for explicitly listed rules.
+ *
+ * @param ctx    Run request containing CLI selections.
+ * @param index  Dense rule index of the selected arch.
+ * @param reject Output bitset of excluded rules.
+ */
+static void build_arch_reject_set(const acs_run_request_t *ctx,
+                                  const rule_arch_index_t *index,
+                                  rule_bitset_t *reject)
+{
+    uint32_t i;
+    rule_bitset_t allowed;
+
+    rule_bitset_clear(reject);
+
+    /* Level-based filtering */
+    if (ctx->level_filter_mode != LVL_FILTER_NONE) {
+        rule_bitset_clear(&allowed);
+        for (i = 0; i < RULE_ARCH_LEVEL_MAX; i++) {
+            if (is_level_selected(index, ctx, i))
+                rule_bitset_or(&allowed, &index->level_rules[i]);
+        }
+        rule_bitset_or(reject, &index->rules);
+        rule_bitset_andnot(reject, &allowed);
+    }
+
+    /* Software view filter (BSA): keep if any selected view matches */
+    if (index->has_sw_view && ctx->bsa_sw_view_mask != 0) {
+        rule_bitset_t view_reject;
+
+        rule_bitset_clear(&view_reject);
+        rule_bitset_or(&view_reject, &index->rules);
+        rule_bitset_clear(&allowed);
+        for (i = 0; i < RULE_ARCH_SW_VIEW_MAX; i++) {
+            if (ctx->bsa_sw_view_mask & (1u << i))
+                rule_bitset_or(&allowed, &index->sw_view_rules[i]);
+        }
+        rule_bitset_andnot(&view_reject, &allowed);
+        rule_bitset_or(reject, &view_reject);
+    }
+}
+
+/**
+ * @brief Filter the provided rule list based on CLI selections.
  *
- * Applies the following filters to the rule list, compacting it in-place while
- * preserving the original relative order of rules kept:
+ * The selection is computed on RULE_ID_e indexed bitsets:
+ * - Rules of the selected architecture (-a) are merged into the list.
  * - Rules listed in ctx->skip_rule_list are removed.
  * - Rules whose module matches any in ctx->skip_modules are removed.
  * - If ctx->execute_modules is provided and non-empty, only rules whose module
  *   is in that list are kept.
+ * - Arch rules outside the requested level / software view are removed.
+ * - With a time budget, rules that do not fit are deferred (rule_budget.c).
  *
- * No new memory is allocated. Elements beyond the returned count remain
- * unchanged but are considered out of range by callers.
+ * The resulting list is deduplicated and in ascending RULE_ID_e order, which
+ * is also the module-wise execution order used by run_tests(). The existing
+ * list storage is reused when large enough; otherwise a new owned list is
+ * allocated.
  *
  * @return New count of rules after filtering.
  */
 uint32_t filter_rule_list_by_cli(acs_run_request_t *ctx)
 {
-    uint32_t out;
     uint32_t i;
-    uint32_t si;
-    uint32_t mi;
-    RULE_ID_e rule;
-    bool skip;
-    MODULE_NAME_e module;
-    bool found;
-    /* Pointers to lookup tables for selected arch (if any) */
-    const bsa_rule_entry_t   *bsa_tbl   = NULL;
-    const sbsa_rule_entry_t  *sbsa_tbl  = NULL;
-    const pcbsa_rule_entry_t *pcbsa_tbl = NULL;
-    const vbsa_rule_entry_t  *vbsa_tbl  = NULL;
-    const pfdi_rule_entry_t  *pfdi_tbl  = NULL;
-    uint32_t tbl_count = 0;
+    uint32_t count;
+    rule_bitset_t selected;
+    rule_bitset_t mask;
+    const rule_bitset_t *module_rules;
+    const rule_arch_index_t *arch_index = NULL;
+    RULE_ID_e *new_list;
 
     if (ctx == NULL)
         return 0;
 
-    /* If architecture is selected (-a), merge its rules into the list, deduped */
+    rule_bitset_clear(&selected);
+    if (ctx->rule_list != NULL)
+        rule_bitset_set_list(&selected, ctx->rule_list, ctx->rule_count);
+
+    /* If architecture is selected (-a), merge its rules into the selection */
     if (ctx->arch_selection != ARCH_NONE) {
-        uint32_t add_count = 0;
-
-        if (ctx->arch_selection == ARCH_BSA) {
-            bsa_tbl = bsa_rule_list;
-            add_count = bsa_rule_list_len;
-        } else if (ctx->arch_selection == ARCH_SBSA) {
-            sbsa_tbl = sbsa_rule_list;
-            add_count = sbsa_rule_list_len;
-        } else if (ctx->arch_selection == ARCH_PCBSA) {
-            pcbsa_tbl = pcbsa_rule_list;
-            add_count = pcbsa_rule_list_len;
-        } else if (ctx->arch_selection == ARCH_VBSA) {
-            vbsa_tbl = vbsa_rule_list;
-            add_count = vbsa_rule_list_len;
-        } else if (ctx->arch_selection == ARCH_PFDI) {
-            pfdi_tbl = pfdi_rule_list;
-            add_count = pfdi_rule_list_len;
-        }
+        arch_index = rule_arch_index_get(ctx->arch_selection);
+        if (arch_index != NULL)
+            rule_bitset_or(&selected, &arch_index->rules);
+    }
 
-        tbl_count = add_count;
-
-        if (add_count > 0) {
-            /* Allocate a new buffer sized for worst-case unique merge */
-            RULE_ID_e *old_list = ctx->rule_list;
-            uint32_t old_count = ctx->rule_count;
-            RULE_ID_e *new_list = (RULE_ID_e *)val_memory_alloc((old_count + add_count)
-                                   * sizeof(RULE_ID_e));
-            if (new_list != NULL) {
-                /* Copy existing */
-                for (i = 0; i < old_count; i++) new_list[i] = old_list[i];
-                uint32_t new_count = old_count;
-                /* Append unique entries from table */
-                if (bsa_tbl) {
-                    for (i = 0; i < add_count; i++) {
-                        RULE_ID_e rid = bsa_tbl[i].rule_id;
-                        if (!rule_in_list(rid, new_list, new_count))
-                            new_list[new_count++] = rid;
-                    }
-                } else if (sbsa_tbl) {
-                    for (i = 0; i < add_count; i++) {
-                        RULE_ID_e rid = sbsa_tbl[i].rule_id;
-                        if (!rule_in_list(rid, new_list, new_count))
-                            new_list[new_count++] = rid;
-                    }
-                } else if (pcbsa_tbl) {
-                    for (i = 0; i < add_count; i++) {
-                        RULE_ID_e rid = pcbsa_tbl[i].rule_id;
-                        if (!rule_in_list(rid, new_list, new_count))
-                            new_list[new_count++] = rid;
-                    }
-                } else if (vbsa_tbl) {
-                    for (i = 0; i < add_count; i++) {
-                        RULE_ID_e rid = vbsa_tbl[i].rule_id;
-                        if (!rule_in_list(rid, new_list, new_count))
-                            new_list[new_count++] = rid;
-                    }
-                } else if (pfdi_tbl) {
-                    for (i = 0; i < add_count; i++) {
-                        RULE_ID_e rid = pfdi_tbl[i].rule_id;
-                        if (!rule_in_list(rid, new_list, new_count))
-                            new_list[new_count++] = rid;
-                    }
-                }
-
-                if (ctx->rule_list_owned && old_list != NULL)
-                    val_memory_free(old_list);
-                ctx->rule_list = new_list;
-                ctx->rule_count = new_count;
-                ctx->rule_list_owned = true;
-            }
+    /* Skip explicit rule IDs (-skip) and modules (-skipmodule) */
+    build_rule_skip_set(ctx, &mask);
+    rule_bitset_andnot(&selected, &mask);
+
+    /* If -m provided, keep only selected modules */
+    if (ctx->num_modules > 0 && ctx->execute_modules != NULL) {
+        rule_bitset_clear(&mask);
+        for (i = 0; i < ctx->num_modules; i++) {
+            module_rules = rule_module_bitset_get(ctx->execute_modules[i]);
+            if (module_rules != NULL)
+                rule_bitset_or(&mask, module_rules);
         }
+        for (i = 0; i < RULE_BITSET_WORDS; i++)
+            selected.word[i] &= mask.word[i];
     }
 
-    /* if rule list is NULL no filtering required */
-    if (ctx->rule_list == NULL || ctx->rule_count == 0)
-        return 0;
-
-    out = 0;
-    for (i = 0; i < ctx->rule_count; i++) {
-        rule = ctx->rule_list[i];
-        skip = 0;
-
-        /* Skip explicit rule IDs provided via -skip */
-        if (!skip && ctx->skip_rule_count > 0 && ctx->skip_rule_list != NULL) {
-            for (si = 0; si < ctx->skip_rule_count; si++) {
-                if (ctx->skip_rule_list[si] == rule) {
-                    skip = 1;
-                    break;
-                }
-            }
-        }
+    /* Level-based filtering and software view filtering */
+    if (arch_index != NULL) {
+        build_arch_reject_set(ctx, arch_index, &mask);
+        rule_bitset_andnot(&selected, &mask);
+    }
 
-        module = rule_test_map[rule].module_id;
+    count = rule_bitset_count(&selected);
 
-        /* Skip rules belonging to modules listed in -skipmodule */
-        if (!skip && ctx->num_skip_modules > 0 && ctx->skip_modules != NULL) {
-            for (mi = 0; mi < ctx->num_skip_modules; mi++) {
-                if (ctx->skip_modules[mi] == (uint32_t)module) {
-                    skip = 1;
-                    break;
-                }
-            }
-        }
+    /* Grow the list storage only if the merged selection does not fit */
+    if (count > ctx->rule_count || ctx->rule_list == NULL) {
+        new_list = NULL;
+        if (count > 0)
+            new_list = (RULE_ID_e *)val_memory_alloc(count * sizeof(RULE_ID_e));
 
-        /* If -m provided, keep only selected modules */
-        if (!skip && ctx->num_modules > 0 && ctx->execute_modules != NULL) {
-            found = 0;
-            for (mi = 0; mi < ctx->num_modules; mi++) {
-                if (ctx->execute_modules[mi] == (uint32_t)module) {
-                    found = 1;
-                    break; }
+        if (new_list == NULL) {
+            /* Without storage, fall back to the explicitly requested rules */
+            if (ctx->rule_list == NULL) {
+                ctx->rule_count = 0;
+                return 0;
             }
-            if (!found)
-                skip = 1;
+            rule_bitset_clear(&mask);
+            rule_bitset_set_list(&mask, ctx->rule_list, ctx->rule_count);
+            for (i = 0; i < RULE_BITSET_WORDS; i++)
+                selected.word[i] &= mask.word[i];
+            count = rule_bitset_count(&selected);
+        } else {
+            if (ctx->rule_list_owned && ctx->rule_list != NULL)
+                val_memory_free(ctx->rule_list);
+            ctx->rule_list = new_list;
+            ctx->rule_list_owned = true;
         }
+    }
 
-        /* Level-based filtering and software view filtering (BSA) */
-        if (!skip && ctx->arch_selection != ARCH_NONE) {
-            if (ctx->level_filter_mode != LVL_FILTER_NONE ||
-                (ctx->arch_selection == ARCH_BSA && ctx->bsa_sw_view_mask != 0)) {
-                /* Find rule in the selected arch table */
-                bool found_entry = 0;
-                if (bsa_tbl) {
-                    for (uint32_t ti = 0; ti < tbl_count; ti++) {
-                        if (bsa_tbl[ti].rule_id == rule) {
-                            found_entry = 1;
-                            /* Software view filter if requested: keep if any selected */
-                            if (ctx->bsa_sw_view_mask != 0) {
-                                uint32_t bit = (1u << (uint32_t)bsa_tbl[ti].sw_view);
-                                if ((ctx->bsa_sw_view_mask & bit) == 0) {
-                                    skip = 1;
-                                    break;
-                                }
-                            }
-                            /* Level filtering */
-                            if (ctx->level_filter_mode == LVL_FILTER_FR) {
-                                /* Treat FR mode as MAX up to FR */
-                                if ((uint32_t)bsa_tbl[ti].level > (uint32_t)BSA_LEVEL_FR)
-                                    skip = 1;
-                            } else if (ctx->level_filter_mode == LVL_FILTER_ONLY) {
-                                if ((uint32_t)bsa_tbl[ti].level != ctx->level_value)
-                                    skip = 1;
-                            } else if (ctx->level_filter_mode == LVL_FILTER_MAX) {
-                                if ((uint32_t)bsa_tbl[ti].level > ctx->level_value)
-                                    skip = 1;
-                            }
-                            break;
-                        }
-                    }
-                } else if (sbsa_tbl) {
-                    for (uint32_t ti = 0; ti < tbl_count; ti++) {
-                        if (sbsa_tbl[ti].rule_id == rule) {
-                            found_entry = 1;
-                            if (ctx->level_filter_mode == LVL_FILTER_FR) {
-                                /* Treat FR mode as MAX up to FR */
-                                if ((uint32_t)sbsa_tbl[ti].level > (uint32_t)SBSA_LEVEL_FR)
-                                    skip = 1;
-                            } else if (ctx->level_filter_mode == LVL_FILTER_ONLY) {
-                                if ((uint32_t)sbsa_tbl[ti].level != ctx->level_value)
-                                    skip = 1;
-                            } else if (ctx->level_filter_mode == LVL_FILTER_MAX) {
-                                if ((uint32_t)sbsa_tbl[ti].level > ctx->level_value)
-                                    skip = 1;
-                            }
-                            break;
-                        }
-                    }
-                } else if (pcbsa_tbl) {
-                    for (uint32_t ti = 0; ti < tbl_count; ti++) {
-                        if (pcbsa_tbl[ti].rule_id == rule) {
-                            found_entry = 1;
-                            if (ctx->level_filter_mode == LVL_FILTER_FR) {
-                                /* Treat FR mode as MAX up to FR */
-                                if ((uint32_t)pcbsa_tbl[ti].level > (uint32_t)PCBSA_LEVEL_FR)
-                                    skip = 1;
-                            } else if (ctx->level_filter_mode == LVL_FILTER_ONLY) {
-                                if ((uint32_t)pcbsa_tbl[ti].level != ctx->level_value)
-                                    skip = 1;
-                            } else if (ctx->level_filter_mode == LVL_FILTER_MAX) {
-                                if ((uint32_t)pcbsa_tbl[ti].level > ctx->level_value)
-                                    skip = 1;
-                            }
-                            break;
-                        }
-                    }
-                } else if (vbsa_tbl) {
-                    for (uint32_t ti = 0; ti < tbl_count; ti++) {
-                        if (vbsa_tbl[ti].rule_id == rule) {
-                            found_entry = 1;
-                            if (ctx->level_filter_mode == LVL_FILTER_FR) {
-                                /* Treat FR mode as MAX up to FR */
-                                if ((uint32_t)vbsa_tbl[ti].level > (uint32_t)VBSA_LEVEL_FR)
-                                    skip = 1;
-                            } else if (ctx->level_filter_mode == LVL_FILTER_ONLY) {
-                                if ((uint32_t)vbsa_tbl[ti].level != ctx->level_value)
-                                    skip = 1;
-                            } else if (ctx->level_filter_mode == LVL_FILTER_MAX) {
-                                if ((uint32_t)vbsa_tbl[ti].level > ctx->level_value)
-                                    skip = 1;
-                            }
-                            break;
-                        }
-                    }
-                } else if (pfdi_tbl) {
-                    for (uint32_t ti = 0; ti < tbl_count; ti++) {
-                        if (pfdi_tbl[ti].rule_id == rule) {
-                            found_entry = 1;
-                            if (ctx->level_filter_mode == LVL_FILTER_ONLY) {
-                                if ((uint32_t)pfdi_tbl[ti].level != ctx->level_value)
-                                    skip = 1;
-                            } else if (ctx->level_filter_mode == LVL_FILTER_MAX) {
-                                if ((uint32_t)pfdi_tbl[ti].level > ctx->level_value)
-                                    skip = 1;
-                            }
-                            break;
-                        }
-                    }
-                }
-
-                /* If not found in table, conservatively skip or keep? Keep by default */
-                (void)found_entry; /* silence unused if not used */
-            }
-        }
+    ctx->rule_count = rule_bitset_to_list(&selected, ctx->rule_list, count);
 
-        if (!skip)
-            ctx->rule_list[out++] = rule;
+#ifndef TARGET_LINUX
+    /* Quick run: keep the rules that fit in the time budget */
+    if (ctx->time_budget_us != 0) {
+        build_rule_skip_set(ctx, &mask);
+        rule_budget_apply(ctx, &mask);
     }
+#endif
 
-    ctx->rule_count = out;
-    return out;
+    return ctx->rule_count;
 }
 
 /**
@@ -620,6 +786,13 @@ run_tests(const acs_run_request_t *ctx)
     uint32_t num_pe;
     RULE_ID_e *rule_list;
     uint32_t list_size;
+#ifndef TARGET_LINUX
+    uint32_t resume_index = 0;
+    bool checkpoint = acs_policy_get_resume();
+    bool resumed = 0;
+    bool interrupted = 0;
+    uint32_t deferred = 0;
+#endif
 
     if (ctx == NULL || ctx->rule_list == NULL || ctx->rule_count == 0)
         return;
@@ -629,18 +802,85 @@ run_tests(const acs_run_request_t *ctx)
 
     val_print(INFO, "\n---------------------- Running tests ------------------------");
 
+    if (acs_policy_get_print_level() < ACS_PRINT_MIN_LEVEL)
+        val_print(WARN, "\n Prints below level %d are not compiled into this build",
+                  ACS_PRINT_MIN_LEVEL);
+
     /* Initialize per-rule status map to TEST_STATUS_UNKNOWN for this run */
     rule_status_map_reset();
+#ifndef TARGET_LINUX
+    rule_profile_reset();
+    rule_result_sink_open();
+#endif
+
+    /* Resolve -skip / -skipmodule once for child rule lookups */
+    build_rule_skip_set(ctx, &rule_skip_set);
 
     /* Get number of PEs in the system */
     num_pe = val_pe_get_num();
 
+#ifndef TARGET_LINUX
+    /* Secondary PEs log into per-PE rings, printed between test entries */
+    if (val_log_ring_init(num_pe) != ACS_STATUS_PASS)
+        val_print(WARN, "\n       Log rings not allocated, secondary PEs print directly");
+#endif
+
     /* quick sort the rule list so that it is module wise as in RULE_ID_e typedef definition */
     quick_sort_rule_list(rule_list, list_size);
 
+#ifndef TARGET_LINUX
+    /* Resume an interrupted run from its checkpoint */
+    if (checkpoint &&
+        rule_checkpoint_restore(rule_list, list_size, &resume_index,
+                                &interrupted) == ACS_STATUS_PASS) {
+        resumed = 1;
+        val_print(INFO, "\n Resuming from checkpoint at rule ");
+        val_print(INFO, rule_id_string[rule_list[resume_index]]);
+    }
+
+    /* Quick run: the time budget also bounds the actual run time */
+    if (ctx->time_budget_us != 0)
+        rule_budget_start();
+
+    /* Opt-in: keep secondary PEs parked between payloads */
+    if (acs_policy_get_pe_pool() && num_pe > 1 &&
+        val_pe_pool_init(num_pe) != ACS_STATUS_PASS)
+        val_print(WARN, "\n       PE worker pool not allocated, using PSCI CPU_ON/OFF");
+
+#ifdef ACS_SYNC_BENCHMARK
+    /* Latency of the multi-PE synchronization primitives on this platform */
+    if (num_pe > 1)
+        val_sync_benchmark(num_pe);
+#endif
+#ifdef ACS_MEM_BENCHMARK
+    /* Bandwidth of the val_libc copy and fill loops on this platform */
+    val_memcpy_benchmark();
+    /* TLB refills of a page aligned and a block aligned buffer */
+    val_memory_contig_benchmark();
+#endif
+#endif
+
     for (i = 0 ; i < list_size; i++) {
         rule_reference_path_reset();
 
+#ifndef TARGET_LINUX
+        /* Rules up to the interrupted one are reported from the checkpoint */
+        if (resumed && i < resume_index) {
+            report_restored_rule(rule_list[i]);
+            continue;
+        }
+        if (resumed && interrupted && i == resume_index) {
+            report_interrupted_rule(rule_list[i]);
+            continue;
+        }
+#endif
+
+        /* Rule already executed as a child of an earlier alias rule */
+        if (is_rule_result_reusable(rule_list[i])) {
+            report_reused_rule(rule_list[i], 0);
+            continue;
+        }
+
         /* Check for the rule support in current PAL/ACS */
         rule_support_status = check_rule_support(rule_list[i]);
 
@@ -649,6 +889,13 @@ run_tests(const acs_run_request_t *ctx)
         if (rule_support_status != TEST_SUPPORTED) {
             continue;
         }
+#else
+        /* Estimates were exceeded, defer the rules left once the budget is used */
+        if (rule_support_status == TEST_SUPPORTED &&
+            rule_budget_exhausted(ctx->time_budget_us)) {
+            deferred++;
+            continue;
+        }
 #endif
         /* Print rule header */
         print_rule_test_start(rule_list[i], 0);
@@ -660,13 +907,40 @@ run_tests(const acs_run_request_t *ctx)
             goto report_status;
         }
 
+#ifndef TARGET_LINUX
+        /* Record progress at module starts and before stateful rules */
+        if (checkpoint)
+            rule_checkpoint_save(rule_list, list_size, i);
+#endif
+
         rule_test_status = execute_rule_recursive(ctx, rule_list[i], 0, num_pe, 0);
 report_status:
         /* Record and print overall rule status */
         rule_status_map[rule_list[i]] = rule_test_status;
         print_rule_test_status(rule_list[i], 0, rule_test_status);
 
+#ifdef ACS_BINARY_LOG
+        /* Dump the unformatted DEBUG/TRACE records that led up to a failure */
+        if (IS_TEST_FAIL(rule_test_status))
+            val_binlog_dump();
+#endif
+#ifndef TARGET_LINUX
+        /* Buffered console output is complete at each rule boundary */
+        pal_print_flush();
+#endif
     }
+
+#ifndef TARGET_LINUX
+    val_pe_pool_release();
+    val_log_ring_release();
+    if (checkpoint)
+        rule_checkpoint_clear();
+    if (deferred != 0)
+        val_print(INFO, "\n\n Time budget exhausted, %d rules deferred", deferred);
+    rule_result_sink_close();
+    report_console_stats();
+    report_heap_stats();
+#endif
     val_print(INFO,
               "\n\n----------------- Suite run complete ----------------\n");
 }
@@ -0,0 +1,390 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+/* Time-budgeted rule selection for quick runs.
+ *
+ * The expected cost of each rule comes from a cost profile, the PROFILE,RULE
+ * lines dumped by an earlier run (see rule_profile.c); rules missing from the
+ * profile are charged the average profiled cost. Within the budget the
+ * selection favours coverage: the prechecks of all alias rules reachable
+ * from the rule list are charged first, so every alias root stays in the
+ * run, then base rules are taken cheapest first. Deferred base rules are
+ * removed from the rule list or, when reached through an alias, added to the
+ * skip list; alias rules left without any selected descendant are removed.
+ */
+
+#include "rule_based_execution.h"
+#include "acs_common.h"
+#include "val_interface.h"
+#include "acs_memory.h"
+#include "acs_timer.h"
+
+/* Cost charged per rule when no cost profile is available */
+#define RULE_BUDGET_DEFAULT_COST_US  500000U
+#define RULE_BUDGET_NAME_MAX         32U
+
+extern rule_test_map_t rule_test_map[RULE_ID_SENTINEL];
+extern const alias_rule_map_t alias_rule_map[];
+extern test_entry_fn_t test_entry_func_table[TEST_ENTRY_SENTINEL];
+extern char *rule_id_string[RULE_ID_SENTINEL];
+
+typedef struct {
+    const uint32_t      *cost_us;          /* cost profile, may be NULL */
+    const rule_bitset_t *skip;             /* -skip / -skipmodule selection */
+    uint64_t             default_cost_us;
+    rule_bitset_t        base;             /* base rules reachable from the list */
+    rule_bitset_t        alias;            /* alias rules reachable from the list */
+    rule_bitset_t        selected;         /* base rules that fit in the budget */
+} rule_budget_t;
+
+static rule_budget_t g_rule_budget;
+static uint64_t g_rule_budget_start;
+
+/**
+ * @brief Parse a cost profile from the text of an earlier run's log.
+ *
+ * Every "PROFILE,RULE,<rule>,<module>,<runs>,<ticks>,<time_us>,..." line sets
+ * the cost of <rule> to <time_us>; other lines are ignored.
+ *
+ * @param text    Log text, need not be NUL terminated.
+ * @param len     Length of @p text in bytes.
+ * @param cost_us Output table of RULE_ID_SENTINEL entries.
+ * @return Number of rule costs imported.
+ */
+uint32_t rule_cost_profile_parse(const char8_t *text, uint32_t len, uint32_t *cost_us)
+{
+    const char8_t *tag = "PROFILE,RULE,";
+    char8_t name[RULE_BUDGET_NAME_MAX];
+    uint32_t i = 0, t, field, n;
+    uint32_t imported = 0;
+    uint32_t rule_id;
+    uint64_t value;
+
+    if (text == NULL || cost_us == NULL)
+        return 0;
+
+    while (i < len) {
+        /* Match the tag at the current position, anywhere in a line */
+        for (t = 0; tag[t] != '\0' && (i + t) < len && text[i + t] == tag[t]; t++)
+            ;
+        if (tag[t] != '\0') {
+            i++;
+            continue;
+        }
+        i += t;
+
+        /* Field 0 is the rule name, field 4 the time in microseconds */
+        n = 0;
+        value = 0;
+        field = 0;
+        while (i < len && text[i] != '\n' && text[i] != '\r') {
+            if (text[i] == ',') {
+                field++;
+            } else if (field == 0 && n < RULE_BUDGET_NAME_MAX - 1) {
+                name[n++] = text[i];
+            } else if (field == 4 && text[i] >= '0' && text[i] <= '9') {
+                value = (value * 10) + (uint64_t)(text[i] - '0');
+            }
+            i++;
+        }
+        name[n] = '\0';
+
+        rule_id = rule_id_from_name(name);
+        if (field < 4 || rule_id >= RULE_ID_SENTINEL)
+            continue;
+
+        cost_us[rule_id] = (value > 0xFFFFFFFFU) ? 0xFFFFFFFFU : (uint32_t)value;
+        imported++;
+    }
+
+    return imported;
+}
+
+/**
+ * @brief Check whether a rule has a test entry to execute.
+ */
+static bool rule_budget_has_entry(RULE_ID_e rule_id)
+{
+    TEST_ENTRY_ID_e entry = rule_test_map[rule_id].test_entry_id;
+
+    return (entry != NULL_ENTRY) && (test_entry_func_table[entry] != NULL);
+}
+
+/**
+ * @brief Expected cost of the test entry of a rule, alias prechecks included.
+ */
+static uint64_t rule_budget_cost(const rule_budget_t *b, RULE_ID_e rule_id)
+{
+    if (!rule_budget_has_entry(rule_id))
+        return 0;
+
+    if (b->cost_us != NULL && b->cost_us[rule_id] != 0)
+        return b->cost_us[rule_id];
+
+    return b->default_cost_us;
+}
+
+/**
+ * @brief Collect the base and alias rules reachable from a rule.
+ */
+static void rule_budget_collect(rule_budget_t *b, RULE_ID_e rule_id, uint32_t depth)
+{
+    const RULE_ID_e *child_rule_list;
+    uint32_t index;
+    uint32_t j;
+
+    if (rule_id >= RULE_ID_SENTINEL || depth > RULE_REFERENCE_PATH_MAX_DEPTH)
+        return;
+    if (rule_bitset_test(b->skip, rule_id))
+        return;
+
+    if (rule_test_map[rule_id].flag == BASE_RULE) {
+        rule_bitset_set(&b->base, rule_id);
+        return;
+    }
+
+    if (rule_test_map[rule_id].flag != ALIAS_RULE || rule_bitset_test(&b->alias, rule_id))
+        return;
+
+    rule_bitset_set(&b->alias, rule_id);
+    index = alias_rule_map_get_index(rule_id);
+    if (index == INVALID_IDX)
+        return;
+
+    child_rule_list = alias_rule_map[index].child_rule_list;
+    for (j = 0; child_rule_list[j] != RULE_ID_SENTINEL; j++)
+        rule_budget_collect(b, child_rule_list[j], depth + 1);
+}
+
+/**
+ * @brief Check whether a rule or any of its descendants was selected.
+ */
+static bool rule_budget_has_selected(const rule_budget_t *b, RULE_ID_e rule_id, uint32_t depth)
+{
+    const RULE_ID_e *child_rule_list;
+    uint32_t index;
+    uint32_t j;
+
+    if (rule_id >= RULE_ID_SENTINEL || depth > RULE_REFERENCE_PATH_MAX_DEPTH)
+        return 0;
+    if (rule_bitset_test(b->skip, rule_id))
+        return 0;
+
+    if (rule_test_map[rule_id].flag == BASE_RULE)
+        return rule_bitset_test(&b->selected, rule_id);
+
+    if (rule_test_map[rule_id].flag != ALIAS_RULE)
+        return 0;
+
+    index = alias_rule_map_get_index(rule_id);
+    if (index == INVALID_IDX)
+        return 0;
+
+    child_rule_list = alias_rule_map[index].child_rule_list;
+    for (j = 0; child_rule_list[j] != RULE_ID_SENTINEL; j++) {
+        if (rule_budget_has_selected(b, child_rule_list[j], depth + 1))
+            return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Shell sort of rule ids in ascending order of expected cost.
+ */
+static void rule_budget_sort(const rule_budget_t *b, RULE_ID_e *list, uint32_t count)
+{
+    uint32_t gap, i, j;
+    RULE_ID_e tmp;
+
+    for (gap = count / 2; gap > 0; gap /= 2) {
+        for (i = gap; i < count; i++) {
+            tmp = list[i];
+            for (j = i; j >= gap && rule_budget_cost(b, list[j - gap]) > rule_budget_cost(b, tmp);
+                 j -= gap)
+                list[j] = list[j - gap];
+            list[j] = tmp;
+        }
+    }
+}
+
+/**
+ * @brief Append the deferred base rules to the skip list of the request,
+ *        so they are not executed as alias children.
+ */
+static uint32_t rule_budget_defer_children(acs_run_request_t *ctx, const rule_bitset_t *deferred,
+                                           uint32_t deferred_count)
+{
+    RULE_ID_e *new_list;
+    uint32_t count;
+    uint32_t i;
+
+    new_list = val_memory_alloc((ctx->skip_rule_count + deferred_count) * sizeof(RULE_ID_e));
+    if (new_list == NULL)
+        return ACS_STATUS_ERR;
+
+    for (i = 0; i < ctx->skip_rule_count; i++)
+        new_list[i] = ctx->skip_rule_list[i];
+    count = rule_bitset_to_list(deferred, new_list + ctx->skip_rule_count, deferred_count);
+
+    if (ctx->skip_rule_list_owned && ctx->skip_rule_list != NULL)
+        val_memory_free(ctx->skip_rule_list);
+    ctx->skip_rule_list = new_list;
+    ctx->skip_rule_count += count;
+    ctx->skip_rule_list_owned = true;
+
+    return ACS_STATUS_PASS;
+}
+
+/**
+ * @brief Reduce the rule list of a request to the rules that fit in its
+ *        time budget.
+ *
+ * @param ctx  Run request with a filtered, sorted rule list and a non-zero
+ *             time_budget_us.
+ * @param skip Rules excluded by -skip / -skipmodule.
+ * @return Number of deferred base rules.
+ */
+uint32_t rule_budget_apply(acs_run_request_t *ctx, const rule_bitset_t *skip)
+{
+    rule_budget_t *b = &g_rule_budget;
+    rule_bitset_t deferred;
+    RULE_ID_e *items;
+    uint64_t budget, planned = 0, deferred_cost = 0, cost, known = 0;
+    uint32_t known_count = 0;
+    uint32_t count, deferred_count;
+    uint32_t i, j;
+    RULE_ID_e rule_id;
+
+    if (ctx == NULL || ctx->time_budget_us == 0 || ctx->rule_list == NULL)
+        return 0;
+
+    val_memory_set(b, sizeof(*b), 0);
+    b->cost_us = ctx->rule_cost_us;
+    b->skip = skip;
+
+    for (i = 0; i < ctx->rule_count; i++)
+        rule_budget_collect(b, ctx->rule_list[i], 0);
+
+    /* Rules missing from the profile are charged the average profiled cost */
+    b->default_cost_us = RULE_BUDGET_DEFAULT_COST_US;
+    if (b->cost_us != NULL) {
+        for (i = 0; i < RULE_ID_SENTINEL; i++) {
+            if (rule_bitset_test(&b->base, i) && b->cost_us[i] != 0) {
+                known += b->cost_us[i];
+                known_count++;
+            }
+        }
+        if (known_count != 0)
+            b->default_cost_us = known / known_count;
+    }
+
+    /* Alias roots first: their prechecks are charged up front */
+    budget = ctx->time_budget_us;
+    for (i = 0; i < RULE_ID_SENTINEL; i++) {
+        if (rule_bitset_test(&b->alias, i))
+            planned += rule_budget_cost(b, i);
+    }
+
+    /* Then base rules, cheapest first */
+    count = rule_bitset_count(&b->base);
+    items = (count != 0) ? val_memory_alloc(count * sizeof(RULE_ID_e)) : NULL;
+    if (items == NULL && count != 0) {
+        val_print(WARN, "\n       Time budget ignored, allocation failed");
+        return 0;
+    }
+    count = rule_bitset_to_list(&b->base, items, count);
+    rule_budget_sort(b, items, count);
+
+    for (i = 0; i < count; i++) {
+        cost = rule_budget_cost(b, items[i]);
+        if (planned + cost > budget)
+            break;
+        planned += cost;
+        rule_bitset_set(&b->selected, items[i]);
+    }
+    for (; i < count; i++)
+        deferred_cost += rule_budget_cost(b, items[i]);
+    val_memory_free(items);
+
+    rule_bitset_clear(&deferred);
+    rule_bitset_or(&deferred, &b->base);
+    rule_bitset_andnot(&deferred, &b->selected);
+    deferred_count = rule_bitset_count(&deferred);
+
+    /* Keep selected base rules and alias rules with a selected descendant */
+    for (i = 0, j = 0; i < ctx->rule_count; i++) {
+        rule_id = ctx->rule_list[i];
+        if (rule_test_map[rule_id].flag == BASE_RULE || rule_test_map[rule_id].flag == ALIAS_RULE) {
+            if (!rule_budget_has_selected(b, rule_id, 0))
+                continue;
+        }
+        ctx->rule_list[j++] = rule_id;
+    }
+    ctx->rule_count = j;
+
+    if (deferred_count != 0 &&
+        rule_budget_defer_children(ctx, &deferred, deferred_count) != ACS_STATUS_PASS)
+        val_print(WARN, "\n       Deferred alias children could not be added to the skip list");
+
+    val_print(INFO, "\n---------- Time Budget ----------\n");
+    val_print(INFO, "   Budget (ms)            : %ld\n", budget / 1000);
+    val_print(INFO, "   Planned (ms)           : %ld\n", planned / 1000);
+    val_print(INFO, "   Rules selected         : %d\n", ctx->rule_count);
+    val_print(INFO, "   Base rules deferred    : %d\n", deferred_count);
+    val_print(INFO, "   Deferred cost (ms)     : %ld\n", deferred_cost / 1000);
+    if (b->cost_us == NULL)
+        val_print(INFO, "   No cost profile, %d ms charged per rule\n",
+                  RULE_BUDGET_DEFAULT_COST_US / 1000);
+    val_print(INFO, "---------------------------------\n");
+
+    for (i = 0; i < RULE_ID_SENTINEL; i++) {
+        if (rule_bitset_test(&deferred, i)) {
+            val_print(DEBUG, "   Deferred : ");
+            val_print(DEBUG, rule_id_string[i]);
+            val_print(DEBUG, "\n");
+        }
+    }
+
+    return deferred_count;
+}
+
+/**
+ * @brief Start the run clock checked by rule_budget_exhausted().
+ */
+void rule_budget_start(void)
+{
+    g_rule_budget_start = virtualcounter_read();
+}
+
+/**
+ * @brief Check whether the time since rule_budget_start() exceeds a budget.
+ *
+ * @param budget_us Time budget in microseconds, 0 for no budget.
+ * @return true if the budget is used up.
+ */
+bool rule_budget_exhausted(uint64_t budget_us)
+{
+    uint64_t freq = read_cntfrq_el0();
+    uint64_t elapsed;
+
+    if (budget_us == 0 || freq == 0)
+        return 0;
+
+    elapsed = virtualcounter_read() - g_rule_budget_start;
+    return ((elapsed / freq) * 1000000) + (((elapsed % freq) * 1000000) / freq) >= budget_us;
+}
@@ -0,0 +1,274 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+/* Checkpoint/resume of rule based execution.
+ *
+ * The checkpoint holds the index of a top-level rule in the sorted rule list
+ * together with every status recorded in rule_status_map so far, and is
+ * written through the PAL checkpoint hooks. On UEFI these write a
+ * non-volatile variable, so it is not written before every rule: only at the
+ * first rule of each module and before rules marked RULE_ATTR_STATEFUL, which
+ * are the ones that may hang or reset the platform.
+ *
+ * A checkpoint taken right before a rule marks that rule failed on resume.
+ * A checkpoint taken at a module boundary does not tell which rule of the
+ * module was interrupted, so the next run executes the module again from its
+ * first rule and saves before each rule of that module, so a second hang is
+ * attributed to the right rule. The checkpoint is bound to the rule list it
+ * was taken for and is deleted once the run completes.
+ */
+
+#include "rule_based_execution.h"
+#include "acs_common.h"
+#include "val_interface.h"
+#include "acs_memory.h"
+#include "pal_status.h"
+
+extern rule_test_map_t rule_test_map[RULE_ID_SENTINEL];
+
+#define RULE_CHECKPOINT_MAGIC    0x54504B43  /* "CKPT" */
+#define RULE_CHECKPOINT_VERSION  2
+/* Taken right before the rule at next_index, not at its module boundary */
+#define RULE_CHECKPOINT_AT_RULE  (1U << 0)
+#define RULE_CHECKPOINT_NO_MODULE 0xFFFFFFFFU
+/* FNV-1a offset basis */
+#define RULE_CHECKPOINT_HASH_SEED 2166136261U
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t list_hash;      /* fingerprint of the sorted rule list */
+    uint32_t list_size;
+    uint32_t next_index;     /* top-level rule running when saved */
+    uint32_t entry_count;    /* rule_checkpoint_entry_t records that follow */
+    uint32_t checksum;       /* of the records */
+    uint32_t flags;          /* RULE_CHECKPOINT_AT_RULE */
+} rule_checkpoint_hdr_t;
+
+typedef struct {
+    uint32_t rule_id;
+    uint32_t status;
+} rule_checkpoint_entry_t;
+
+#define RULE_CHECKPOINT_MAX_SIZE \
+    (sizeof(rule_checkpoint_hdr_t) + (RULE_ID_SENTINEL * sizeof(rule_checkpoint_entry_t)))
+
+static rule_checkpoint_hdr_t *g_checkpoint;
+static bool g_checkpoint_disabled;
+/* Module of the last saved checkpoint */
+static uint32_t g_checkpoint_module = RULE_CHECKPOINT_NO_MODULE;
+/* Module resumed from a module boundary, saved before each of its rules */
+static uint32_t g_checkpoint_rule_module = RULE_CHECKPOINT_NO_MODULE;
+
+/**
+ * @brief FNV-1a hash over 32-bit words.
+ */
+static uint32_t rule_checkpoint_hash(uint32_t hash, const uint32_t *words, uint32_t count)
+{
+    uint32_t i, b;
+
+    for (i = 0; i < count; i++) {
+        for (b = 0; b < 4; b++) {
+            hash ^= (words[i] >> (b * 8)) & 0xFF;
+            hash *= 16777619U;
+        }
+    }
+
+    return hash;
+}
+
+/**
+ * @brief Fingerprint of the sorted rule list the checkpoint belongs to.
+ */
+static uint32_t rule_checkpoint_list_hash(const RULE_ID_e *rule_list, uint32_t list_size)
+{
+    uint32_t hash = RULE_CHECKPOINT_HASH_SEED;
+    uint32_t i, id;
+
+    for (i = 0; i < list_size; i++) {
+        id = rule_list[i];
+        hash = rule_checkpoint_hash(hash, &id, 1);
+    }
+
+    return hash;
+}
+
+/**
+ * @brief Allocate the checkpoint buffer on first use.
+ *
+ * @return Checkpoint buffer, NULL if allocation failed.
+ */
+static rule_checkpoint_hdr_t *rule_checkpoint_buffer(void)
+{
+    if (g_checkpoint == NULL)
+        g_checkpoint = val_memory_alloc(RULE_CHECKPOINT_MAX_SIZE);
+
+    return g_checkpoint;
+}
+
+/**
+ * @brief Restore rule statuses from a checkpoint left by an interrupted run.
+ *
+ * On success rule_status_map holds the statuses recorded before the
+ * checkpoint, and @p resume_index is the position in @p rule_list of the
+ * rule the checkpoint was taken before. @p interrupted tells whether that
+ * rule did not complete, or whether the checkpoint was taken at the start of
+ * its module and the run continues from it.
+ *
+ * @param rule_list    Sorted rule list of the run.
+ * @param list_size    Number of rules in @p rule_list.
+ * @param resume_index Output index of the first rule without a result.
+ * @param interrupted  Output, true if the rule at @p resume_index did not
+ *                     complete.
+ * @return ACS_STATUS_PASS if a matching checkpoint was restored,
+ *         ACS_STATUS_SKIP otherwise.
+ */
+uint32_t rule_checkpoint_restore(const RULE_ID_e *rule_list, uint32_t list_size,
+                                 uint32_t *resume_index, bool *interrupted)
+{
+    rule_checkpoint_hdr_t *hdr = rule_checkpoint_buffer();
+    rule_checkpoint_entry_t *entry;
+    uint32_t size = RULE_CHECKPOINT_MAX_SIZE;
+    uint32_t status;
+    uint32_t i;
+
+    if (hdr == NULL || resume_index == NULL || interrupted == NULL)
+        return ACS_STATUS_SKIP;
+
+    status = pal_checkpoint_load(hdr, &size);
+    if (status != PAL_STATUS_SUCCESS || size < sizeof(*hdr))
+        return ACS_STATUS_SKIP;
+
+    if (hdr->magic != RULE_CHECKPOINT_MAGIC || hdr->version != RULE_CHECKPOINT_VERSION ||
+        hdr->entry_count > RULE_ID_SENTINEL ||
+        size < sizeof(*hdr) + (hdr->entry_count * sizeof(*entry))) {
+        val_print(WARN, "\n       Ignoring invalid checkpoint");
+        return ACS_STATUS_SKIP;
+    }
+
+    entry = (rule_checkpoint_entry_t *)(hdr + 1);
+    if (hdr->checksum != rule_checkpoint_hash(RULE_CHECKPOINT_HASH_SEED, (uint32_t *)entry,
+                                              hdr->entry_count * 2)) {
+        val_print(WARN, "\n       Ignoring corrupted checkpoint");
+        return ACS_STATUS_SKIP;
+    }
+
+    if (hdr->list_size != list_size || hdr->next_index >= list_size ||
+        hdr->list_hash != rule_checkpoint_list_hash(rule_list, list_size)) {
+        val_print(WARN, "\n       Checkpoint was taken for a different rule selection,"
+                        " starting from the first rule");
+        return ACS_STATUS_SKIP;
+    }
+
+    for (i = 0; i < hdr->entry_count; i++) {
+        if (entry[i].rule_id < RULE_ID_SENTINEL)
+            rule_status_map[entry[i].rule_id] = entry[i].status;
+    }
+
+    *resume_index = hdr->next_index;
+    *interrupted = (hdr->flags & RULE_CHECKPOINT_AT_RULE) != 0;
+    if (!*interrupted)
+        g_checkpoint_rule_module = rule_test_map[rule_list[hdr->next_index]].module_id;
+
+    return ACS_STATUS_PASS;
+}
+
+/**
+ * @brief Save a checkpoint before executing a top-level rule, if the rule
+ *        starts a module or may hang or reset the platform.
+ *
+ * Checkpointing is turned off for the rest of the run after the first
+ * failure, such as a PAL without persistent storage.
+ *
+ * @param rule_list  Sorted rule list of the run.
+ * @param list_size  Number of rules in @p rule_list.
+ * @param next_index Index of the rule about to be executed.
+ */
+void rule_checkpoint_save(const RULE_ID_e *rule_list, uint32_t list_size, uint32_t next_index)
+{
+    rule_checkpoint_hdr_t *hdr;
+    rule_checkpoint_entry_t *entry;
+    uint32_t count = 0;
+    uint32_t status;
+    uint32_t module;
+    uint32_t flags = 0;
+    uint32_t i;
+
+    if (g_checkpoint_disabled || next_index >= list_size)
+        return;
+
+    module = rule_test_map[rule_list[next_index]].module_id;
+    if ((rule_test_map[rule_list[next_index]].attr & RULE_ATTR_STATEFUL) ||
+        module == g_checkpoint_rule_module)
+        flags = RULE_CHECKPOINT_AT_RULE;
+    else if (module == g_checkpoint_module)
+        return;
+
+    hdr = rule_checkpoint_buffer();
+    if (hdr == NULL) {
+        g_checkpoint_disabled = 1;
+        return;
+    }
+
+    entry = (rule_checkpoint_entry_t *)(hdr + 1);
+    for (i = 0; i < RULE_ID_SENTINEL; i++) {
+        if (rule_status_map[i] == TEST_STATE_UNKNOWN)
+            continue;
+        entry[count].rule_id = i;
+        entry[count].status = rule_status_map[i];
+        count++;
+    }
+
+    hdr->magic = RULE_CHECKPOINT_MAGIC;
+    hdr->version = RULE_CHECKPOINT_VERSION;
+    hdr->list_hash = rule_checkpoint_list_hash(rule_list, list_size);
+    hdr->list_size = list_size;
+    hdr->next_index = next_index;
+    hdr->entry_count = count;
+    hdr->checksum = rule_checkpoint_hash(RULE_CHECKPOINT_HASH_SEED, (uint32_t *)entry, count * 2);
+    hdr->flags = flags;
+
+    status = pal_checkpoint_save(hdr, sizeof(*hdr) + (count * sizeof(*entry)));
+    if (status == PAL_STATUS_UNSUPPORTED) {
+        /* Baremetal targets with PLATFORM_CHECKPOINT_REGION_SIZE of 0 */
+        val_print(WARN, "\n       No checkpoint storage on this platform,");
+        val_print(WARN, " resume is disabled for this run");
+        g_checkpoint_disabled = 1;
+    } else if (status != PAL_STATUS_SUCCESS) {
+        val_print(WARN, "\n       Checkpoint could not be saved, status 0x%x,", status);
+        val_print(WARN, " resume is disabled for this run");
+        g_checkpoint_disabled = 1;
+    } else {
+        g_checkpoint_module = module;
+    }
+}
+
+/**
+ * @brief Delete the checkpoint once the run completed and release its buffer.
+ */
+void rule_checkpoint_clear(void)
+{
+    pal_checkpoint_clear();
+
+    if (g_checkpoint != NULL) {
+        val_memory_free(g_checkpoint);
+        g_checkpoint = NULL;
+    }
+    g_checkpoint_disabled = 0;
+    g_checkpoint_module = RULE_CHECKPOINT_NO_MODULE;
+    g_checkpoint_rule_module = RULE_CHECKPOINT_NO_MODULE;
+}
@@ -17,7 +17,9 @@
 
 #include "rule_based_execution_enum.h"
 
-/* Following array provided rule string to rule enum map */
+/* Following array provided rule string to rule enum map.
+   Run tools/scripts/gen_rule_registry.py after editing to refresh the name hash
+   in rule_registry_gen.c */
 char *rule_id_string[RULE_ID_SENTINEL] = {
     /* PE rules */
     [S_L3_01]     = "S_L3_01",
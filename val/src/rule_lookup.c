@@ -444,3 +444,136 @@ const uint32_t sbsa_rule_list_len  = (sizeof(sbsa_rule_list)  / sizeof(sbsa_rule
 const uint32_t bsa_rule_list_len   = (sizeof(bsa_rule_list)   / sizeof(bsa_rule_list[0]))   - 1U;
 const uint32_t vbsa_rule_list_len  = (sizeof(vbsa_rule_list)  / sizeof(vbsa_rule_list[0]))  - 1U;
 const uint32_t pfdi_rule_list_len  = (sizeof(pfdi_rule_list)  / sizeof(pfdi_rule_list[0]))  - 1U;
+
+/* Level bitsets are sized by RULE_ARCH_LEVEL_MAX, every arch level must fit */
+_Static_assert(BSA_LEVEL_SENTINEL <= RULE_ARCH_LEVEL_MAX,
+               "BSA levels exceed RULE_ARCH_LEVEL_MAX");
+_Static_assert(SBSA_LEVEL_SENTINEL <= RULE_ARCH_LEVEL_MAX,
+               "SBSA levels exceed RULE_ARCH_LEVEL_MAX");
+_Static_assert(PCBSA_LEVEL_SENTINEL <= RULE_ARCH_LEVEL_MAX,
+               "PC-BSA levels exceed RULE_ARCH_LEVEL_MAX");
+_Static_assert(VBSA_LEVEL_SENTINEL <= RULE_ARCH_LEVEL_MAX,
+               "VBSA levels exceed RULE_ARCH_LEVEL_MAX");
+_Static_assert(PFDI_LEVEL_SENTINEL <= RULE_ARCH_LEVEL_MAX,
+               "PFDI levels exceed RULE_ARCH_LEVEL_MAX");
+
+/* Generic view of one entry in any of the per-arch rule lists above */
+typedef struct {
+    RULE_ID_e rule_id;
+    uint32_t  level;
+    uint32_t  sw_view;
+} rule_arch_entry_t;
+
+/* Descriptor used to walk per-arch rule lists through one code path */
+typedef struct {
+    uint32_t        arch;
+    const uint32_t *list_len;
+    uint32_t        fr_level;     /* 0 if the arch has no FR level */
+    bool            has_sw_view;
+    void          (*entry_get)(uint32_t idx, rule_arch_entry_t *entry);
+} rule_arch_table_t;
+
+static void bsa_entry_get(uint32_t idx, rule_arch_entry_t *entry)
+{
+    entry->rule_id = bsa_rule_list[idx].rule_id;
+    entry->level   = (uint32_t)bsa_rule_list[idx].level;
+    entry->sw_view = (uint32_t)bsa_rule_list[idx].sw_view;
+}
+
+static void sbsa_entry_get(uint32_t idx, rule_arch_entry_t *entry)
+{
+    entry->rule_id = sbsa_rule_list[idx].rule_id;
+    entry->level   = (uint32_t)sbsa_rule_list[idx].level;
+    entry->sw_view = 0;
+}
+
+static void pcbsa_entry_get(uint32_t idx, rule_arch_entry_t *entry)
+{
+    entry->rule_id = pcbsa_rule_list[idx].rule_id;
+    entry->level   = (uint32_t)pcbsa_rule_list[idx].level;
+    entry->sw_view = 0;
+}
+
+static void vbsa_entry_get(uint32_t idx, rule_arch_entry_t *entry)
+{
+    entry->rule_id = vbsa_rule_list[idx].rule_id;
+    entry->level   = (uint32_t)vbsa_rule_list[idx].level;
+    entry->sw_view = 0;
+}
+
+static void pfdi_entry_get(uint32_t idx, rule_arch_entry_t *entry)
+{
+    entry->rule_id = pfdi_rule_list[idx].rule_id;
+    entry->level   = (uint32_t)pfdi_rule_list[idx].level;
+    entry->sw_view = 0;
+}
+
+static const rule_arch_table_t rule_arch_tables[] = {
+    { ARCH_BSA,   &bsa_rule_list_len,   BSA_LEVEL_FR,   1, bsa_entry_get   },
+    { ARCH_SBSA,  &sbsa_rule_list_len,  SBSA_LEVEL_FR,  0, sbsa_entry_get  },
+    { ARCH_PCBSA, &pcbsa_rule_list_len, PCBSA_LEVEL_FR, 0, pcbsa_entry_get },
+    { ARCH_VBSA,  &vbsa_rule_list_len,  VBSA_LEVEL_FR,  0, vbsa_entry_get  },
+    { ARCH_PFDI,  &pfdi_rule_list_len,  0,              0, pfdi_entry_get  },
+};
+
+/**
+ * @brief Get the dense rule metadata index for an architecture.
+ *
+ * Converts the selected per-arch rule list into a RULE_ID_e indexed form
+ * (membership bitset, per-level and per-software-view bitsets). The index is
+ * built on first request and cached until a different arch is requested.
+ *
+ * @param arch ARCH_SEL_e value.
+ * @return Pointer to the index, or NULL for ARCH_NONE / unknown arch.
+ */
+const rule_arch_index_t *rule_arch_index_get(uint32_t arch)
+{
+    static rule_arch_index_t arch_index;
+    static bool arch_index_valid;
+    const rule_arch_table_t *table = NULL;
+    rule_arch_entry_t entry;
+    uint32_t i;
+
+    if (arch_index_valid && arch_index.arch == arch)
+        return &arch_index;
+
+    for (i = 0; i < sizeof(rule_arch_tables) / sizeof(rule_arch_tables[0]); i++) {
+        if (rule_arch_tables[i].arch == arch) {
+            table = &rule_arch_tables[i];
+            break;
+        }
+    }
+
+    if (table == NULL)
+        return NULL;
+
+    arch_index.arch = arch;
+    arch_index.fr_level = table->fr_level;
+    arch_index.has_sw_view = table->has_sw_view;
+    rule_bitset_clear(&arch_index.rules);
+    for (i = 0; i < RULE_ARCH_LEVEL_MAX; i++)
+        rule_bitset_clear(&arch_index.level_rules[i]);
+    for (i = 0; i < RULE_ARCH_SW_VIEW_MAX; i++)
+        rule_bitset_clear(&arch_index.sw_view_rules[i]);
+
+    for (i = 0; i < *table->list_len; i++) {
+        table->entry_get(i, &entry);
+        if ((uint32_t)entry.rule_id >= RULE_ID_SENTINEL)
+            continue;
+
+        /* Out of range entries would not be selectable by any level or view filter */
+        if (entry.level >= RULE_ARCH_LEVEL_MAX || entry.sw_view >= RULE_ARCH_SW_VIEW_MAX) {
+            val_print(WARN, "\n Rule list entry %d", i);
+            val_print(WARN, " has level %d", entry.level);
+            val_print(WARN, " / software view %d out of range, ignored", entry.sw_view);
+            continue;
+        }
+
+        rule_bitset_set(&arch_index.rules, entry.rule_id);
+        rule_bitset_set(&arch_index.level_rules[entry.level], entry.rule_id);
+        rule_bitset_set(&arch_index.sw_view_rules[entry.sw_view], entry.rule_id);
+    }
+
+    arch_index_valid = 1;
+    return &arch_index;
+}
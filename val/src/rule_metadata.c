@@ -1447,6 +1447,7 @@ rule_test_map_t rule_test_map[RULE_ID_SENTINEL] = {
             .rule_desc        = "Check sys cnt visible to PE timers",
             .platform_bitmask = PLATFORM_BAREMETAL | PLATFORM_UEFI,
             .flag             = BASE_RULE,
+            .attr             = RULE_ATTR_PE_POWER | RULE_ATTR_STATEFUL,
         },
         [B_TIME_06] = {
             .test_entry_id    = T002_ENTRY,
@@ -1463,6 +1464,7 @@ rule_test_map_t rule_test_map[RULE_ID_SENTINEL] = {
             .platform_bitmask = PLATFORM_BAREMETAL | PLATFORM_UEFI,
             .flag             = BASE_RULE,
             .test_num         = ACS_TIMER_TEST_NUM_BASE + 3,
+            .attr             = RULE_ATTR_STATEFUL,
         },
         [B_TIME_08] = {
             .test_entry_id    = T004_ENTRY,
@@ -1471,6 +1473,7 @@ rule_test_map_t rule_test_map[RULE_ID_SENTINEL] = {
             .platform_bitmask = PLATFORM_BAREMETAL | PLATFORM_UEFI,
             .flag             = BASE_RULE,
             .test_num         = ACS_TIMER_TEST_NUM_BASE + 4,
+            .attr             = RULE_ATTR_STATEFUL,
         },
         [B_TIME_09] = {
             .test_entry_id    = T005_ENTRY,
@@ -1479,6 +1482,7 @@ rule_test_map_t rule_test_map[RULE_ID_SENTINEL] = {
             .platform_bitmask = PLATFORM_BAREMETAL | PLATFORM_UEFI,
             .flag             = BASE_RULE,
             .test_num         = ACS_TIMER_TEST_NUM_BASE + 5,
+            .attr             = RULE_ATTR_PE_POWER | RULE_ATTR_STATEFUL,
         },
         [B_TIME_10] = {
             .test_entry_id    = T009_ENTRY,
@@ -1487,6 +1491,7 @@ rule_test_map_t rule_test_map[RULE_ID_SENTINEL] = {
             .platform_bitmask = PLATFORM_BAREMETAL | PLATFORM_UEFI,
             .flag             = BASE_RULE,
             .test_num         = ACS_TIMER_TEST_NUM_BASE + 10,
+            .attr             = RULE_ATTR_STATEFUL,
         },
         [S_L5TI_01] = {
             .test_entry_id    = T006_ENTRY,
@@ -1495,6 +1500,7 @@ rule_test_map_t rule_test_map[RULE_ID_SENTINEL] = {
             .platform_bitmask = PLATFORM_BAREMETAL | PLATFORM_UEFI,
             .flag             = BASE_RULE,
             .test_num         = ACS_TIMER_TEST_NUM_BASE + 6,
+            .attr             = RULE_ATTR_STATEFUL,
         },
     /* WATCHDOG */
         [B_WD_00] = {
@@ -1511,6 +1517,7 @@ rule_test_map_t rule_test_map[RULE_ID_SENTINEL] = {
             .platform_bitmask = PLATFORM_BAREMETAL | PLATFORM_UEFI,
             .flag             = BASE_RULE,
             .test_num         = ACS_WD_TEST_NUM_BASE + 1,
+            .attr             = RULE_ATTR_STATEFUL,
         },
         [B_WD_02] = {
             .test_entry_id    = W001_ENTRY,
@@ -1519,6 +1526,7 @@ rule_test_map_t rule_test_map[RULE_ID_SENTINEL] = {
             .platform_bitmask = PLATFORM_BAREMETAL | PLATFORM_UEFI,
             .flag             = BASE_RULE,
             .test_num         = ACS_WD_TEST_NUM_BASE + 1,
+            .attr             = RULE_ATTR_STATEFUL,
         },
         [B_WD_03] = {
             .test_entry_id    = W002_ENTRY,
@@ -1527,6 +1535,7 @@ rule_test_map_t rule_test_map[RULE_ID_SENTINEL] = {
             .platform_bitmask = PLATFORM_BAREMETAL | PLATFORM_UEFI,
             .flag             = BASE_RULE,
             .test_num         = ACS_WD_TEST_NUM_BASE + 2,
+            .attr             = RULE_ATTR_STATEFUL,
         },
         [S_L3WD_01] = {
             .test_entry_id    = NULL_ENTRY,
@@ -1542,6 +1551,7 @@ rule_test_map_t rule_test_map[RULE_ID_SENTINEL] = {
             .platform_bitmask = PLATFORM_BAREMETAL | PLATFORM_UEFI,
             .flag             = BASE_RULE,
             .test_num         = ACS_WD_TEST_NUM_BASE + 3,
+            .attr             = RULE_ATTR_STATEFUL,
         },
     /* NIST */
         // TODO nist suite compilation with rule based infra
@@ -1559,6 +1569,7 @@ rule_test_map_t rule_test_map[RULE_ID_SENTINEL] = {
             .rule_desc        = "Check power wakeup interrupts",
             .platform_bitmask = PLATFORM_BAREMETAL | PLATFORM_UEFI,
             .flag             = BASE_RULE,
+            .attr             = RULE_ATTR_STATEFUL,
         },
         [B_WAK_07] = {
             .test_entry_id    = B_WAK_03_07_ENTRY,
@@ -1566,6 +1577,7 @@ rule_test_map_t rule_test_map[RULE_ID_SENTINEL] = {
             .rule_desc        = "Check power wakeup interrupts",
             .platform_bitmask = PLATFORM_BAREMETAL | PLATFORM_UEFI,
             .flag             = BASE_RULE,
+            .attr             = RULE_ATTR_STATEFUL,
         },
     /* PCIE */
         [B_REP_1] = {
@@ -1657,6 +1669,7 @@ rule_test_map_t rule_test_map[RULE_ID_SENTINEL] = {
             .platform_bitmask = PLATFORM_BAREMETAL | PLATFORM_UEFI,
             .flag             = BASE_RULE,
             .test_num         = ACS_EXERCISER_TEST_NUM_BASE + 38,
+            .attr             = RULE_ATTR_STATEFUL,
         },
         [IE_REG_1] = {
             .test_entry_id    = IE_REG_1_ENTRY,
@@ -1741,6 +1754,7 @@ rule_test_map_t rule_test_map[RULE_ID_SENTINEL] = {
             .platform_bitmask = PLATFORM_BAREMETAL | PLATFORM_UEFI,
             .flag             = BASE_RULE,
             .test_num         = ACS_EXERCISER_TEST_NUM_BASE + 11,
+            .attr             = RULE_ATTR_STATEFUL,
         },
         [ITS_04] = {
             .test_entry_id    = E035_ENTRY,
@@ -1749,6 +1763,7 @@ rule_test_map_t rule_test_map[RULE_ID_SENTINEL] = {
             .platform_bitmask = PLATFORM_BAREMETAL | PLATFORM_UEFI,
             .flag             = BASE_RULE,
             .test_num         = ACS_EXERCISER_TEST_NUM_BASE + 35,
+            .attr             = RULE_ATTR_STATEFUL,
         },
         [ITS_05] = {
             .test_entry_id    = E012_ENTRY,
@@ -1757,6 +1772,7 @@ rule_test_map_t rule_test_map[RULE_ID_SENTINEL] = {
             .platform_bitmask = PLATFORM_BAREMETAL | PLATFORM_UEFI,
             .flag             = BASE_RULE,
             .test_num         = ACS_EXERCISER_TEST_NUM_BASE + 12,
+            .attr             = RULE_ATTR_STATEFUL,
         },
         [ITS_08] = {
             .test_entry_id    = E048_ENTRY,
@@ -1765,6 +1781,7 @@ rule_test_map_t rule_test_map[RULE_ID_SENTINEL] = {
             .platform_bitmask = PLATFORM_BAREMETAL | PLATFORM_UEFI,
             .flag             = BASE_RULE,
             .test_num         = ACS_EXERCISER_TEST_NUM_BASE + 48,
+            .attr             = RULE_ATTR_STATEFUL,
         },
         [ITS_DEV_4] = {
             .test_entry_id    = E013_ENTRY,
@@ -1773,6 +1790,7 @@ rule_test_map_t rule_test_map[RULE_ID_SENTINEL] = {
             .platform_bitmask = PLATFORM_BAREMETAL | PLATFORM_UEFI,
             .flag             = BASE_RULE,
             .test_num         = ACS_EXERCISER_TEST_NUM_BASE + 13,
+            .attr             = RULE_ATTR_STATEFUL,
         },
         [ITS_DEV_6] = {
             .test_entry_id    = E004_ENTRY,
@@ -1781,6 +1799,7 @@ rule_test_map_t rule_test_map[RULE_ID_SENTINEL] = {
             .platform_bitmask = PLATFORM_BAREMETAL | PLATFORM_UEFI,
             .flag             = BASE_RULE,
             .test_num         = ACS_EXERCISER_TEST_NUM_BASE + 4,
+            .attr             = RULE_ATTR_STATEFUL,
         },
         [PCI_ER_01] = {
             .test_entry_id    = P010_ENTRY,
@@ -1797,6 +1816,7 @@ rule_test_map_t rule_test_map[RULE_ID_SENTINEL] = {
             .platform_bitmask = PLATFORM_BAREMETAL | PLATFORM_UEFI,
             .flag             = BASE_RULE,
             .test_num         = ACS_EXERCISER_TEST_NUM_BASE + 23,
+            .attr             = RULE_ATTR_STATEFUL,
         },
         [PCI_ER_05] = {
             .test_entry_id    = P007_ENTRY,
@@ -1813,6 +1833,7 @@ rule_test_map_t rule_test_map[RULE_ID_SENTINEL] = {
             .platform_bitmask = PLATFORM_BAREMETAL | PLATFORM_UEFI,
             .flag             = BASE_RULE,
             .test_num         = ACS_EXERCISER_TEST_NUM_BASE + 24,
+            .attr             = RULE_ATTR_STATEFUL,
         },
         [PCI_ER_07] = {
             .test_entry_id    = E029_ENTRY,
@@ -1821,6 +1842,7 @@ rule_test_map_t rule_test_map[RULE_ID_SENTINEL] = {
             .platform_bitmask = PLATFORM_BAREMETAL | PLATFORM_UEFI,
             .flag             = BASE_RULE,
             .test_num         = ACS_EXERCISER_TEST_NUM_BASE + 29,
+            .attr             = RULE_ATTR_STATEFUL,
         },
         [PCI_ER_08] = {
             .test_entry_id    = E028_ENTRY,
@@ -1829,6 +1851,7 @@ rule_test_map_t rule_test_map[RULE_ID_SENTINEL] = {
             .platform_bitmask = PLATFORM_BAREMETAL | PLATFORM_UEFI,
             .flag             = BASE_RULE,
             .test_num         = ACS_EXERCISER_TEST_NUM_BASE + 28,
+            .attr             = RULE_ATTR_STATEFUL,
         },
         [PCI_ER_09] = {
             .test_entry_id    = P090_ENTRY,
@@ -1845,6 +1868,7 @@ rule_test_map_t rule_test_map[RULE_ID_SENTINEL] = {
             .platform_bitmask = PLATFORM_BAREMETAL | PLATFORM_UEFI,
             .flag             = BASE_RULE,
             .test_num         = ACS_EXERCISER_TEST_NUM_BASE + 27,
+            .attr             = RULE_ATTR_STATEFUL,
         },
         [PCI_IC_11] = {
             .test_entry_id    = PCI_IC_11_ENTRY,
@@ -1860,6 +1884,7 @@ rule_test_map_t rule_test_map[RULE_ID_SENTINEL] = {
             .platform_bitmask = PLATFORM_BAREMETAL | PLATFORM_UEFI,
             .flag             = BASE_RULE,
             .test_num         = ACS_EXERCISER_TEST_NUM_BASE + 3,
+            .attr             = RULE_ATTR_STATEFUL,
         },
         [PCI_IN_01] = {
             .test_entry_id    = P001_ENTRY,
@@ -1914,6 +1939,7 @@ rule_test_map_t rule_test_map[RULE_ID_SENTINEL] = {
             .platform_bitmask = PLATFORM_BAREMETAL | PLATFORM_UEFI,
             .flag             = BASE_RULE,
             .test_num         = ACS_EXERCISER_TEST_NUM_BASE + 10,
+            .attr             = RULE_ATTR_STATEFUL,
         },
         [PCI_IN_12] = {
             .test_entry_id    = P037_ENTRY,
@@ -2056,6 +2082,7 @@ rule_test_map_t rule_test_map[RULE_ID_SENTINEL] = {
             .platform_bitmask = PLATFORM_BAREMETAL | PLATFORM_UEFI,
             .flag             = BASE_RULE,
             .test_num         = ACS_EXERCISER_TEST_NUM_BASE + 14,
+            .attr             = RULE_ATTR_STATEFUL,
         },
         [PCI_PP_03] = {
             .test_entry_id    = P019_ENTRY,
@@ -2142,6 +2169,7 @@ rule_test_map_t rule_test_map[RULE_ID_SENTINEL] = {
             .platform_bitmask = PLATFORM_BAREMETAL | PLATFORM_UEFI,
             .flag             = BASE_RULE,
             .test_num         = ACS_EXERCISER_TEST_NUM_BASE  +  21,
+            .attr             = RULE_ATTR_STATEFUL,
         },
         [RE_ORD_4] = {
             .test_entry_id    = E008_ENTRY,
@@ -2150,6 +2178,7 @@ rule_test_map_t rule_test_map[RULE_ID_SENTINEL] = {
             .platform_bitmask = PLATFORM_BAREMETAL | PLATFORM_UEFI,
             .flag             = BASE_RULE,
             .test_num         = ACS_EXERCISER_TEST_NUM_BASE  +  8,
+            .attr             = RULE_ATTR_STATEFUL,
         },
         [RE_PCI_1] = {
             .test_entry_id    = P085_ENTRY,
@@ -2228,6 +2257,7 @@ rule_test_map_t rule_test_map[RULE_ID_SENTINEL] = {
             .platform_bitmask = PLATFORM_BAREMETAL | PLATFORM_UEFI,
             .flag             = BASE_RULE,
             .test_num         = ACS_EXERCISER_TEST_NUM_BASE  +  36,
+            .attr             = RULE_ATTR_STATEFUL,
         },
         [RI_SMU_4] = {
             .test_entry_id    = NULL_ENTRY,
@@ -2668,6 +2698,7 @@ rule_test_map_t rule_test_map[RULE_ID_SENTINEL] = {
             .platform_bitmask = PLATFORM_UEFI,
             .flag             = BASE_RULE,
             .test_num         = ACS_TIMER_TEST_NUM_BASE + 1,
+            .attr             = RULE_ATTR_STATEFUL,
         },
 
         [V_L1TM_04] = {
@@ -2677,20 +2708,23 @@ rule_test_map_t rule_test_map[RULE_ID_SENTINEL] = {
             .platform_bitmask = PLATFORM_UEFI,
             .flag             = BASE_RULE,
             .test_num         = ACS_TIMER_TEST_NUM_BASE + 8,
+            .attr             = RULE_ATTR_STATEFUL,
         },
         [V_L1WK_02] = {
             .test_entry_id    = V_L1WK_02_05_ENTRY,
             .module_id        = POWER_WAKEUP,
             .rule_desc        = "Check power wakeup interrupts",
             .platform_bitmask = PLATFORM_UEFI,
-            .flag             = BASE_RULE
+            .flag             = BASE_RULE,
+            .attr             = RULE_ATTR_STATEFUL,
         },
         [V_L1WK_05] = {
             .test_entry_id    = V_L1WK_02_05_ENTRY,
             .module_id        = POWER_WAKEUP,
             .rule_desc        = "Check vPE power state semantics",
             .platform_bitmask = PLATFORM_UEFI,
-            .flag             = BASE_RULE
+            .flag             = BASE_RULE,
+            .attr             = RULE_ATTR_STATEFUL,
         },
         [V_L1PR_01] = {
             .test_entry_id    = NULL_ENTRY,
@@ -3018,6 +3052,7 @@ rule_test_map_t rule_test_map[RULE_ID_SENTINEL] = {
             .platform_bitmask = PLATFORM_BAREMETAL | PLATFORM_UEFI,
             .flag             = BASE_RULE,
             .test_num         = ACS_CXL_TEST_NUM_BASE  +  5,
+            .attr             = RULE_ATTR_STATEFUL,
         },
         [CXL_06] = {
             .test_entry_id    = E045_ENTRY,
@@ -3026,6 +3061,7 @@ rule_test_map_t rule_test_map[RULE_ID_SENTINEL] = {
             .platform_bitmask = PLATFORM_BAREMETAL | PLATFORM_UEFI,
             .flag             = BASE_RULE,
             .test_num         = ACS_CXL_TEST_NUM_BASE  +  6,
+            .attr             = RULE_ATTR_STATEFUL,
         },
         [CXL_09] = {
             .test_entry_id    = E043_ENTRY,
@@ -3034,6 +3070,7 @@ rule_test_map_t rule_test_map[RULE_ID_SENTINEL] = {
             .platform_bitmask = PLATFORM_BAREMETAL | PLATFORM_UEFI,
             .flag             = BASE_RULE,
             .test_num         = ACS_CXL_TEST_NUM_BASE  +  9,
+            .attr             = RULE_ATTR_STATEFUL,
         },
         [CXL_10] = {
             .test_entry_id    = CXL010_ENTRY,
@@ -4841,6 +4878,7 @@ const RULE_ID_e v_l1pr_02_rule_list[]   = {
                                      PCI_PTM_1,
                                      RULE_ID_SENTINEL};
 
+/* Run tools/scripts/gen_rule_registry.py after editing to refresh alias_rule_map_index */
 const alias_rule_map_t alias_rule_map[] = {
     /* BSA alias rules */
     {B_WD_00,   b_wd_00_rule_list},
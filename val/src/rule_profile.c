@@ -0,0 +1,254 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+/* Per-rule and per-module cost profile of a rule based run.
+ *
+ * The orchestrator samples the virtual counter and the platform activity
+ * counters around every test entry call, so each rule is charged only for
+ * its own test entry (alias prechecks are charged to the alias rule).
+ * Module totals are the sum of their rules. The summary prints the slowest
+ * rules and modules, and a PROFILE CSV dump is emitted at DEBUG verbosity.
+ */
+
+#include "rule_based_execution.h"
+#include "acs_common.h"
+#include "val_interface.h"
+#include "acs_timer.h"
+
+extern rule_test_map_t rule_test_map[RULE_ID_SENTINEL];
+extern char *rule_id_string[RULE_ID_SENTINEL];
+extern char *module_name_string[MODULE_ID_SENTINEL];
+
+static rule_profile_t g_rule_profile[RULE_ID_SENTINEL];
+static rule_profile_t g_module_profile[MODULE_ID_SENTINEL];
+
+/**
+ * @brief Clear the profile of all rules, called at the start of a run.
+ */
+void rule_profile_reset(void)
+{
+    val_memory_set(g_rule_profile, sizeof(g_rule_profile), 0);
+    val_memory_set(g_module_profile, sizeof(g_module_profile), 0);
+}
+
+/**
+ * @brief Snapshot counters before a test entry call.
+ *
+ * @param sample Output snapshot, passed to rule_profile_end().
+ */
+void rule_profile_begin(rule_profile_sample_t *sample)
+{
+    acs_activity_counters_t *activity = acs_get_activity_counters();
+
+    sample->pe_wakeups = activity->pe_wakeups;
+    sample->mmio_accesses = activity->mmio_accesses;
+    sample->start_ticks = virtualcounter_read();
+}
+
+/**
+ * @brief Charge the cost since rule_profile_begin() to a rule.
+ *
+ * @param rule_id Rule whose test entry was called.
+ * @param sample  Snapshot taken by rule_profile_begin().
+ */
+void rule_profile_end(RULE_ID_e rule_id, const rule_profile_sample_t *sample)
+{
+    uint64_t end_ticks = virtualcounter_read();
+    acs_activity_counters_t *activity = acs_get_activity_counters();
+
+    rule_profile_add(rule_id, end_ticks - sample->start_ticks,
+                     activity->pe_wakeups - sample->pe_wakeups,
+                     activity->mmio_accesses - sample->mmio_accesses);
+}
+
+/**
+ * @brief Add a measured cost to a rule.
+ *
+ * @param rule_id       Rule identifier.
+ * @param ticks         Virtual counter ticks spent in the rule.
+ * @param pe_wakeups    Secondary PE wake-ups issued by the rule.
+ * @param mmio_accesses MMIO accesses issued by the rule.
+ */
+void rule_profile_add(RULE_ID_e rule_id, uint64_t ticks, uint64_t pe_wakeups,
+                      uint64_t mmio_accesses)
+{
+    rule_profile_t *profile;
+
+    if (rule_id >= RULE_ID_SENTINEL)
+        return;
+
+    profile = &g_rule_profile[rule_id];
+    profile->ticks += ticks;
+    profile->pe_wakeups += pe_wakeups;
+    profile->mmio_accesses += mmio_accesses;
+    profile->runs++;
+}
+
+/**
+ * @brief Get the accumulated profile of a rule.
+ *
+ * @param rule_id Rule identifier.
+ * @return Profile entry, NULL for an invalid rule id.
+ */
+const rule_profile_t *rule_profile_get(RULE_ID_e rule_id)
+{
+    if (rule_id >= RULE_ID_SENTINEL)
+        return NULL;
+
+    return &g_rule_profile[rule_id];
+}
+
+/**
+ * @brief Convert virtual counter ticks to microseconds without overflowing
+ *        the intermediate product.
+ */
+static uint64_t rule_profile_ticks_to_us(uint64_t ticks, uint64_t freq)
+{
+    if (freq == 0)
+        return 0;
+
+    return ((ticks / freq) * 1000000) + (((ticks % freq) * 1000000) / freq);
+}
+
+/**
+ * @brief Module name for the profile output, tolerating unnamed modules.
+ */
+static const char *rule_profile_module_name(uint32_t module_id)
+{
+    if (module_id >= MODULE_ID_SENTINEL || module_name_string[module_id] == NULL)
+        return "UNKNOWN";
+
+    return module_name_string[module_id];
+}
+
+/**
+ * @brief Select the indices of the top_n most expensive entries of a profile
+ *        table, in descending order of ticks.
+ *
+ * @param table Profile table.
+ * @param count Number of entries in table.
+ * @param top   Output array of at least top_n indices.
+ * @param top_n Number of entries to select.
+ * @return Number of indices written to top.
+ */
+static uint32_t rule_profile_select_top(const rule_profile_t *table, uint32_t count,
+                                        uint32_t *top, uint32_t top_n)
+{
+    uint32_t i, pos;
+    uint32_t selected = 0;
+
+    for (i = 0; i < count; i++) {
+        if (table[i].runs == 0)
+            continue;
+
+        /* Insertion into the sorted top list, the last entry drops out when full */
+        pos = (selected < top_n) ? selected++ : top_n;
+        while (pos > 0 && table[top[pos - 1]].ticks < table[i].ticks) {
+            if (pos < top_n)
+                top[pos] = top[pos - 1];
+            pos--;
+        }
+        if (pos < top_n)
+            top[pos] = i;
+    }
+
+    return selected;
+}
+
+/**
+ * @brief Print the slowest rules and modules of the run and the PROFILE
+ *        CSV dump of all profiled rules and modules.
+ *
+ * @param top_n Number of rules and modules listed in the summary tables.
+ */
+void val_print_rule_profile(uint32_t top_n)
+{
+    uint32_t top[RULE_PROFILE_TOP_N_MAX];
+    uint32_t count, i;
+    uint32_t module_id;
+    uint64_t freq = read_cntfrq_el0();
+    const rule_profile_t *profile;
+
+    if (top_n > RULE_PROFILE_TOP_N_MAX)
+        top_n = RULE_PROFILE_TOP_N_MAX;
+
+    /* Module totals are the sum of their rules */
+    val_memory_set(g_module_profile, sizeof(g_module_profile), 0);
+    for (i = 0; i < RULE_ID_SENTINEL; i++) {
+        if (g_rule_profile[i].runs == 0)
+            continue;
+        module_id = rule_test_map[i].module_id;
+        if (module_id >= MODULE_ID_SENTINEL)
+            continue;
+        g_module_profile[module_id].ticks += g_rule_profile[i].ticks;
+        g_module_profile[module_id].pe_wakeups += g_rule_profile[i].pe_wakeups;
+        g_module_profile[module_id].mmio_accesses += g_rule_profile[i].mmio_accesses;
+        g_module_profile[module_id].runs++;
+    }
+
+    count = rule_profile_select_top(g_rule_profile, RULE_ID_SENTINEL, top, top_n);
+    if (count == 0)
+        return;
+
+    val_print(INFO, "\n---------- Slowest Rules --------------------------------\n");
+    val_print(INFO, "   %-12s %-10s %12s %10s %12s\n",
+              "Rule", "Module", "Time (us)", "PE wakes", "MMIO");
+    for (i = 0; i < count; i++) {
+        profile = &g_rule_profile[top[i]];
+        val_print(INFO, "   %-12s %-10s %12ld %10ld %12ld\n",
+                  rule_id_string[top[i]],
+                  rule_profile_module_name(rule_test_map[top[i]].module_id),
+                  rule_profile_ticks_to_us(profile->ticks, freq),
+                  profile->pe_wakeups, profile->mmio_accesses);
+    }
+
+    count = rule_profile_select_top(g_module_profile, MODULE_ID_SENTINEL, top, top_n);
+    val_print(INFO, "\n---------- Slowest Modules ------------------------------\n");
+    val_print(INFO, "   %-12s %-10s %12s %10s %12s\n",
+              "Module", "Rules", "Time (us)", "PE wakes", "MMIO");
+    for (i = 0; i < count; i++) {
+        profile = &g_module_profile[top[i]];
+        val_print(INFO, "   %-12s %-10d %12ld %10ld %12ld\n",
+                  rule_profile_module_name(top[i]), profile->runs,
+                  rule_profile_ticks_to_us(profile->ticks, freq),
+                  profile->pe_wakeups, profile->mmio_accesses);
+    }
+    val_print(INFO, "---------------------------------------------------------\n");
+
+    /* Machine readable dump of every profiled rule and module */
+    val_print(DEBUG, "\nPROFILE,KIND,NAME,MODULE,RUNS,TICKS,TIME_US,PE_WAKEUPS,MMIO\n");
+    for (i = 0; i < RULE_ID_SENTINEL; i++) {
+        profile = &g_rule_profile[i];
+        if (profile->runs == 0)
+            continue;
+        val_print(DEBUG, "PROFILE,RULE,%s,%s,%d,%ld,%ld,%ld,%ld\n",
+                  rule_id_string[i], rule_profile_module_name(rule_test_map[i].module_id),
+                  profile->runs, profile->ticks,
+                  rule_profile_ticks_to_us(profile->ticks, freq),
+                  profile->pe_wakeups, profile->mmio_accesses);
+    }
+    for (i = 0; i < MODULE_ID_SENTINEL; i++) {
+        profile = &g_module_profile[i];
+        if (profile->runs == 0)
+            continue;
+        val_print(DEBUG, "PROFILE,MODULE,%s,%s,%d,%ld,%ld,%ld,%ld\n",
+                  rule_profile_module_name(i), rule_profile_module_name(i),
+                  profile->runs, profile->ticks,
+                  rule_profile_ticks_to_us(profile->ticks, freq),
+                  profile->pe_wakeups, profile->mmio_accesses);
+    }
+}
@@ -0,0 +1,97 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+/* Rule name lookup over the generated tables in rule_registry_gen.c.
+ * This file only depends on rule_id_string[] so it can also be linked into
+ * the Linux user space apps.
+ */
+
+#include "acs_stdint.h"
+#include "rule_based_execution_enum.h"
+
+#define RULE_NAME_HASH_EMPTY  0xFFFF
+#define RULE_NAME_FNV_OFFSET  0x811C9DC5u
+#define RULE_NAME_FNV_PRIME   0x01000193u
+
+extern char *rule_id_string[RULE_ID_SENTINEL];
+extern const uint32_t rule_registry_rule_count;
+extern const uint32_t rule_name_hash_bucket_count;
+extern const uint32_t rule_name_hash_slot_count;
+extern const uint16_t rule_name_hash_seed[];
+extern const uint16_t rule_name_hash_slot[];
+
+/* FNV-1a over a NUL terminated name, must match gen_rule_registry.py */
+static uint32_t rule_name_hash(const char *name, uint32_t seed)
+{
+    uint32_t hash = RULE_NAME_FNV_OFFSET ^ seed;
+
+    while (*name) {
+        hash ^= (uint8_t)*name++;
+        hash *= RULE_NAME_FNV_PRIME;
+    }
+
+    return hash;
+}
+
+static uint32_t rule_name_equal(const char *a, const char *b)
+{
+    while (*a && *a == *b) {
+        a++;
+        b++;
+    }
+
+    return (*a == *b);
+}
+
+/**
+ * @brief Map a rule name string to its RULE_ID_e.
+ *
+ * Uses the generated perfect hash, so each lookup of a valid name costs two
+ * hashes and one string compare irrespective of the number of rules. Names
+ * missing from the hash (invalid tokens, or stale generated tables after a
+ * rule change without regenerating) fall back to a linear scan of
+ * rule_id_string[].
+ *
+ * @param name NUL terminated rule name, e.g. "B_PE_01".
+ * @return RULE_ID_e value, or RULE_ID_SENTINEL if @p name is not a rule.
+ */
+uint32_t rule_id_from_name(const char *name)
+{
+    uint32_t bucket;
+    uint32_t slot;
+    uint32_t rid;
+
+    if (name == 0 || *name == '\0')
+        return RULE_ID_SENTINEL;
+
+    if (rule_registry_rule_count == RULE_ID_SENTINEL) {
+        bucket = rule_name_hash(name, 0) % rule_name_hash_bucket_count;
+        slot = rule_name_hash(name, rule_name_hash_seed[bucket]) % rule_name_hash_slot_count;
+        rid = rule_name_hash_slot[slot];
+
+        if (rid < RULE_ID_SENTINEL && rule_id_string[rid] &&
+            rule_name_equal(rule_id_string[rid], name))
+            return rid;
+    }
+
+    for (rid = 0; rid < RULE_ID_SENTINEL; rid++) {
+        if (rule_id_string[rid] && rule_name_equal(rule_id_string[rid], name))
+            return rid;
+    }
+
+    return RULE_ID_SENTINEL;
+}
@@ -0,0 +1,151 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+/*
+ * GENERATED FILE - DO NOT EDIT.
+ * Regenerate with: python3 tools/scripts/gen_rule_registry.py
+ */
+
+#include "acs_stdint.h"
+#include "rule_based_execution_enum.h"
+
+/* Generated for 516 rules, 512 named rules, 33 alias rules */
+const uint32_t rule_registry_rule_count = 516;
+
+/* Perfect hash of rule_id_string[]: bucket = fnv1a(name, 0) % bucket count,
+   slot = fnv1a(name, rule_name_hash_seed[bucket]) % slot count */
+const uint32_t rule_name_hash_bucket_count = 128;
+const uint32_t rule_name_hash_slot_count = 641;
+
+const uint16_t rule_name_hash_seed[128] = {
+    0x000C, 0x0001, 0x0008, 0x0016, 0x0002, 0x002A, 0x0008, 0x0003, 0x0038, 0x001F, 0x001C, 0x0005,
+    0x000A, 0x0002, 0x0001, 0x0003, 0x0000, 0x0009, 0x0001, 0x0032, 0x0002, 0x0000, 0x000C, 0x0003,
+    0x000F, 0x0005, 0x0000, 0x000D, 0x0006, 0x0015, 0x0001, 0x001B, 0x0064, 0x0004, 0x0010, 0x000C,
+    0x001A, 0x002B, 0x000C, 0x001D, 0x0008, 0x0001, 0x0004, 0x0029, 0x0010, 0x0005, 0x0003, 0x0003,
+    0x0019, 0x0001, 0x000C, 0x0029, 0x0003, 0x0003, 0x0001, 0x0026, 0x0006, 0x0015, 0x0020, 0x0039,
+    0x0003, 0x0008, 0x0039, 0x0010, 0x0005, 0x0003, 0x000D, 0x0001, 0x001C, 0x0043, 0x0025, 0x0004,
+    0x0002, 0x0000, 0x000C, 0x0001, 0x0022, 0x0002, 0x0004, 0x003E, 0x0002, 0x000B, 0x002E, 0x0005,
+    0x0009, 0x0034, 0x002C, 0x0024, 0x0000, 0x0004, 0x004E, 0x000B, 0x0001, 0x0000, 0x0006, 0x0005,
+    0x000A, 0x0008, 0x000E, 0x000B, 0x0002, 0x0003, 0x0004, 0x0014, 0x0019, 0x0009, 0x0013, 0x0002,
+    0x004A, 0x0011, 0x0012, 0x0008, 0x000E, 0x000E, 0x0075, 0x0001, 0x0000, 0x0022, 0x0010, 0x0033,
+    0x0028, 0x0007, 0x000B, 0x000F, 0x0004, 0x0002, 0x0000, 0x001B,
+};
+
+/* RULE_ID_e per slot, 0xFFFF for unused slots */
+const uint16_t rule_name_hash_slot[641] = {
+    0xFFFF, 0x0090, 0x007C, 0x015F, 0x006C, 0x017A, 0xFFFF, 0x017D, 0x0002, 0x00C6, 0x01F9, 0xFFFF,
+    0x012E, 0x0182, 0x00A2, 0xFFFF, 0x00E4, 0xFFFF, 0x0044, 0x0011, 0x007F, 0x0128, 0x017B, 0x0203,
+    0x01AF, 0x0194, 0x00ED, 0x0061, 0x0087, 0x00B3, 0x0077, 0xFFFF, 0x01ED, 0x0154, 0x0059, 0x00D0,
+    0x00AF, 0x00AC, 0xFFFF, 0x0178, 0x00F0, 0x0029, 0xFFFF, 0xFFFF, 0xFFFF, 0x0189, 0x01B5, 0x004F,
+    0x0156, 0x01A0, 0x0036, 0x0107, 0x0198, 0x0103, 0x00B6, 0x012C, 0x0172, 0x01C8, 0x0152, 0xFFFF,
+    0x008D, 0x005B, 0x0096, 0x019A, 0x01D3, 0x0060, 0xFFFF, 0xFFFF, 0xFFFF, 0x000D, 0x018E, 0x0034,
+    0x0093, 0x00DD, 0x00F2, 0xFFFF, 0x010C, 0x0020, 0x001E, 0x0151, 0x0186, 0x0091, 0x0065, 0x00E3,
+    0x0031, 0x01EC, 0x010A, 0x01F0, 0x0032, 0xFFFF, 0x003B, 0x0084, 0x017E, 0x01C2, 0x01A8, 0x0043,
+    0x00D5, 0x01AB, 0x0070, 0xFFFF, 0xFFFF, 0xFFFF, 0x00C9, 0x0140, 0x0115, 0x017F, 0x0005, 0xFFFF,
+    0xFFFF, 0xFFFF, 0x0144, 0x005D, 0x00E0, 0x0007, 0x01FC, 0x0050, 0x0088, 0x0124, 0x01D0, 0x0146,
+    0x013D, 0x0179, 0x0106, 0x0069, 0x015A, 0x0086, 0x00E9, 0xFFFF, 0x00BD, 0xFFFF, 0x01FD, 0x000A,
+    0x011C, 0x0138, 0x01AA, 0x01D6, 0x00BE, 0x0199, 0xFFFF, 0xFFFF, 0x019F, 0x00F3, 0x004A, 0x0053,
+    0x01C4, 0x0025, 0xFFFF, 0xFFFF, 0xFFFF, 0x0174, 0x00C8, 0x0108, 0x005A, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0x002D, 0x0035, 0xFFFF, 0x003C, 0xFFFF, 0x00F8, 0x0150, 0x00DF, 0x014D, 0x0176,
+    0xFFFF, 0x00B1, 0xFFFF, 0x010B, 0x0062, 0x0120, 0x01DE, 0x019D, 0x01D5, 0xFFFF, 0x01EB, 0xFFFF,
+    0x0101, 0x0046, 0x0066, 0x0071, 0x00A0, 0x0098, 0x001D, 0x0141, 0x00E1, 0xFFFF, 0x0164, 0x002E,
+    0xFFFF, 0xFFFF, 0xFFFF, 0x0057, 0xFFFF, 0x009B, 0x0008, 0xFFFF, 0x015C, 0x0109, 0x007E, 0x000E,
+    0x01EA, 0x00BA, 0x01DB, 0x008C, 0x01FA, 0x00FF, 0x0055, 0xFFFF, 0x0177, 0x00E5, 0xFFFF, 0xFFFF,
+    0x0009, 0x00A8, 0x0160, 0x00E7, 0x0149, 0x00C1, 0x00A9, 0x01F2, 0x00B4, 0x013E, 0x00F5, 0x0165,
+    0x01B7, 0x009C, 0x016A, 0x01D8, 0x011A, 0x012D, 0x0195, 0x0127, 0x0051, 0x01BD, 0xFFFF, 0x000B,
+    0x01AC, 0xFFFF, 0x014A, 0x016D, 0x00CA, 0x016F, 0x0112, 0x01C6, 0x00B9, 0x01B9, 0x0200, 0xFFFF,
+    0xFFFF, 0x01BA, 0x0015, 0x01C5, 0x01B1, 0x0183, 0x0119, 0x0123, 0x01DC, 0x0094, 0x00D1, 0x0058,
+    0x0173, 0x0163, 0x0022, 0x01B2, 0xFFFF, 0xFFFF, 0x01F7, 0x01D9, 0x0040, 0x0080, 0x00FD, 0x001A,
+    0x0045, 0x00B7, 0x0111, 0xFFFF, 0x0167, 0x005F, 0xFFFF, 0x01D4, 0x018C, 0x00FE, 0x003F, 0x004E,
+    0xFFFF, 0x0027, 0x002F, 0x01B8, 0x01BE, 0xFFFF, 0x0068, 0x009D, 0xFFFF, 0x0074, 0x0130, 0x0170,
+    0x0145, 0x0026, 0xFFFF, 0xFFFF, 0x00CE, 0x0049, 0x0132, 0x01A7, 0x01A1, 0x0159, 0x01A9, 0xFFFF,
+    0x004C, 0x01E4, 0x0142, 0x011E, 0x0024, 0x01B0, 0x0134, 0x000F, 0x00DA, 0x013A, 0x00C2, 0x0169,
+    0x00A7, 0x01C0, 0x0180, 0x0019, 0xFFFF, 0xFFFF, 0xFFFF, 0x003E, 0x018B, 0x00B2, 0x01D1, 0x0092,
+    0x00EE, 0x00D8, 0x0153, 0x000C, 0x00D9, 0xFFFF, 0xFFFF, 0x012F, 0x0052, 0x00FC, 0x0100, 0xFFFF,
+    0x001F, 0x00EB, 0x00BC, 0x00AA, 0x00B8, 0x006E, 0xFFFF, 0x0201, 0x01A3, 0xFFFF, 0x0171, 0x01E0,
+    0x01F8, 0x00F9, 0xFFFF, 0x0037, 0x0039, 0x001C, 0x0117, 0x0166, 0x01E5, 0x0076, 0x0064, 0x0013,
+    0xFFFF, 0x0003, 0x01F3, 0x0030, 0x0014, 0x01BC, 0x0075, 0xFFFF, 0x013F, 0x0175, 0xFFFF, 0x0139,
+    0x006F, 0x008A, 0x016C, 0x014C, 0x0097, 0x007A, 0x0147, 0xFFFF, 0xFFFF, 0xFFFF, 0x0063, 0x01AD,
+    0x0095, 0x00D2, 0x0187, 0x015B, 0x004B, 0xFFFF, 0x00B5, 0x01D7, 0x00DE, 0x01AE, 0xFFFF, 0x0081,
+    0x00FA, 0xFFFF, 0x01C1, 0x01CF, 0x00EA, 0xFFFF, 0x0085, 0x00B0, 0x011D, 0x00BB, 0xFFFF, 0xFFFF,
+    0x01C3, 0xFFFF, 0x01B6, 0x01E3, 0x0157, 0xFFFF, 0x00CB, 0x0118, 0x01F1, 0x0158, 0xFFFF, 0xFFFF,
+    0xFFFF, 0x0012, 0x01E2, 0xFFFF, 0x0082, 0x0192, 0x01A2, 0x0181, 0x0202, 0xFFFF, 0x00D3, 0x005E,
+    0x0021, 0x01E6, 0x01DD, 0x005C, 0x01A5, 0xFFFF, 0x00E8, 0x009E, 0x0113, 0x0114, 0x00A3, 0x009A,
+    0x018F, 0x0196, 0x0121, 0x006A, 0x01EF, 0x0102, 0x01CB, 0xFFFF, 0x01F6, 0x00F4, 0xFFFF, 0xFFFF,
+    0x0161, 0xFFFF, 0x01CA, 0xFFFF, 0xFFFF, 0x003D, 0xFFFF, 0x01FF, 0x0131, 0x01A4, 0x00D7, 0x018A,
+    0x00C7, 0xFFFF, 0x0136, 0x01E1, 0x01C9, 0xFFFF, 0xFFFF, 0xFFFF, 0x01B4, 0xFFFF, 0x0017, 0x00D4,
+    0x00FB, 0x0110, 0x0010, 0x00F1, 0x0155, 0x00EF, 0x010D, 0x0079, 0xFFFF, 0x0168, 0x00C5, 0x008B,
+    0x01E8, 0x0054, 0x01A6, 0x00C4, 0x01D2, 0x0028, 0xFFFF, 0x007D, 0x0023, 0x00F7, 0x0072, 0x0018,
+    0x0089, 0x004D, 0x0188, 0x01BF, 0x00EC, 0x0083, 0x0143, 0xFFFF, 0x00A4, 0x01F5, 0x012A, 0x0148,
+    0xFFFF, 0x019C, 0x00CF, 0x01DA, 0x00CD, 0xFFFF, 0xFFFF, 0x00CC, 0x0190, 0xFFFF, 0x00AB, 0xFFFF,
+    0x006D, 0x01E7, 0x016E, 0x019B, 0x00C0, 0x011F, 0xFFFF, 0x019E, 0x0122, 0x00AE, 0x00E2, 0x0133,
+    0x0135, 0x01E9, 0x00BF, 0x0001, 0x01F4, 0x015D, 0x0047, 0x015E, 0x0099, 0x01BB, 0x0004, 0x0067,
+    0x006B, 0x0162, 0x0042, 0x0137, 0x01FB, 0x0197, 0x01B3, 0xFFFF, 0x013B, 0x010E, 0x00DC, 0x0038,
+    0x01CD, 0x0129, 0xFFFF, 0x0041, 0xFFFF, 0xFFFF, 0x017C, 0x0191, 0x0078, 0x00C3, 0x002A, 0x014E,
+    0x007B, 0x012B, 0x013C, 0x00A6, 0x002C, 0x0105, 0x01EE, 0xFFFF, 0xFFFF, 0x003A, 0x018D, 0x011B,
+    0x01CE, 0x0033, 0x01DF, 0x0073, 0x010F, 0x0193, 0x00A1, 0x01CC, 0xFFFF, 0x0116, 0x0000, 0x00E6,
+    0x014B, 0xFFFF, 0x00F6, 0xFFFF, 0x0056, 0x009F, 0x00A5, 0x00AD, 0x014F, 0x01C7, 0x00D6, 0x008E,
+    0x0104, 0xFFFF, 0xFFFF, 0x001B, 0x00DB, 0xFFFF, 0x0006, 0x0048, 0x0016, 0x008F, 0xFFFF, 0x016B,
+    0xFFFF, 0xFFFF, 0x002B, 0x01FE, 0xFFFF,
+};
+
+/* alias_rule_map[] index per RULE_ID_e, 0xFFFF for non-alias rules */
+const uint16_t alias_rule_map_index[RULE_ID_SENTINEL] = {
+    0x000A, 0x0018, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x000E, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x0011, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x0008, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0x000B, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x001A, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x0010,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0x0012, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x0013, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x0009, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x0016, 0xFFFF, 0xFFFF, 0x0017, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x0000, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0x000C, 0xFFFF, 0x0019, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x0001, 0xFFFF, 0xFFFF, 0xFFFF, 0x0003,
+    0x0006, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x0005,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x0007, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x0002, 0x0004, 0xFFFF,
+    0xFFFF, 0x000D, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x000F,
+    0x0014, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x0015, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0x001B, 0xFFFF, 0x001C, 0xFFFF, 0x001D, 0xFFFF, 0x001E, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0x001F, 0x0020, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+};
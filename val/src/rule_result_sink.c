@@ -0,0 +1,331 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+/* Machine-readable rule result stream.
+ *
+ * Every rule reported through print_rule_test_start()/print_rule_test_status()
+ * also produces one JSON object per line, independent of the print
+ * verbosity:
+ *
+ *   {"rule":"B_PE_01","module":"PE","depth":0,"status":"PASSED",
+ *    "checkpoint":0,"duration_us":1375,"pe":0}
+ *
+ * The run ends with {"end":1,"records":<n>,"dropped":<n>}. Records are kept
+ * in a VAL buffer (ACS_RESULT_SINK_MEMORY) or streamed through
+ * pal_result_sink_write() (ACS_RESULT_SINK_PAL), which writes a file on UEFI
+ * and a secondary UART on baremetal.
+ */
+
+#include "rule_based_execution.h"
+#include "acs_common.h"
+#include "val_interface.h"
+#include "acs_memory.h"
+#include "acs_timer.h"
+#include "pal_status.h"
+
+#define RULE_RESULT_RECORD_MAX   256
+#define RULE_RESULT_MAX_DEPTH    8
+#define RULE_RESULT_MEM_INITIAL  0x4000
+
+extern rule_test_map_t rule_test_map[RULE_ID_SENTINEL];
+extern char *rule_id_string[RULE_ID_SENTINEL];
+extern char *module_name_string[MODULE_ID_SENTINEL];
+
+typedef struct {
+    uint32_t  sink;                              /* ACS_RESULT_SINK_* */
+    uint64_t  freq;
+    uint64_t  start_ticks[RULE_RESULT_MAX_DEPTH];
+    uint32_t  records;
+    uint32_t  dropped;
+    char     *mem;                               /* ACS_RESULT_SINK_MEMORY buffer */
+    uint32_t  mem_size;
+    uint32_t  mem_len;
+} rule_result_sink_t;
+
+static rule_result_sink_t g_result_sink;
+
+/* Record being formatted */
+typedef struct {
+    char     buf[RULE_RESULT_RECORD_MAX];
+    uint32_t len;
+} rule_result_line_t;
+
+/**
+ * @brief Append a string to a record, truncating at the record size.
+ */
+static void rule_result_put_str(rule_result_line_t *line, const char *str)
+{
+    if (str == NULL)
+        return;
+
+    while (*str && line->len < RULE_RESULT_RECORD_MAX - 1)
+        line->buf[line->len++] = *str++;
+}
+
+/**
+ * @brief Append an unsigned decimal number to a record.
+ */
+static void rule_result_put_dec(rule_result_line_t *line, uint64_t value)
+{
+    char digits[20];
+    uint32_t count = 0;
+
+    do {
+        digits[count++] = (char)('0' + (value % 10));
+        value /= 10;
+    } while (value != 0);
+
+    while (count && line->len < RULE_RESULT_RECORD_MAX - 1)
+        line->buf[line->len++] = digits[--count];
+}
+
+/**
+ * @brief Append a "key":"value" member, the first member opens the object.
+ */
+static void rule_result_put_member_str(rule_result_line_t *line, const char *key,
+                                       const char *value)
+{
+    rule_result_put_str(line, (line->len == 0) ? "{\"" : ",\"");
+    rule_result_put_str(line, key);
+    rule_result_put_str(line, "\":\"");
+    rule_result_put_str(line, value);
+    rule_result_put_str(line, "\"");
+}
+
+/**
+ * @brief Append a "key":number member, the first member opens the object.
+ */
+static void rule_result_put_member_dec(rule_result_line_t *line, const char *key,
+                                       uint64_t value)
+{
+    rule_result_put_str(line, (line->len == 0) ? "{\"" : ",\"");
+    rule_result_put_str(line, key);
+    rule_result_put_str(line, "\":");
+    rule_result_put_dec(line, value);
+}
+
+/**
+ * @brief Status name of a rule result, matching the console result strings.
+ */
+static const char *rule_result_state_name(uint32_t status)
+{
+    switch (GET_STATE(status)) {
+    case TEST_PASS:
+        return "PASSED";
+    case TEST_PARTIAL_COVERED:
+        return "PARTIAL";
+    case TEST_WARNING:
+        return "WARNING";
+    case TEST_SKIP:
+        return "SKIPPED";
+    case TEST_FAIL:
+        return "FAILED";
+    case TEST_NOT_IMPLEMENTED:
+        return "NOT_IMPLEMENTED";
+    case TEST_PAL_NOT_SUPPORTED:
+        return "PAL_NOT_SUPPORTED";
+    default:
+        return "UNKNOWN";
+    }
+}
+
+/**
+ * @brief Append a record to the memory buffer, growing it as needed.
+ *
+ * @return ACS_STATUS_PASS if stored, ACS_STATUS_ERR if out of memory.
+ */
+static uint32_t rule_result_mem_write(const char *buf, uint32_t len)
+{
+    rule_result_sink_t *sink = &g_result_sink;
+    uint32_t new_size;
+    char *new_mem;
+
+    if (sink->mem_len + len > sink->mem_size) {
+        new_size = (sink->mem_size != 0) ? sink->mem_size * 2 : RULE_RESULT_MEM_INITIAL;
+        while (sink->mem_len + len > new_size)
+            new_size *= 2;
+
+        new_mem = val_memory_alloc(new_size);
+        if (new_mem == NULL)
+            return ACS_STATUS_ERR;
+
+        if (sink->mem != NULL) {
+            val_memcpy(new_mem, sink->mem, sink->mem_len);
+            val_memory_free(sink->mem);
+        }
+        sink->mem = new_mem;
+        sink->mem_size = new_size;
+    }
+
+    val_memcpy(sink->mem + sink->mem_len, (void *)buf, len);
+    sink->mem_len += len;
+    return ACS_STATUS_PASS;
+}
+
+/**
+ * @brief Emit a finished record to the selected sink.
+ *
+ * A PAL sink that fails is turned off for the rest of the run.
+ */
+static void rule_result_emit(rule_result_line_t *line)
+{
+    rule_result_sink_t *sink = &g_result_sink;
+    uint32_t status;
+
+    /* Truncated records are still closed so each line stays parseable */
+    if (line->len > RULE_RESULT_RECORD_MAX - 3)
+        line->len = RULE_RESULT_RECORD_MAX - 3;
+    line->buf[line->len++] = '}';
+    line->buf[line->len++] = '\n';
+    line->buf[line->len] = '\0';
+
+    if (sink->sink == ACS_RESULT_SINK_MEMORY) {
+        if (rule_result_mem_write(line->buf, line->len) != ACS_STATUS_PASS) {
+            sink->dropped++;
+            return;
+        }
+    } else if (sink->sink == ACS_RESULT_SINK_PAL) {
+        status = pal_result_sink_write(line->buf, line->len);
+        if (status != PAL_STATUS_SUCCESS) {
+            val_print(WARN, "\n       Result sink write failed, status 0x%x,", status);
+            val_print(WARN, " result records are disabled for this run");
+            sink->sink = ACS_RESULT_SINK_NONE;
+            return;
+        }
+    } else {
+        return;
+    }
+
+    sink->records++;
+}
+
+/**
+ * @brief Start the result stream of a run with the sink selected by the
+ *        execution policy.
+ */
+void rule_result_sink_open(void)
+{
+    rule_result_sink_t *sink = &g_result_sink;
+
+    if (sink->mem != NULL)
+        val_memory_free(sink->mem);
+
+    val_memory_set(sink, sizeof(*sink), 0);
+    sink->sink = acs_policy_get_result_sink();
+    sink->freq = read_cntfrq_el0();
+}
+
+/**
+ * @brief Note the start of a rule, called with its header line.
+ *
+ * @param rule_id Rule identifier.
+ * @param indent  Nesting depth of the rule.
+ */
+void rule_result_begin(uint32_t rule_id, uint32_t indent)
+{
+    (void)rule_id;
+
+    if (g_result_sink.sink == ACS_RESULT_SINK_NONE || indent >= RULE_RESULT_MAX_DEPTH)
+        return;
+
+    g_result_sink.start_ticks[indent] = virtualcounter_read();
+}
+
+/**
+ * @brief Emit the record of a rule, called with its result line.
+ *
+ * @param rule_id Rule identifier.
+ * @param indent  Nesting depth of the rule.
+ * @param status  Rule result.
+ */
+void rule_result_record(uint32_t rule_id, uint32_t indent, uint32_t status)
+{
+    rule_result_sink_t *sink = &g_result_sink;
+    rule_result_line_t line;
+    uint64_t ticks = 0;
+    uint32_t pe_index;
+    uint32_t module_id;
+
+    if (sink->sink == ACS_RESULT_SINK_NONE || rule_id >= RULE_ID_SENTINEL)
+        return;
+
+    if (indent < RULE_RESULT_MAX_DEPTH && sink->start_ticks[indent] != 0)
+        ticks = virtualcounter_read() - sink->start_ticks[indent];
+    pe_index = val_pe_get_index_mpid(val_pe_get_mpid());
+    if (indent < RULE_RESULT_MAX_DEPTH)
+        sink->start_ticks[indent] = 0;
+
+    module_id = rule_test_map[rule_id].module_id;
+
+    line.len = 0;
+    rule_result_put_member_str(&line, "rule", rule_id_string[rule_id]);
+    rule_result_put_member_str(&line, "module",
+                               (module_id < MODULE_ID_SENTINEL) ?
+                               module_name_string[module_id] : "UNKNOWN");
+    rule_result_put_member_dec(&line, "depth", indent);
+    rule_result_put_member_str(&line, "status", rule_result_state_name(status));
+    rule_result_put_member_dec(&line, "checkpoint", GET_CODE(status));
+    rule_result_put_member_dec(&line, "duration_us",
+                               (sink->freq != 0) ? (ticks / sink->freq) * 1000000 +
+                               ((ticks % sink->freq) * 1000000) / sink->freq : 0);
+    rule_result_put_member_dec(&line, "pe", pe_index);
+    rule_result_emit(&line);
+}
+
+/**
+ * @brief End the result stream of a run.
+ *
+ * The memory buffer stays allocated after the run so it can be read back,
+ * its location is printed for collection by the lab tooling.
+ */
+void rule_result_sink_close(void)
+{
+    rule_result_sink_t *sink = &g_result_sink;
+    rule_result_line_t line;
+    uint32_t records;
+
+    if (sink->sink == ACS_RESULT_SINK_NONE)
+        return;
+
+    records = sink->records;
+    line.len = 0;
+    rule_result_put_member_dec(&line, "end", 1);
+    rule_result_put_member_dec(&line, "records", records);
+    rule_result_put_member_dec(&line, "dropped", sink->dropped);
+    rule_result_emit(&line);
+
+    if (sink->sink == ACS_RESULT_SINK_MEMORY && sink->mem != NULL) {
+        val_print(INFO, "\n Rule result records at 0x%lx,", (uint64_t)sink->mem);
+        val_print(INFO, " %d bytes", sink->mem_len);
+    }
+
+    sink->sink = ACS_RESULT_SINK_NONE;
+}
+
+/**
+ * @brief Get the records kept by the memory sink.
+ *
+ * @param len Output length of the records in bytes.
+ * @return Record text, NULL if nothing was recorded in memory.
+ */
+const char *rule_result_sink_buffer(uint32_t *len)
+{
+    if (len != NULL)
+        *len = g_result_sink.mem_len;
+
+    return g_result_sink.mem;
+}
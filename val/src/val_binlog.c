@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Binary log (ACS_BINARY_LOG, Baremetal).
+ *
+ * val_print records below INFO are not formatted on target. Each record
+ * stores the offset of its format string in .rodata, the level, the PE
+ * index, a CNTVCT timestamp and the raw argument values in a fixed-size slot
+ * of a ring that overwrites the oldest records. Strings that are not in
+ * .rodata are copied into the slot. val_binlog_dump() prints the records as
+ * hex lines, and tools/scripts/decode_binlog.py rebuilds the text with the
+ * format strings of the ELF image.
+ */
+
+#if defined(TARGET_BAREMETAL) && defined(ACS_BINARY_LOG)
+
+#include <stdarg.h>
+#include "val_logger.h"
+#include "val_interface.h"
+#include "acs_memory.h"
+
+#ifndef ACS_BINARY_LOG_SLOTS
+#define ACS_BINARY_LOG_SLOTS      1024   /* power of two */
+#endif
+
+#define BINLOG_MAGIC              0x474F4C42  /* "BLOG" */
+#define BINLOG_VERSION            1
+#define BINLOG_SLOT_WORDS         13
+#define BINLOG_FMT_INLINE         0xFFFFFFFFu /* format text follows in the words */
+#define BINLOG_FLAG_TRUNCATED     0x1         /* arguments did not fit the slot */
+#define BINLOG_INLINE_STR_TAG     0xFF00000000000000ull
+#define BINLOG_DUMP_LINE          ((sizeof(val_binlog_slot_t) * 2) + 16)
+
+/* Layout shared with tools/scripts/decode_binlog.py */
+typedef struct {
+    volatile uint32_t seq;        /* record sequence number + 1, 0 while empty */
+    uint8_t  level;
+    uint8_t  pe_index;
+    uint8_t  nwords;              /* words used */
+    uint8_t  flags;
+    uint32_t fmt;                 /* format string offset from rodata_start */
+    uint32_t reserved;
+    uint64_t timestamp;
+    uint64_t word[BINLOG_SLOT_WORDS];
+} val_binlog_slot_t;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t rodata_start;        /* runtime address of .rodata, to relocate */
+    uint64_t freq;
+    uint32_t slot_count;
+    volatile uint32_t next_seq;
+    val_binlog_slot_t slot[ACS_BINARY_LOG_SLOTS];
+} val_binlog_t;
+
+_Static_assert(sizeof(val_binlog_slot_t) == 128, "binary log slot must be 128 bytes");
+_Static_assert((ACS_BINARY_LOG_SLOTS & (ACS_BINARY_LOG_SLOTS - 1)) == 0,
+               "ACS_BINARY_LOG_SLOTS must be a power of two");
+
+extern char __RODATA_START__[], __RODATA_END__[];
+
+/* Not static so it can be found in a memory dump through the ELF symbol */
+val_binlog_t g_binlog;
+static uint32_t g_binlog_dumped_seq;
+
+static inline bool binlog_in_rodata(const char *str)
+{
+    return str >= __RODATA_START__ && str < __RODATA_END__;
+}
+
+/**
+ *   @brief    - Copies a string into the words of a slot as a tagged length
+ *               word followed by the characters
+ *   @param    - slot  : Slot being written
+ *             - str   : String to copy
+ *   @return   - None
+ **/
+
+static void binlog_put_inline_str(val_binlog_slot_t *slot, const char *str)
+{
+    uint32_t room = BINLOG_SLOT_WORDS - slot->nwords;
+    uint32_t max_len;
+    uint32_t len = 0;
+    char *dst;
+
+    if (room < 2) {
+        slot->flags |= BINLOG_FLAG_TRUNCATED;
+        return;
+    }
+
+    max_len = (room - 1) * sizeof(uint64_t);
+    dst = (char *)&slot->word[slot->nwords + 1];
+    while (str[len] != '\0' && len < max_len) {
+        dst[len] = str[len];
+        len++;
+    }
+    if (str[len] != '\0')
+        slot->flags |= BINLOG_FLAG_TRUNCATED;
+
+    slot->word[slot->nwords] = BINLOG_INLINE_STR_TAG | len;
+    slot->nwords += 1 + ((len + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+}
+
+static inline void binlog_put_word(val_binlog_slot_t *slot, uint64_t value)
+{
+    if (slot->nwords < BINLOG_SLOT_WORDS)
+        slot->word[slot->nwords++] = value;
+    else
+        slot->flags |= BINLOG_FLAG_TRUNCATED;
+}
+
+/**
+ *   @brief    - Stores the arguments of a record as raw words, following the
+ *               conversions of the format string the way val_log reads them
+ *   @param    - slot  : Slot being written
+ *             - fmt   : Format string
+ *             - args  : Arguments of the format string
+ *   @return   - None
+ **/
+
+static void binlog_put_args(val_binlog_slot_t *slot, const char *fmt, va_list args)
+{
+    const char *str;
+    bool is_long;
+    bool is_ll;
+
+    for (; *fmt != '\0'; fmt++) {
+        if (*fmt != '%')
+            continue;
+
+        fmt++;
+        while (*fmt == '-' || *fmt == '+' || *fmt == ' ' || *fmt == '#' || *fmt == '0')
+            fmt++;
+        if (*fmt == '*') {
+            binlog_put_word(slot, (uint64_t)(int64_t)va_arg(args, int));
+            fmt++;
+        }
+        while (*fmt >= '0' && *fmt <= '9')
+            fmt++;
+
+        is_long = (*fmt == 'l');
+        is_ll = is_long && (fmt[1] == 'l');
+        while (*fmt == 'h' || *fmt == 'l')
+            fmt++;
+
+        switch (*fmt) {
+        case 'c':
+            binlog_put_word(slot, (uint64_t)va_arg(args, int));
+            break;
+        case 's':
+            str = va_arg(args, const char *);
+            if (str == NULL || binlog_in_rodata(str))
+                binlog_put_word(slot, (uint64_t)(uintptr_t)str);
+            else
+                binlog_put_inline_str(slot, str);
+            break;
+        case 'd':
+        case 'i':
+            if (is_ll)
+                binlog_put_word(slot, (uint64_t)va_arg(args, long long));
+            else if (is_long)
+                binlog_put_word(slot, (uint64_t)va_arg(args, long));
+            else
+                binlog_put_word(slot, (uint64_t)(int64_t)va_arg(args, int));
+            break;
+        case 'b':
+        case 'B':
+        case 'o':
+        case 'x':
+        case 'X':
+        case 'u':
+            if (is_ll)
+                binlog_put_word(slot, (uint64_t)va_arg(args, unsigned long long));
+            else if (is_long)
+                binlog_put_word(slot, (uint64_t)va_arg(args, unsigned long));
+            else
+                binlog_put_word(slot, (uint64_t)va_arg(args, unsigned int));
+            break;
+        case 'p':
+            binlog_put_word(slot, (uint64_t)(uintptr_t)va_arg(args, void *));
+            break;
+        case '%':
+            break;
+        default:
+            /* Unknown conversion, the decoder stops at the same place */
+            return;
+        }
+
+        if (*fmt == '\0')
+            return;
+    }
+}
+
+/**
+ *   @brief    - Records a log message in the binary log ring without
+ *               formatting it. Safe to call from any PE.
+ *   @param    - verbosity  : Print Verbosity level
+ *             - msg        : Format string
+ *             - ...        : Arguments for the format string
+ *   @return   - None
+ **/
+
+void val_binlog_record(print_verbosity_t verbosity, const char *msg, ...)
+{
+    val_binlog_t *log = &g_binlog;
+    val_binlog_slot_t *slot;
+    uint32_t seq;
+    va_list args;
+
+    if (msg == NULL || *msg == '\0')
+        return;
+
+    if (log->magic != BINLOG_MAGIC) {
+        log->rodata_start = (uint64_t)(uintptr_t)__RODATA_START__;
+        log->freq = read_cntfrq_el0();
+        log->slot_count = ACS_BINARY_LOG_SLOTS;
+        log->version = BINLOG_VERSION;
+        log->magic = BINLOG_MAGIC;
+    }
+
+    seq = val_pe_atomic_add(&log->next_seq, 1);
+    slot = &log->slot[seq & (ACS_BINARY_LOG_SLOTS - 1)];
+
+    slot->seq = 0;
+    slot->level = (uint8_t)verbosity;
+    slot->pe_index = (uint8_t)val_pe_get_index_mpid(val_pe_get_mpid());
+    slot->nwords = 0;
+    slot->flags = 0;
+    slot->reserved = 0;
+    slot->timestamp = virtualcounter_read();
+
+    if (binlog_in_rodata(msg)) {
+        slot->fmt = (uint32_t)(msg - __RODATA_START__);
+    } else {
+        /* Format text built at run time, keep a copy of it */
+        slot->fmt = BINLOG_FMT_INLINE;
+        binlog_put_inline_str(slot, msg);
+    }
+
+    va_start(args, msg);
+    binlog_put_args(slot, msg, args);
+    va_end(args);
+
+    /* Publish the slot last, a torn slot keeps seq 0 */
+    val_mem_issue_dsb();
+    slot->seq = seq + 1;
+}
+
+static void binlog_put_hex(char *line, uint32_t *pos, const uint8_t *data, uint32_t len)
+{
+    static const char digits[] = "0123456789abcdef";
+    uint32_t i;
+
+    for (i = 0; i < len; i++) {
+        line[(*pos)++] = digits[data[i] >> 4];
+        line[(*pos)++] = digits[data[i] & 0xF];
+    }
+}
+
+/**
+ *   @brief    - Prints the records added since the previous dump as
+ *               BINLOG hex lines for tools/scripts/decode_binlog.py. Records
+ *               overwritten in the meantime are reported as lost by the
+ *               decoder from the gap in sequence numbers.
+ *   @param    - None
+ *   @return   - None
+ **/
+
+void val_binlog_dump(void)
+{
+    val_binlog_t *log = &g_binlog;
+    val_binlog_slot_t *slot;
+    char line[BINLOG_DUMP_LINE];
+    uint32_t next_seq = log->next_seq;
+    uint32_t seq;
+    uint32_t pos;
+
+    if (log->magic != BINLOG_MAGIC || next_seq == g_binlog_dumped_seq)
+        return;
+
+    seq = g_binlog_dumped_seq;
+    if (next_seq - seq > ACS_BINARY_LOG_SLOTS)
+        seq = next_seq - ACS_BINARY_LOG_SLOTS;
+
+    /* Header line: BINLOG,H,<header fields in hex> */
+    pos = 0;
+    line[pos++] = '\n';
+    val_mem_copy(&line[pos], "BINLOG,H,", 9);
+    pos += 9;
+    binlog_put_hex(line, &pos, (const uint8_t *)log,
+                   (uint32_t)((uintptr_t)&log->slot[0] - (uintptr_t)log));
+    line[pos++] = '\n';
+    line[pos] = '\0';
+    pal_print((uint64_t)(uintptr_t)line);
+
+    for (; seq != next_seq; seq++) {
+        slot = &log->slot[seq & (ACS_BINARY_LOG_SLOTS - 1)];
+        if (slot->seq != seq + 1)
+            continue;
+
+        pos = 0;
+        val_mem_copy(&line[pos], "BINLOG,R,", 9);
+        pos += 9;
+        binlog_put_hex(line, &pos, (const uint8_t *)slot, sizeof(*slot));
+        line[pos++] = '\n';
+        line[pos] = '\0';
+        pal_print((uint64_t)(uintptr_t)line);
+    }
+
+    g_binlog_dumped_seq = next_seq;
+}
+
+#else
+
+#include "val_logger.h"
+
+void val_binlog_dump(void)
+{
+}
+
+#endif /* TARGET_BAREMETAL && ACS_BINARY_LOG */
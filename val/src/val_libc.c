@@ -17,6 +17,45 @@
 
 #include "val_libc.h"
 
+#ifndef TARGET_LINUX
+#include "acs_common.h"
+#include "val_interface.h"
+#include "val_logger.h"
+#include "val_sysreg.h"
+#include "val_sysreg_pe.h"
+#include "acs_memory.h"
+
+/* Block loops in AArch64/LibcSupport.S */
+void ValMemCopyLdp(void *dst, const void *src, uint64_t len);
+void ValMemCopyNt(void *dst, const void *src, uint64_t len);
+void ValMemCopySimd(void *dst, const void *src, uint64_t len);
+void ValMemSetStp(void *dst, uint64_t len, uint64_t pattern);
+void ValMemZeroZva(void *dst, uint64_t len, uint64_t block);
+#endif
+
+#define LIBC_WORD_MASK          (sizeof(uint64_t) - 1)
+#define LIBC_BLOCK_SIZE         64
+
+#define LIBC_PFR0_ADVSIMD_SHIFT 20
+#define LIBC_PFR0_ADVSIMD_MASK  0xF
+#define LIBC_PFR0_ADVSIMD_NONE  0xF
+#define LIBC_CPACR_FPEN_SHIFT   20
+#define LIBC_CPACR_FPEN_MASK    0x3
+#define LIBC_CPACR_FPEN_ALL     0x3
+#define LIBC_CPTR_TFP           (1ULL << 10)
+#define LIBC_HCR_E2H            (1ULL << 34)
+#define LIBC_SCTLR_M            (1ULL << 0)
+#define LIBC_SCTLR_C            (1ULL << 2)
+#define LIBC_DCZID_DZP          (1ULL << 4)
+#define LIBC_DCZID_BS_MASK      0xF
+
+#define LIBC_BENCH_SIZE         (4 * 1024 * 1024)
+#define LIBC_BENCH_MIN_SIZE     (256 * 1024)
+#define LIBC_BENCH_TRAFFIC      (64ULL * 1024 * 1024)
+
+/* 64-bit view of a byte buffer, for the word loops */
+typedef uint64_t libc_word_t __attribute__((__may_alias__));
+
 /**
   @brief  Compare two memory buffers
 
@@ -32,6 +71,23 @@ int val_memory_compare(void *s1, void *s2, uint32_t len)
     const unsigned char *p1 = s1;
     const unsigned char *p2 = s2;
 
+    if ((((uintptr_t)p1 ^ (uintptr_t)p2) & LIBC_WORD_MASK) == 0) {
+        while (len && ((uintptr_t)p1 & LIBC_WORD_MASK)) {
+            if (*p1 != *p2)
+                return (int)(*p1 - *p2);
+            p1++;
+            p2++;
+            len--;
+        }
+        /* Skip equal words, the byte loop below finds the first difference */
+        while (len >= sizeof(uint64_t) &&
+               *(const libc_word_t *)p1 == *(const libc_word_t *)p2) {
+            p1 += sizeof(uint64_t);
+            p2 += sizeof(uint64_t);
+            len -= sizeof(uint64_t);
+        }
+    }
+
     while (len--) {
         if (*p1 != *p2)
             return (int)(*p1 - *p2);
@@ -41,25 +97,143 @@ int val_memory_compare(void *s1, void *s2, uint32_t len)
     return 0;
 }
 
+#ifndef TARGET_LINUX
 /**
-  @brief  Copy memory from source to destination
+  @brief  Check whether FP and SIMD instructions can be used at the current
+          exception level without trapping.
 
-  @param  dst  Destination buffer
-  @param  src  Source buffer
-  @param  len  Number of bytes to copy
+  @return 1 if enabled, 0 otherwise
+**/
+static uint32_t libc_simd_enabled(void)
+{
+    uint64_t cptr;
+
+    if (((read_id_aa64pfr0_el1() >> LIBC_PFR0_ADVSIMD_SHIFT) & LIBC_PFR0_ADVSIMD_MASK) ==
+        LIBC_PFR0_ADVSIMD_NONE)
+        return 0;
+
+    if ((get_current_el() == 2)) {
+        cptr = read_cptr_el2();
+        if (read_hcr_el2() & LIBC_HCR_E2H)
+            return ((cptr >> LIBC_CPACR_FPEN_SHIFT) & LIBC_CPACR_FPEN_MASK) ==
+                   LIBC_CPACR_FPEN_ALL;
+        return (cptr & LIBC_CPTR_TFP) == 0;
+    }
+
+    return ((read_cpacr_el1() >> LIBC_CPACR_FPEN_SHIFT) & LIBC_CPACR_FPEN_MASK) ==
+           LIBC_CPACR_FPEN_ALL;
+}
+#endif
+
+/**
+  @brief  Check whether a copy variant can be used on this PE.
+
+  @param  variant  Copy loop
+
+  @return 1 if the variant can be used, 0 otherwise
+**/
+uint32_t val_memcpy_variant_supported(val_memcpy_variant_t variant)
+{
+    switch (variant) {
+    case VAL_MEMCPY_BYTE:
+    case VAL_MEMCPY_WORD:
+        return 1;
+#ifndef TARGET_LINUX
+    case VAL_MEMCPY_LDP:
+    case VAL_MEMCPY_NT:
+        return 1;
+    case VAL_MEMCPY_SIMD:
+        return libc_simd_enabled();
+#endif
+    default:
+        return 0;
+    }
+}
+
+/**
+  @brief  Copy memory from source to destination with the given loop. An
+          unsupported variant falls back to 64-bit loads and stores.
+
+  @param  dst      Destination buffer
+  @param  src      Source buffer
+  @param  len      Number of bytes to copy
+  @param  variant  Copy loop
 
   @return Pointer to destination buffer
 **/
-void *val_memcpy(void *dst, void *src, uint32_t len)
+void *val_memcpy_variant(void *dst, void *src, uint32_t len, val_memcpy_variant_t variant)
 {
     const unsigned char *s = src;
     unsigned char *d = dst;
+    uint32_t bulk;
+
+    if (variant != VAL_MEMCPY_BYTE &&
+        (((uintptr_t)d ^ (uintptr_t)s) & LIBC_WORD_MASK) == 0) {
+        while (len && ((uintptr_t)d & LIBC_WORD_MASK)) {
+            *d++ = *s++;
+            len--;
+        }
+
+#ifndef TARGET_LINUX
+        bulk = len & ~(uint32_t)(LIBC_BLOCK_SIZE - 1);
+        if (bulk != 0 && variant != VAL_MEMCPY_WORD &&
+            val_memcpy_variant_supported(variant)) {
+            if (variant == VAL_MEMCPY_NT)
+                ValMemCopyNt(d, s, bulk);
+            else if (variant == VAL_MEMCPY_SIMD)
+                ValMemCopySimd(d, s, bulk);
+            else
+                ValMemCopyLdp(d, s, bulk);
+            d += bulk;
+            s += bulk;
+            len -= bulk;
+        }
+#else
+        (void)bulk;
+#endif
+
+        while (len >= sizeof(uint64_t)) {
+            *(libc_word_t *)d = *(const libc_word_t *)s;
+            d += sizeof(uint64_t);
+            s += sizeof(uint64_t);
+            len -= sizeof(uint64_t);
+        }
+    }
 
     while (len--) {
         *d++ = *s++;
     }
 
-    return dst;  // ␛return start of destination
+    return dst;
+}
+
+/**
+  @brief  Copy memory from source to destination
+
+  @param  dst  Destination buffer
+  @param  src  Source buffer
+  @param  len  Number of bytes to copy
+
+  @return Pointer to destination buffer
+**/
+void *val_memcpy(void *dst, void *src, uint32_t len)
+{
+    return val_memcpy_variant(dst, src, len, VAL_MEMCPY_LDP);
+}
+
+/**
+  @brief  Copy memory from source to destination with non-temporal loads and
+          stores, hinting that the data is not reused soon.
+
+  @param  dst  Destination buffer
+  @param  src  Source buffer
+  @param  len  Number of bytes to copy
+
+  @return Pointer to destination buffer
+**/
+void *val_memcpy_nt(void *dst, void *src, uint32_t len)
+{
+    return val_memcpy_variant(dst, src, len, VAL_MEMCPY_NT);
 }
 
 /**
@@ -74,12 +248,98 @@ void *val_memcpy(void *dst, void *src, uint32_t len)
 void val_memory_set(void *dst, uint32_t size, uint8_t value)
 {
     unsigned char *ptr = dst;
+    uint64_t pattern = value * 0x0101010101010101ULL;
+    uint32_t bulk;
+
+    while (size && ((uintptr_t)ptr & LIBC_WORD_MASK)) {
+        *ptr++ = (unsigned char)value;
+        size--;
+    }
+
+#ifndef TARGET_LINUX
+    bulk = size & ~(uint32_t)(LIBC_BLOCK_SIZE - 1);
+    if (bulk != 0) {
+        ValMemSetStp(ptr, bulk, pattern);
+        ptr += bulk;
+        size -= bulk;
+    }
+#else
+    (void)bulk;
+#endif
+
+    while (size >= sizeof(uint64_t)) {
+        *(libc_word_t *)ptr = pattern;
+        ptr += sizeof(uint64_t);
+        size -= sizeof(uint64_t);
+    }
+
     while (size--)
         *ptr++ = (unsigned char)value;
 
     return (void) dst;
 }
 
+/**
+  @brief  Return the DC ZVA block size when DC ZVA can be used on Normal
+          memory at the current exception level.
+
+  @return Block size in bytes, 0 if DC ZVA cannot be used
+**/
+static uint32_t libc_zva_block_size(void)
+{
+#ifndef TARGET_LINUX
+    uint64_t dczid = read_dczid_el0();
+    uint64_t sctlr = (get_current_el() == 2) ? read_sctlr_el2() : read_sctlr_el1();
+
+    /* With the MMU or the data cache off all memory is Device or Non-cacheable */
+    if ((sctlr & (LIBC_SCTLR_M | LIBC_SCTLR_C)) != (LIBC_SCTLR_M | LIBC_SCTLR_C))
+        return 0;
+    if (dczid & LIBC_DCZID_DZP)
+        return 0;
+
+    return 4U << (dczid & LIBC_DCZID_BS_MASK);
+#else
+    return 0;
+#endif
+}
+
+/**
+  @brief  Zero a buffer in Normal cacheable memory, a cache line at a time
+          with DC ZVA where the PE allows it. Use val_memory_set for Device
+          memory.
+
+  @param  dst   Buffer to zero
+  @param  size  Number of bytes to zero
+
+  @return None
+**/
+void val_memory_zero(void *dst, uint32_t size)
+{
+    unsigned char *ptr = dst;
+    uint32_t block = libc_zva_block_size();
+    uint32_t head;
+    uint32_t bulk;
+
+    if (block == 0 || size < 2 * block) {
+        val_memory_set(dst, size, 0);
+        return;
+    }
+
+    head = (uint32_t)(-(uintptr_t)ptr & (block - 1));
+    val_memory_set(ptr, head, 0);
+    ptr += head;
+    size -= head;
+
+    bulk = size & ~(block - 1);
+#ifndef TARGET_LINUX
+    ValMemZeroZva(ptr, bulk, block);
+#endif
+    ptr += bulk;
+    size -= bulk;
+
+    val_memory_set(ptr, size, 0);
+}
+
 /**
   @brief  Compare two strings up to given length
 
@@ -207,3 +467,110 @@ char *val_strncpy(char *dest, const char *src, size_t n)
 
     return ret;
 }
+
+#ifndef TARGET_LINUX
+/**
+  @brief  Print a transfer rate in GB/s with two decimals.
+
+  @param  name   Loop name
+  @param  bytes  Bytes transferred
+  @param  ticks  Generic counter ticks taken
+
+  @return None
+**/
+static void libc_bench_print(const char *name, uint64_t bytes, uint64_t ticks)
+{
+    uint64_t freq = read_cntfrq_el0();
+    uint64_t rate;
+
+    if (ticks == 0 || freq == 0) {
+        val_print(INFO, "\n   %-6s : not measured", name);
+        return;
+    }
+
+    rate = (bytes / ticks) * freq + ((bytes % ticks) * freq) / ticks;
+    val_print(INFO, "\n   %-6s : %4ld.%02ld GB/s", name, rate / 1000000000,
+              (rate % 1000000000) / 10000000);
+}
+
+/**
+  @brief  Measures the bandwidth of each copy loop, val_memory_set and
+          val_memory_zero on the primary PE and prints it in GB/s. The
+          buffers are larger than most last level caches, so the result is
+          close to the memory bandwidth one PE can generate.
+          1. Caller       - Orchestrator, with ACS_MEM_BENCHMARK
+          2. Prerequisite - None
+
+  @param  None
+
+  @return None
+ **/
+void val_memcpy_benchmark(void)
+{
+    static const char *const variant_name[VAL_MEMCPY_VARIANT_COUNT] = {
+        "byte", "word", "ldp", "simd", "nt"
+    };
+    uint32_t size = LIBC_BENCH_SIZE;
+    uint32_t variant;
+    uint32_t rounds;
+    uint32_t round;
+    uint64_t start;
+    uint64_t ticks;
+    void *src = NULL;
+    void *dst = NULL;
+
+    for (; size >= LIBC_BENCH_MIN_SIZE; size /= 2) {
+        src = val_aligned_alloc(MEM_ALIGN_4K, size);
+        dst = val_aligned_alloc(MEM_ALIGN_4K, size);
+        if (src != NULL && dst != NULL)
+            break;
+        if (src != NULL)
+            val_memory_free_aligned(src);
+        if (dst != NULL)
+            val_memory_free_aligned(dst);
+        src = dst = NULL;
+    }
+
+    if (src == NULL) {
+        val_print(WARN, "\n Memory bandwidth: buffers not allocated");
+        return;
+    }
+
+    rounds = (uint32_t)(LIBC_BENCH_TRAFFIC / size);
+    val_print(INFO, "\n Memory bandwidth (%d KB buffers)", size / 1024);
+
+    val_memory_set(src, size, 0x5A);
+    for (variant = 0; variant < VAL_MEMCPY_VARIANT_COUNT; variant++) {
+        if (!val_memcpy_variant_supported(variant)) {
+            val_print(INFO, "\n   %-6s : not available", variant_name[variant]);
+            continue;
+        }
+
+        /* Warm the translations, then time the copies */
+        val_memcpy_variant(dst, src, size, variant);
+        start = virtualcounter_read();
+        for (round = 0; round < rounds; round++)
+            val_memcpy_variant(dst, src, size, variant);
+        ticks = virtualcounter_read() - start;
+
+        if (val_memory_compare(dst, src, size) != 0)
+            val_print(WARN, "\n   %-6s : copy mismatch", variant_name[variant]);
+        else
+            libc_bench_print(variant_name[variant], (uint64_t)rounds * size, ticks);
+    }
+
+    start = virtualcounter_read();
+    for (round = 0; round < rounds; round++)
+        val_memory_set(dst, size, 0xA5);
+    libc_bench_print("set", (uint64_t)rounds * size, virtualcounter_read() - start);
+
+    start = virtualcounter_read();
+    for (round = 0; round < rounds; round++)
+        val_memory_zero(dst, size);
+    libc_bench_print(libc_zva_block_size() ? "zva" : "zero", (uint64_t)rounds * size,
+                     virtualcounter_read() - start);
+
+    val_memory_free_aligned(src);
+    val_memory_free_aligned(dst);
+}
+#endif
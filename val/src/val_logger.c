@@ -7,23 +7,73 @@
 
 #include "val_logger.h"
 #include "acs_execution_policy.h"
+#include "val_interface.h"
+#include "acs_memory.h"
+#ifndef TARGET_LINUX
+#include "acs_timer.h"
+#endif
 
 enum { LOG_MAX_STRING_LENGTH = 90 };
 enum { LOG_MSG_INDENT = 7 };
 enum { LOG_INDENT_WIDTH = 4 };
 
-static bool collect_log_output;
-static char collected_log[LOG_MAX_STRING_LENGTH * 2];
-static size_t collected_log_len;
+/*
+ * One log record being formatted, with the scratch space the formatter needs.
+ * It is too large for the small stacks of secondary PEs, so each PE that
+ * has a log ring formats into the record held in its ring, and other callers
+ * share log_shared_record under log_shared_lock.
+ */
+typedef struct {
+    char   text[LOG_MAX_STRING_LENGTH * 2];
+    size_t len;
+    char   prev;        /* last character, for CRLF conversion */
+    char   msg[LOG_MAX_STRING_LENGTH];    /* format string with CRLF ending */
+    char   num[LOG_MAX_STRING_LENGTH];    /* digits of an integer */
+} log_record_t;
+
+static log_record_t log_shared_record;
+static volatile uint32_t log_shared_lock;
+/* Serializes appends to log_buffer */
+static volatile uint32_t log_buffer_lock;
+
+#ifndef TARGET_LINUX
+/*
+ * Per-PE log rings. Once set up, records printed by a secondary PE are
+ * queued in the ring of that PE with a timestamp, and the primary PE prints
+ * them from val_log_ring_flush(). Each ring has a single producer (its PE)
+ * and a single consumer (the primary PE), so no lock is needed: the producer
+ * publishes with a release store of head and the consumer frees space with a
+ * release store of tail.
+ */
+enum { LOG_RING_SIZE = 0x1000 };         /* bytes per PE, power of two */
+enum { LOG_RING_ALIGN = 16 };
+enum { LOG_RING_PAD = 0xFFFFFFFF };      /* entry length of the wrap filler */
+
+typedef struct {
+    uint64_t timestamp;                  /* CNTVCT when the record was printed */
+    uint32_t len;                        /* text bytes that follow, or LOG_RING_PAD */
+    uint32_t reserved;
+} log_ring_entry_t;
+
+typedef struct {
+    volatile uint32_t head;              /* written by the owning PE */
+    volatile uint32_t tail;              /* written by the primary PE */
+    volatile uint32_t dropped;           /* records lost to a full ring */
+    uint32_t          dropped_reported;
+    char             *buf;
+    log_record_t      record;            /* val_printf record of the owning PE */
+} log_ring_t;
+
+static log_ring_t *log_ring_table;
+static uint32_t log_ring_count;
+static uint64_t log_ring_start_ticks;
+#endif
 
-static void val_putc(char c)
+static void val_putc(log_record_t *rec, char c)
 {
-    if (collect_log_output) {
-        if (collected_log_len + 1 < sizeof(collected_log)) {
-            collected_log[collected_log_len++] = c;
-            collected_log[collected_log_len] = '\0';
-        }
-        return;
+    if (rec->len + 1 < sizeof(rec->text)) {
+        rec->text[rec->len++] = c;
+        rec->text[rec->len] = '\0';
     }
 }
 
@@ -90,27 +140,24 @@ size_t log_buffer_offset;
 char log_buffer[LOG_BUFFER_SIZE];
 
 /**
- *   @brief    - Stores a character in a log buffer and outputs it via 'val_putc'
- *   @param    - c  : Input Character
+ *   @brief    - Appends a character to the record via 'val_putc', with CRLF
+ *               conversion
+ *   @param    - rec  : Record being formatted
+ *             - c    : Input Character
  *   @return   - Sends the character using 'val_putc'
  **/
 
-static void log_putchar(char c)
+static void log_putchar(log_record_t *rec, char c)
 {
-    static char prev;
-
-    log_buffer[log_buffer_offset] = c;
-    log_buffer_offset = (log_buffer_offset + 1) % LOG_BUFFER_SIZE;
-
     /* If we are about to print '\n' and the previous char wasn't '\r',
      * inject '\r' so UART terminals go back to column 0. */
-    if (c == '\n' && prev != '\r') {
+    if (c == '\n' && rec->prev != '\r') {
         char cr = '\r';
-        val_putc(cr);
+        val_putc(rec, cr);
     }
 
-    val_putc(c);
-    prev = c;
+    val_putc(rec, c);
+    rec->prev = c;
 }
 
 /**
@@ -138,16 +185,17 @@ static size_t log_strnlen_s(const char *str, size_t strsz)
 
 /**
  *   @brief    - Prints a literal string (i.e. '%' is not interpreted specially) to the debug log
- *   @param    - str    : Input literal String
+ *   @param    - rec    : Record being formatted
+ *             - str    : Input literal String
  *   @return   - Number of characters written
  **/
 
-static size_t print_raw_string(const char *str)
+static size_t print_raw_string(log_record_t *rec, const char *str)
 {
     const char *c = str;
 
     for (; *c != '\0'; c++) {
-        log_putchar(*c);
+        log_putchar(rec, *c);
     }
 
     return (size_t)(c - str);
@@ -171,7 +219,7 @@ void val_log_set_indent(uint32_t indent)
     acs_policy_set_log_indent(indent);
 }
 
-static size_t print_log_indent(void)
+static size_t print_log_indent(log_record_t *rec)
 {
     static const char indent_unit[LOG_INDENT_WIDTH + 1] = "    ";
     size_t chars_written = 0;
@@ -179,21 +227,22 @@ static size_t print_log_indent(void)
     uint32_t indent = acs_policy_get_log_indent();
 
     for (i = 0; i < indent; i++)
-        chars_written += print_raw_string(indent_unit);
+        chars_written += print_raw_string(rec, indent_unit);
 
     return chars_written;
 }
 
 /**
  *   @brief    - Prints a formatted string to the debug log
- *   @param    - str        : The full String
+ *   @param    - rec        : Record being formatted
+ *             - str        : The full String
  *             - suffix     : Pointer within str that indicates where suffix begins
  *             - min_width  : Minimum width
  *             - flags      : Whether to align to left or right
  *             - fill       : The fill character
  *   @return   - Number of characters written
  **/
-static size_t print_string(const char *str, const char *suffix,
+static size_t print_string(log_record_t *rec, const char *str, const char *suffix,
                int min_width, struct format_flags *flags,
                char fill)
 {
@@ -206,14 +255,14 @@ static size_t print_string(const char *str, const char *suffix,
         /* Left-aligned: prefix + suffix, then pad with spaces */
         while (str != suffix) {
             chars_written++;
-            log_putchar(*str++);
+            log_putchar(rec, *str++);
         }
 
-        chars_written += print_raw_string(suffix);
+        chars_written += print_raw_string(rec, suffix);
 
         while (total_len < (size_t)min_width) {
             chars_written++;
-            log_putchar(' ');
+            log_putchar(rec, ' ');
             total_len++;
         }
         return chars_written;
@@ -224,52 +273,52 @@ static size_t print_string(const char *str, const char *suffix,
         /* Space padding goes BEFORE prefix/sign */
         while (total_len < (size_t)min_width) {
             chars_written++;
-            log_putchar(' ');
+            log_putchar(rec, ' ');
             total_len++;
         }
 
         /* Now print prefix and suffix */
         while (str != suffix) {
             chars_written++;
-            log_putchar(*str++);
+            log_putchar(rec, *str++);
         }
-        chars_written += print_raw_string(suffix);
+        chars_written += print_raw_string(rec, suffix);
         return chars_written;
     }
 
     /* Zero padding (or other fill) goes AFTER prefix, BEFORE digits */
     while (str != suffix) {
         chars_written++;
-        log_putchar(*str++);
+        log_putchar(rec, *str++);
     }
 
     while (total_len < (size_t)min_width) {
         chars_written++;
-        log_putchar(fill);
+        log_putchar(rec, fill);
         total_len++;
     }
 
-    chars_written += print_raw_string(suffix);
+    chars_written += print_raw_string(rec, suffix);
     return chars_written;
 }
 
 /**
  *   @brief    - Prints an integer to the debug log
- *   @param    - value      : Integer to be formatted and printed
+ *   @param    - rec        : Record being formatted
+ *             - value      : Integer to be formatted and printed
  *             - base       : Base of the integer
  *             - min_width  : Minimum width of the integer
  *             - flags      : Printf-style flags
  *   @return   - Number of characters written
  **/
 
-static size_t print_int(size_t value, enum format_base base, int min_width,
+static size_t print_int(log_record_t *rec, size_t value, enum format_base base, int min_width,
             struct format_flags *flags)
 {
     static const char *digits_lower = "0123456789abcdefxb";
     static const char *digits_upper = "0123456789ABCDEFXB";
     const char *digits = flags->upper ? digits_upper : digits_lower;
-    char buf[LOG_MAX_STRING_LENGTH];
-    char *ptr = &buf[sizeof(buf) - 1];
+    char *ptr = &rec->num[sizeof(rec->num) - 1];
     char *num;
     *ptr = '\0';
     do {
@@ -315,7 +364,7 @@ static size_t print_int(size_t value, enum format_base base, int min_width,
     } else if (flags->space) {
         *--ptr = ' ';
     }
-    return print_string(ptr, num, min_width, flags, flags->zero ? '0' : ' ');
+    return print_string(rec, ptr, num, min_width, flags, flags->zero ? '0' : ' ');
 }
 
 /**
@@ -511,12 +560,13 @@ static uint64_t reinterpret_signed_int(enum format_length length, uint64_t value
 
 /**
  *   @brief    - This function parses and formats a string according to specified format specifiers
- *   @param    - fmt      : Input String
+ *   @param    - rec      : Record being formatted
+ *             - fmt      : Input String
  *             - args     : Arguments are passed as a va_list
  *   @return   - Number of characters written, or `-1` if format string is invalid
  **/
 
-static int val_log(const char *fmt, va_list args)
+static int val_log(log_record_t *rec, const char *fmt, va_list args)
 {
     int chars_written = 0;
 
@@ -524,7 +574,7 @@ static int val_log(const char *fmt, va_list args)
         switch (*fmt) {
         default:
             chars_written++;
-            log_putchar(*fmt);
+            log_putchar(rec, *fmt);
             fmt++;
             break;
 
@@ -549,14 +599,14 @@ static int val_log(const char *fmt, va_list args)
             case '%':
                 fmt++;
                 chars_written++;
-                log_putchar('%');
+                log_putchar(rec, '%');
                 break;
 
             case 'c': {
                 char str[2] = {(char)va_arg(args, int), 0};
 
                 fmt++;
-                chars_written += print_string(
+                chars_written += print_string(rec,
                     str, str, min_width, &flags, ' ');
                 break;
             }
@@ -567,7 +617,7 @@ static int val_log(const char *fmt, va_list args)
                     str = "(null)";
 
                 fmt++;
-                chars_written += print_string(
+                chars_written += print_string(rec,
                     str, str, min_width, &flags, ' ');
                 break;
             }
@@ -585,7 +635,7 @@ static int val_log(const char *fmt, va_list args)
                 value = reinterpret_signed_int(length, value,
                                    &flags);
 
-                chars_written += print_int(value, base10,
+                chars_written += print_int(rec, value, base10,
                                min_width, &flags);
                 break;
             }
@@ -601,7 +651,7 @@ static int val_log(const char *fmt, va_list args)
                  }
                 value = reinterpret_unsigned_int(length, value);
 
-                chars_written += print_int(value, base2,
+                chars_written += print_int(rec, value, base2,
                                min_width, &flags);
                 break;
 
@@ -617,7 +667,7 @@ static int val_log(const char *fmt, va_list args)
                 }
                 value = reinterpret_unsigned_int(length, value);
 
-                chars_written += print_int(value, base2,
+                chars_written += print_int(rec, value, base2,
                                min_width, &flags);
                 break;
 
@@ -632,7 +682,7 @@ static int val_log(const char *fmt, va_list args)
                 }
                 value = reinterpret_unsigned_int(length, value);
 
-                chars_written += print_int(value, base8,
+                chars_written += print_int(rec, value, base8,
                                min_width, &flags);
                 break;
 
@@ -647,7 +697,7 @@ static int val_log(const char *fmt, va_list args)
                 }
                 value = reinterpret_unsigned_int(length, value);
 
-                chars_written += print_int(value, base16,
+                chars_written += print_int(rec, value, base16,
                                min_width, &flags);
                 break;
 
@@ -663,7 +713,7 @@ static int val_log(const char *fmt, va_list args)
                 }
                 value = reinterpret_unsigned_int(length, value);
 
-                chars_written += print_int(value, base16,
+                chars_written += print_int(rec, value, base16,
                                min_width, &flags);
                 break;
 
@@ -678,7 +728,7 @@ static int val_log(const char *fmt, va_list args)
                 }
                 value = reinterpret_unsigned_int(length, value);
 
-                chars_written += print_int(value, base10,
+                chars_written += print_int(rec, value, base10,
                                min_width, &flags);
                 break;
 
@@ -689,7 +739,7 @@ static int val_log(const char *fmt, va_list args)
                 flags.zero = true;
                 flags.alt = true;
 
-                chars_written += print_int(value, base16,
+                chars_written += print_int(rec, value, base16,
                                min_width, &flags);
                 break;
 
@@ -705,31 +755,163 @@ out:
     return chars_written;
 }
 
+#ifndef TARGET_LINUX
 /**
- *   @brief    - This function prints the given string and data onto the uart
- *   @param    - verbosity  : Print Verbosity level
- *             - msg        : Input String
- *             - ...        : ellipses for variadic args
- *   @return   - SUCCESS((Any positive number for character written)/FAILURE(0)
+ *   @brief    - Formats into a record that is already being built
+ *   @param    - rec  : Record to append to
+ *             - fmt  : Format string
+ *             - ...  : Arguments for the format string
+ *   @return   - None
  **/
 
-uint32_t val_printf(print_verbosity_t verbosity, const char *msg, ...)
+static void log_record_printf(log_record_t *rec, const char *fmt, ...)
 {
-    int chars_written = 0;
-    int log_result;
-    char formatted_msg[LOG_MAX_STRING_LENGTH];
-    bool new_log_record;
     va_list args;
 
-    if (msg == NULL)
-        return 0;
+    va_start(args, fmt);
+    (void)val_log(rec, fmt, args);
+    va_end(args);
+}
 
-    if (*msg == '\0')
-        return 0;
+static inline uint32_t log_ring_load_acquire(volatile uint32_t *addr)
+{
+    uint32_t value;
 
-    collect_log_output = true;
-    collected_log_len = 0;
-    collected_log[0] = '\0';
+    __asm__ volatile("ldar %w0, [%1]\n" : "=r"(value) : "r"(addr) : "memory");
+    return value;
+}
+
+static inline void log_ring_store_release(volatile uint32_t *addr, uint32_t value)
+{
+    __asm__ volatile("stlr %w0, [%1]\n" : : "r"(value), "r"(addr) : "memory");
+}
+
+static inline uint32_t log_ring_entry_size(uint32_t len)
+{
+    return ((uint32_t)sizeof(log_ring_entry_t) + len + LOG_RING_ALIGN - 1) &
+           ~(uint32_t)(LOG_RING_ALIGN - 1);
+}
+
+/**
+ *   @brief    - Queues a record in the ring of the printing PE, never waits
+ *               for the consumer; the record is dropped if the ring is full
+ *   @param    - ring  : Ring of the printing PE
+ *             - text  : Record text
+ *             - len   : Number of characters in text
+ *   @return   - None
+ **/
+
+static void log_ring_push(log_ring_t *ring, const char *text, uint32_t len)
+{
+    log_ring_entry_t *entry;
+    uint32_t head = ring->head;
+    uint32_t tail = log_ring_load_acquire(&ring->tail);
+    uint32_t need = log_ring_entry_size(len);
+    uint32_t room = LOG_RING_SIZE - (head & (LOG_RING_SIZE - 1));
+    uint32_t total = (room < need) ? room + need : need;
+
+    if ((head - tail) + total > LOG_RING_SIZE) {
+        ring->dropped++;
+        return;
+    }
+
+    /* Entries are contiguous, pad up to the end of the ring and wrap */
+    if (room < need) {
+        entry = (log_ring_entry_t *)(ring->buf + (head & (LOG_RING_SIZE - 1)));
+        entry->len = LOG_RING_PAD;
+        head += room;
+    }
+
+    entry = (log_ring_entry_t *)(ring->buf + (head & (LOG_RING_SIZE - 1)));
+    entry->timestamp = virtualcounter_read();
+    entry->len = len;
+    val_mem_copy((char *)(entry + 1), text, len);
+
+    log_ring_store_release(&ring->head, head + need);
+}
+
+/**
+ *   @brief    - Returns the oldest unprinted record of a ring
+ *   @param    - ring  : Ring to read
+ *   @return   - Record, NULL if the ring is empty
+ **/
+
+static log_ring_entry_t *log_ring_peek(log_ring_t *ring)
+{
+    log_ring_entry_t *entry;
+    uint32_t head = log_ring_load_acquire(&ring->head);
+    uint32_t tail = ring->tail;
+
+    while (tail != head) {
+        entry = (log_ring_entry_t *)(ring->buf + (tail & (LOG_RING_SIZE - 1)));
+        if (entry->len != LOG_RING_PAD)
+            return entry;
+
+        tail += LOG_RING_SIZE - (tail & (LOG_RING_SIZE - 1));
+        log_ring_store_release(&ring->tail, tail);
+    }
+
+    return NULL;
+}
+#endif
+
+/**
+ *   @brief    - Sends the collected log record to its destination
+ *   @param    - rec  : Formatted record
+ *   @return   - None
+ **/
+
+static void log_flush_record(log_record_t *rec)
+{
+#ifndef TARGET_LINUX
+    uint32_t index;
+#endif
+    size_t i;
+
+    if (rec->len == 0)
+        return;
+
+    /* One lock per record, the test reading log_buffer sees whole records */
+    val_pe_spin_lock(&log_buffer_lock);
+    for (i = 0; i < rec->len; i++) {
+        log_buffer[log_buffer_offset] = rec->text[i];
+        log_buffer_offset = (log_buffer_offset + 1) % LOG_BUFFER_SIZE;
+    }
+    val_pe_spin_unlock(&log_buffer_lock);
+
+#ifndef TARGET_LINUX
+    if (log_ring_table != NULL) {
+        index = val_pe_get_index_mpid(val_pe_get_mpid());
+        if (index < log_ring_count && index != val_pe_get_primary_index()) {
+            log_ring_push(&log_ring_table[index], rec->text, (uint32_t)rec->len);
+            return;
+        }
+    }
+#endif
+
+    pal_print((uint64_t)(uintptr_t)rec->text);
+}
+
+/**
+ *   @brief    - Formats one log record and sends it via log_flush_record
+ *   @param    - rec        : Record to format into
+ *             - verbosity  : Print Verbosity level
+ *             - msg        : Input String, not NULL or empty
+ *             - args       : Arguments for the format string
+ *   @return   - Number of characters written, 0 on failure
+ **/
+
+static uint32_t log_vprintf(log_record_t *rec, print_verbosity_t verbosity, const char *msg,
+                            va_list args)
+{
+    int chars_written = 0;
+    int log_result;
+    char *formatted_msg = rec->msg;
+    bool new_log_record;
+
+    rec->len = 0;
+    rec->prev = '\0';
+    rec->text[0] = '\0';
 
     new_log_record = (*msg == '\n');
 
@@ -738,41 +920,39 @@ uint32_t val_printf(print_verbosity_t verbosity, const char *msg, ...)
      * are explicit spacing; do not synthesize a leading newline for callers.
      */
     while (*msg == '\n') {
-        chars_written += (int)print_raw_string("\r\n");
+        chars_written += (int)print_raw_string(rec, "\r\n");
         msg++;
     }
 
     /* If msg was only newlines */
     if (*msg == '\0') {
-        collect_log_output = false;
-        if (collected_log_len > 0)
-            pal_print((uint64_t)(uintptr_t)collected_log);
+        log_flush_record(rec);
         return 0;
     }
 
     /* Only messages that start with a caller-supplied newline start a log record. */
     if (new_log_record) {
         skip_log_indent(&msg);
-        chars_written += (int)print_log_indent();
+        chars_written += (int)print_log_indent(rec);
 
         switch (verbosity)
         {
             case TRACE:
-                 chars_written += (int)print_raw_string("   ");
+                 chars_written += (int)print_raw_string(rec, "   ");
                  break;
             case DEBUG:
-                 chars_written += (int)print_raw_string("   ");
+                 chars_written += (int)print_raw_string(rec, "   ");
                  break;
             case INFO:
                  break;
             case WARN:
-                 chars_written += (int)print_raw_string("   WARN : ");
+                 chars_written += (int)print_raw_string(rec, "   WARN : ");
                  break;
             case ERROR:
-                 chars_written += (int)print_raw_string("   ERROR: ");
+                 chars_written += (int)print_raw_string(rec, "   ERROR: ");
                  break;
             case FATAL:
-                 chars_written += (int)print_raw_string("   FATAL: ");
+                 chars_written += (int)print_raw_string(rec, "   FATAL: ");
                  break;
             default:
                  break;
@@ -783,8 +963,6 @@ uint32_t val_printf(print_verbosity_t verbosity, const char *msg, ...)
     const size_t max_scan = LOG_MAX_STRING_LENGTH - 2;
     size_t len = log_strnlen_s(msg, max_scan);
 
-    va_start(args, msg);
-
     /*
      * 3 cases:
      *  A) msg ends with '\n', convert final LF to CRLF
@@ -800,7 +978,7 @@ uint32_t val_printf(print_verbosity_t verbosity, const char *msg, ...)
         formatted_msg[len]     = '\n';
         formatted_msg[len + 1] = '\0';
 
-        log_result = val_log(formatted_msg, args);
+        log_result = val_log(rec, formatted_msg, args);
         if (log_result < 0) {
             chars_written = log_result;
         } else {
@@ -822,16 +1000,16 @@ uint32_t val_printf(print_verbosity_t verbosity, const char *msg, ...)
         formatted_msg[perm_len] = '\0';
 
         if (perm_len > 0)
-            chars_written += (int)print_raw_string(formatted_msg);
+            chars_written += (int)print_raw_string(rec, formatted_msg);
 
-        chars_written += (int)print_raw_string(trunc_msg);
+        chars_written += (int)print_raw_string(rec, trunc_msg);
 
      }
 
     /* Case C: short, no trailing '\n' */
     else
     {
-        log_result = val_log(msg, args);
+        log_result = val_log(rec, msg, args);
         if (log_result < 0) {
             chars_written = log_result;
         } else {
@@ -839,19 +1017,219 @@ uint32_t val_printf(print_verbosity_t verbosity, const char *msg, ...)
         }
     }
 
-    va_end(args);
-
-    collect_log_output = false;
-
     if (chars_written < 0)
     return 0;
 
-    if (collected_log_len > 0)
-        pal_print((uint64_t)(uintptr_t)collected_log);
+    log_flush_record(rec);
 
     return (uint32_t)chars_written;
 }
 
+/**
+ *   @brief    - This function prints the given string and data onto the uart
+ *   @param    - verbosity  : Print Verbosity level
+ *             - msg        : Input String
+ *             - ...        : ellipses for variadic args
+ *   @return   - SUCCESS((Any positive number for character written)/FAILURE(0)
+ **/
+
+uint32_t val_printf(print_verbosity_t verbosity, const char *msg, ...)
+{
+    uint32_t chars_written;
+    va_list args;
+#ifndef TARGET_LINUX
+    log_ring_t *table = log_ring_table;
+    uint32_t index;
+#endif
+
+    if (msg == NULL)
+        return 0;
+
+    if (*msg == '\0')
+        return 0;
+
+    va_start(args, msg);
+#ifndef TARGET_LINUX
+    /* Each PE with a log ring formats into its own record, without a lock */
+    if (table != NULL) {
+        index = val_pe_get_index_mpid(val_pe_get_mpid());
+        if (index < log_ring_count) {
+            chars_written = log_vprintf(&table[index].record, verbosity, msg, args);
+            va_end(args);
+            return chars_written;
+        }
+    }
+#endif
+    val_pe_spin_lock(&log_shared_lock);
+    chars_written = log_vprintf(&log_shared_record, verbosity, msg, args);
+    val_pe_spin_unlock(&log_shared_lock);
+    va_end(args);
+
+    return chars_written;
+}
+
+/**
+ *   @brief    - Prints previously queued log text, in chunks pal_print can take
+ *   @param    - buf  : Captured text
+ *             - len  : Number of characters in buf
+ *   @return   - None
+ **/
+
+void val_log_replay(const char *buf, uint32_t len)
+{
+    char chunk[LOG_MAX_STRING_LENGTH * 2];
+    uint32_t n;
+
+    while (len > 0) {
+        n = (len < sizeof(chunk) - 1) ? len : (uint32_t)(sizeof(chunk) - 1);
+        val_mem_copy(chunk, buf, n);
+        chunk[n] = '\0';
+        pal_print((uint64_t)(uintptr_t)chunk);
+        buf += n;
+        len -= n;
+    }
+}
+
+/**
+ *   @brief    - Sets up a log ring for each PE, after which records printed by
+ *               secondary PEs are queued instead of printed
+ *   @param    - num_pe  : Number of PEs
+ *   @return   - ACS_STATUS_PASS on success, ACS_STATUS_ERR if out of memory
+ **/
+
+uint32_t val_log_ring_init(uint32_t num_pe)
+{
+#ifndef TARGET_LINUX
+    log_ring_t *table;
+    char *buf;
+    uint32_t i;
+
+    if (log_ring_table != NULL || num_pe == 0)
+        return ACS_STATUS_PASS;
+
+    table = val_memory_calloc(num_pe, sizeof(log_ring_t));
+    buf = val_aligned_alloc(LOG_RING_ALIGN, num_pe * LOG_RING_SIZE);
+    if (table == NULL || buf == NULL) {
+        if (table != NULL)
+            val_memory_free(table);
+        if (buf != NULL)
+            val_memory_free_aligned(buf);
+        return ACS_STATUS_ERR;
+    }
+
+    for (i = 0; i < num_pe; i++)
+        table[i].buf = buf + (i * LOG_RING_SIZE);
+
+    log_ring_start_ticks = virtualcounter_read();
+    log_ring_count = num_pe;
+    /* Publish the rings only once they are set up */
+    val_mem_issue_dsb();
+    log_ring_table = table;
+#else
+    (void)num_pe;
+#endif
+
+    return ACS_STATUS_PASS;
+}
+
+/**
+ *   @brief    - Prints the records queued by secondary PEs in time order, each
+ *               line tagged with the PE index and the time since the rings were
+ *               set up. Only the primary PE prints, calls from other PEs return.
+ *   @param    - None
+ *   @return   - None
+ **/
+
+void val_log_ring_flush(void)
+{
+#ifndef TARGET_LINUX
+    log_ring_entry_t *entry;
+    log_ring_entry_t *oldest;
+    log_ring_t *ring;
+    log_record_t tag;
+    const char *text;
+    uint32_t oldest_index = 0;
+    uint32_t index;
+    uint32_t dropped;
+    uint32_t i;
+    uint64_t freq;
+    uint64_t ticks;
+
+    if (log_ring_table == NULL ||
+        val_pe_get_index_mpid(val_pe_get_mpid()) != val_pe_get_primary_index())
+        return;
+
+    freq = read_cntfrq_el0();
+
+    while (1) {
+        oldest = NULL;
+        for (index = 0; index < log_ring_count; index++) {
+            entry = log_ring_peek(&log_ring_table[index]);
+            if (entry != NULL && (oldest == NULL || entry->timestamp < oldest->timestamp)) {
+                oldest = entry;
+                oldest_index = index;
+            }
+        }
+        if (oldest == NULL)
+            break;
+
+        /* Tag records that start a new line, continuations follow as is */
+        text = (const char *)(oldest + 1);
+        tag.len = 0;
+        tag.prev = '\0';
+        tag.text[0] = '\0';
+        for (i = 0; i < oldest->len && (text[i] == '\r' || text[i] == '\n'); i++)
+            val_putc(&tag, text[i]);
+        if (i != 0 && freq != 0) {
+            ticks = oldest->timestamp - log_ring_start_ticks;
+            log_record_printf(&tag, "[PE %d +%ldus] ", oldest_index,
+                              ((ticks / freq) * 1000000) + (((ticks % freq) * 1000000) / freq));
+        }
+        if (tag.len != 0)
+            pal_print((uint64_t)(uintptr_t)tag.text);
+        val_log_replay(text + i, oldest->len - i);
+
+        ring = &log_ring_table[oldest_index];
+        log_ring_store_release(&ring->tail, ring->tail + log_ring_entry_size(oldest->len));
+    }
+
+    for (index = 0; index < log_ring_count; index++) {
+        ring = &log_ring_table[index];
+        dropped = ring->dropped;
+        if (dropped != ring->dropped_reported) {
+            val_print(WARN, "\n       PE %d log ring full,", index);
+            val_print(WARN, " %d records dropped", dropped - ring->dropped_reported);
+            ring->dropped_reported = dropped;
+        }
+    }
+#endif
+}
+
+/**
+ *   @brief    - Prints what is left in the log rings and releases them, after
+ *               which secondary PEs print directly again
+ *   @param    - None
+ *   @return   - None
+ **/
+
+void val_log_ring_release(void)
+{
+#ifndef TARGET_LINUX
+    log_ring_t *table = log_ring_table;
+
+    if (table == NULL)
+        return;
+
+    val_log_ring_flush();
+    log_ring_table = NULL;
+    log_ring_count = 0;
+    val_mem_issue_dsb();
+
+    val_memory_free_aligned(table[0].buf);
+    val_memory_free(table);
+#endif
+}
+
 /**
   @brief  Copy memory from source to destination
 
@@ -16,12 +16,23 @@
 
 #include "include/val_interface.h"
 #include "include/val_status.h"
+#include "include/acs_val.h"
 #include "val_logger.h"
+#ifndef TARGET_LINUX
+#include "acs_common.h"
+#include "val_sysreg.h"
 
-/* Map shared memory as an array of status records */
-static inline volatile val_test_status_t *val_get_shared_address(void)
+/*
+ * Bumped each time a PE stores a result that is not pending, the waiter of
+ * val_wait_for_test_completion() only scans the status records when it moves.
+ */
+static volatile uint32_t g_status_done_seq;
+#endif
+
+/* Status record in the shared mailbox of a PE */
+static inline volatile val_test_status_t *val_get_status_record(uint32_t index)
 {
-    return (volatile val_test_status_t *)val_get_status_region_base();
+    return &val_shared_mem_entry(index)->status;
 }
 
 /**
@@ -35,19 +46,48 @@ static inline volatile val_test_status_t *val_get_shared_address(void)
  */
 void val_set_status(uint32_t index, uint32_t test_res)
 {
-    volatile val_test_status_t *mem = val_get_shared_address();
+    volatile val_test_status_t *mem;
 
     if (index >= val_pe_get_num()) {
         val_print(ERROR, "\n       val_set_status: invalid PE index %u",
                   (unsigned int)index);
         return;
     }
-    mem[index].index = index;
-    mem[index].state = (uint8_t)GET_STATE(test_res);
-    mem[index].status_code = (uint16_t)GET_CODE(test_res);
-    val_data_cache_ops_by_va((addr_t)&mem[index], CLEAN_AND_INVALIDATE);
+    mem = val_get_status_record(index);
+    mem->index = index;
+    mem->state = (uint8_t)GET_STATE(test_res);
+    mem->status_code = (uint16_t)GET_CODE(test_res);
+    val_data_cache_ops_by_va((addr_t)mem, CLEAN_AND_INVALIDATE);
+
+#ifndef TARGET_LINUX
+    /* Result is visible before the release of the bump, then wake the waiter.
+     * With the MMU off the bump is a plain add, two PEs racing on it still
+     * change the value, which is all the waiter looks at.
+     */
+    if (GET_STATE(test_res) != TEST_PENDING_VAL) {
+        val_pe_atomic_add(&g_status_done_seq, 1);
+        dsbish();
+        sev();
+    }
+#endif
 }
 
+#ifndef TARGET_LINUX
+/**
+ * @brief Returns the count of non-pending results stored so far.
+ *
+ * The value only matters by changing, a waiter compares it against an
+ * earlier read to know whether a PE completed in between.
+ *
+ * @return Completion sequence number.
+ */
+uint32_t val_status_get_done_seq(void)
+{
+    val_data_cache_ops_by_va((addr_t)&g_status_done_seq, CLEAN_AND_INVALIDATE);
+    return g_status_done_seq;
+}
+#endif
+
 /**
  * @brief Retrieves encoded test result for a PE.
  *
@@ -60,15 +100,32 @@ void val_set_status(uint32_t index, uint32_t test_res)
  */
 uint32_t val_get_status(uint32_t index)
 {
-    volatile val_test_status_t *mem = val_get_shared_address();
+    volatile val_test_status_t *mem;
 
     if (index >= val_pe_get_num()) {
         val_print(ERROR, "\n       val_get_status: invalid PE index %u",
                   (unsigned int)index);
         return RESULT_UNKNOWN;
     }
-    val_data_cache_ops_by_va((addr_t)&mem[index], INVALIDATE);
-    return GENERATE_TEST_RESULT(mem[index].state, mem[index].status_code);
+    mem = val_get_status_record(index);
+    val_data_cache_ops_by_va((addr_t)mem, CLEAN_AND_INVALIDATE);
+    return GENERATE_TEST_RESULT(mem->state, mem->status_code);
+}
+
+/**
+ * @brief Retrieves encoded test result for a PE without cache maintenance.
+ *
+ * For readers scanning many PEs, after one val_shared_mem_sync_all().
+ *
+ * @param index  PE (Processing Element) index.
+ *
+ * @return Encoded test result (state + status code).
+ */
+uint32_t val_get_status_nosync(uint32_t index)
+{
+    volatile val_test_status_t *mem = val_get_status_record(index);
+
+    return GENERATE_TEST_RESULT(mem->state, mem->status_code);
 }
 
 /**
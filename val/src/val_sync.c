@@ -0,0 +1,565 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+#ifndef TARGET_LINUX
+
+#include "acs_common.h"
+#include "val_interface.h"
+#include "val_status.h"
+#include "val_logger.h"
+#include "val_sync.h"
+#include "val_sysreg.h"
+#include "val_sysreg_pe.h"
+#include "val_sysreg_timer.h"
+
+#define SYNC_BENCH_ROUNDS         1000
+
+static inline uint32_t
+sync_load_acquire32(volatile uint32_t *addr)
+{
+  uint32_t value;
+
+  __asm__ volatile("ldar %w0, [%1]" : "=r"(value) : "r"(addr) : "memory");
+  return value;
+}
+
+static inline uint64_t
+sync_load_acquire64(volatile uint64_t *addr)
+{
+  uint64_t value;
+
+  __asm__ volatile("ldar %0, [%1]" : "=r"(value) : "r"(addr) : "memory");
+  return value;
+}
+
+static inline void
+sync_store_release32(volatile uint32_t *addr, uint32_t value)
+{
+  __asm__ volatile("stlr %w0, [%1]" : : "r"(value), "r"(addr) : "memory");
+}
+
+static inline void
+sync_store_release64(volatile uint64_t *addr, uint64_t value)
+{
+  __asm__ volatile("stlr %0, [%1]" : : "r"(value), "r"(addr) : "memory");
+}
+
+/**
+  @brief  Atomically adds to a 32-bit word shared between PEs, with acquire
+          and release semantics. Same as val_pe_atomic_add().
+          1. Caller       - VAL, test payloads
+          2. Prerequisite - None
+
+  @param  addr   Address of the word
+  @param  value  Value to add
+
+  @return Value of the word before the addition
+ **/
+uint32_t
+val_sync_atomic_add32(volatile uint32_t *addr, uint32_t value)
+{
+  return val_pe_atomic_add(addr, value);
+}
+
+/**
+  @brief  Atomically adds to a 64-bit counter shared between PEs, with
+          acquire and release semantics.
+          1. Caller       - VAL, test payloads
+          2. Prerequisite - MMU and caches enabled on the calling PE
+
+  @param  addr   Address of the counter
+  @param  value  Value to add
+
+  @return Value of the counter before the addition
+ **/
+uint64_t
+val_sync_atomic_add64(volatile uint64_t *addr, uint64_t value)
+{
+  uint64_t old, tmp;
+  uint32_t fail;
+
+  if (val_pe_has_lse_atomics()) {
+      __asm__ volatile(
+          ".arch_extension lse\n"
+          "ldaddal %1, %0, [%2]\n"
+          : "=r"(old)
+          : "r"(value), "r"(addr)
+          : "memory");
+      return old;
+  }
+
+  __asm__ volatile(
+      "1: ldaxr %0, [%3]\n"
+      "   add   %1, %0, %4\n"
+      "   stlxr %w2, %1, [%3]\n"
+      "   cbnz  %w2, 1b\n"
+      : "=&r"(old), "=&r"(tmp), "=&r"(fail)
+      : "r"(addr), "r"(value)
+      : "memory");
+
+  return old;
+}
+
+/**
+  @brief  Atomically keeps the unsigned minimum of a 64-bit word shared
+          between PEs and a value.
+          1. Caller       - VAL, test payloads
+          2. Prerequisite - MMU and caches enabled on the calling PE
+
+  @param  addr   Address of the word
+  @param  value  Value to compare
+
+  @return Value of the word before the operation
+ **/
+uint64_t
+val_sync_atomic_min64(volatile uint64_t *addr, uint64_t value)
+{
+  uint64_t old, tmp;
+  uint32_t fail;
+
+  if (val_pe_has_lse_atomics()) {
+      __asm__ volatile(
+          ".arch_extension lse\n"
+          "lduminal %1, %0, [%2]\n"
+          : "=r"(old)
+          : "r"(value), "r"(addr)
+          : "memory");
+      return old;
+  }
+
+  __asm__ volatile(
+      "1: ldaxr %0, [%3]\n"
+      "   cmp   %0, %4\n"
+      "   csel  %1, %0, %4, ls\n"
+      "   stlxr %w2, %1, [%3]\n"
+      "   cbnz  %w2, 1b\n"
+      : "=&r"(old), "=&r"(tmp), "=&r"(fail)
+      : "r"(addr), "r"(value)
+      : "cc", "memory");
+
+  return old;
+}
+
+/**
+  @brief  Atomically keeps the unsigned maximum of a 64-bit word shared
+          between PEs and a value.
+          1. Caller       - VAL, test payloads
+          2. Prerequisite - MMU and caches enabled on the calling PE
+
+  @param  addr   Address of the word
+  @param  value  Value to compare
+
+  @return Value of the word before the operation
+ **/
+uint64_t
+val_sync_atomic_max64(volatile uint64_t *addr, uint64_t value)
+{
+  uint64_t old, tmp;
+  uint32_t fail;
+
+  if (val_pe_has_lse_atomics()) {
+      __asm__ volatile(
+          ".arch_extension lse\n"
+          "ldumaxal %1, %0, [%2]\n"
+          : "=r"(old)
+          : "r"(value), "r"(addr)
+          : "memory");
+      return old;
+  }
+
+  __asm__ volatile(
+      "1: ldaxr %0, [%3]\n"
+      "   cmp   %0, %4\n"
+      "   csel  %1, %0, %4, hs\n"
+      "   stlxr %w2, %1, [%3]\n"
+      "   cbnz  %w2, 1b\n"
+      : "=&r"(old), "=&r"(tmp), "=&r"(fail)
+      : "r"(addr), "r"(value)
+      : "cc", "memory");
+
+  return old;
+}
+
+/**
+  @brief  Sets up a barrier for a number of PEs. The barrier can be used for
+          any number of rounds, but must be set up again after a timeout.
+          1. Caller       - Test payload on the primary PE
+          2. Prerequisite - None, before any PE uses the barrier
+
+  @param  barrier  Barrier to set up
+  @param  num_pe   Number of PEs taking part, including the caller if it does
+
+  @return None
+ **/
+void
+val_sync_barrier_init(val_sync_barrier_t *barrier, uint32_t num_pe)
+{
+  barrier->count = 0;
+  barrier->sense = 0;
+  barrier->num_pe = num_pe;
+  val_pe_cache_clean_invalidate_range((uint64_t)(uintptr_t)barrier, sizeof(*barrier));
+}
+
+/**
+  @brief  Arrives at a barrier in the round given by its sense. The last PE
+          of the round stores reset_value to reset, if not NULL, before it
+          releases the others.
+
+  @param  barrier      Barrier to arrive at
+  @param  sense        Sense of the barrier read before arriving
+  @param  reset        Word to reset for the next round, or NULL
+  @param  reset_value  Value stored to reset
+
+  @return ACS_STATUS_PASS, or ACS_STATUS_FAIL if the other PEs did not
+          arrive in time
+ **/
+static uint32_t
+sync_barrier_arrive(val_sync_barrier_t *barrier, uint32_t sense,
+                    volatile uint64_t *reset, uint64_t reset_value)
+{
+  val_deadline_t deadline;
+  uint64_t ctl;
+
+  if (val_sync_atomic_add32(&barrier->count, 1) == barrier->num_pe - 1) {
+      /* No PE can arrive for the next round before the sense flips */
+      barrier->count = 0;
+      if (reset != NULL)
+          *reset = reset_value;
+      sync_store_release32(&barrier->sense, sense ^ 1);
+      dsbish();
+      sev();
+      return ACS_STATUS_PASS;
+  }
+
+  if (sync_load_acquire32(&barrier->sense) != sense)
+      return ACS_STATUS_PASS;
+
+  val_deadline_start(&deadline, TIMEOUT_LARGE_US);
+  ctl = val_wait_event_stream_enable();
+  while (sync_load_acquire32(&barrier->sense) == sense && !val_deadline_wait_event(&deadline))
+      ;
+  val_wait_event_stream_restore(ctl);
+
+  if (val_deadline_timed_out(&deadline) && sync_load_acquire32(&barrier->sense) == sense)
+      return ACS_STATUS_FAIL;
+
+  return ACS_STATUS_PASS;
+}
+
+/**
+  @brief  Waits in WFE until all PEs of the barrier arrived. The last PE to
+          arrive flips the barrier sense and sends an event.
+          1. Caller       - Test payloads on each PE taking part
+          2. Prerequisite - val_sync_barrier_init
+
+  @param  barrier  Barrier to wait at
+
+  @return ACS_STATUS_PASS, or ACS_STATUS_FAIL if the other PEs did not
+          arrive within TIMEOUT_LARGE_US
+ **/
+uint32_t
+val_sync_barrier_wait(val_sync_barrier_t *barrier)
+{
+  /* The sense cannot flip before this PE arrives */
+  return sync_barrier_arrive(barrier, sync_load_acquire32(&barrier->sense), NULL, 0);
+}
+
+static inline uint64_t
+sync_reduce_identity(uint32_t op)
+{
+  return (op == VAL_SYNC_REDUCE_MIN) ? ~(uint64_t)0 : 0;
+}
+
+/**
+  @brief  Sets up a reduction of one value per PE.
+          1. Caller       - Test payload on the primary PE
+          2. Prerequisite - None, before any PE uses the reduction
+
+  @param  reduce  Reduction to set up
+  @param  num_pe  Number of PEs taking part, including the caller if it does
+  @param  op      Sum, minimum or maximum
+
+  @return None
+ **/
+void
+val_sync_reduce_init(val_sync_reduce_t *reduce, uint32_t num_pe, val_sync_reduce_op_t op)
+{
+  reduce->op = op;
+  reduce->value[0] = sync_reduce_identity(op);
+  reduce->value[1] = sync_reduce_identity(op);
+  val_pe_cache_clean_invalidate_range((uint64_t)(uintptr_t)reduce->value,
+                                      sizeof(reduce->value) + sizeof(reduce->op));
+  val_sync_barrier_init(&reduce->barrier, num_pe);
+}
+
+/**
+  @brief  Combines the value of the calling PE with those of the other PEs
+          and returns the result once all of them contributed. Rounds
+          alternate between two values; the last PE of a round resets the
+          one of the next round, which every PE finished reading since.
+          1. Caller       - Test payloads on each PE taking part
+          2. Prerequisite - val_sync_reduce_init
+
+  @param  reduce  Reduction
+  @param  value   Value of the calling PE
+  @param  result  Combined value of all PEs
+
+  @return ACS_STATUS_PASS, or ACS_STATUS_FAIL if the other PEs did not
+          contribute within TIMEOUT_LARGE_US
+ **/
+uint32_t
+val_sync_reduce(val_sync_reduce_t *reduce, uint64_t value, uint64_t *result)
+{
+  uint32_t sense = sync_load_acquire32(&reduce->barrier.sense);
+  volatile uint64_t *slot = &reduce->value[sense];
+  uint32_t status;
+
+  if (reduce->op == VAL_SYNC_REDUCE_MIN)
+      val_sync_atomic_min64(slot, value);
+  else if (reduce->op == VAL_SYNC_REDUCE_MAX)
+      val_sync_atomic_max64(slot, value);
+  else
+      val_sync_atomic_add64(slot, value);
+
+  status = sync_barrier_arrive(&reduce->barrier, sense, &reduce->value[sense ^ 1],
+                               sync_reduce_identity(reduce->op));
+
+  *result = sync_load_acquire64(slot);
+  return status;
+}
+
+/**
+  @brief  Sets up a start gate for a number of PEs. A gate releases its PEs
+          once; set it up again before the next use.
+          1. Caller       - Test payload on the primary PE
+          2. Prerequisite - None, before any PE uses the gate
+
+  @param  gate     Gate to set up
+  @param  num_pe   Number of PEs taking part, including the caller if it does
+  @param  lead_us  Time from the last arrival to the release, enough for the
+                   waiting PEs to leave WFE; 0 for VAL_SYNC_GATE_LEAD_US
+
+  @return None
+ **/
+void
+val_sync_gate_init(val_sync_gate_t *gate, uint32_t num_pe, uint64_t lead_us)
+{
+  uint64_t freq = read_cntfrq_el0();
+
+  if (lead_us == 0)
+      lead_us = VAL_SYNC_GATE_LEAD_US;
+
+  gate->count = 0;
+  gate->num_pe = num_pe;
+  gate->release = 0;
+  gate->lead_ticks = (lead_us * freq) / 1000000;
+  val_pe_cache_clean_invalidate_range((uint64_t)(uintptr_t)gate, sizeof(*gate));
+}
+
+/**
+  @brief  Waits until all PEs of the gate arrived, then until the release
+          time the last PE published. The PEs spin on the generic counter,
+          shared by all of them, for the last part, so they leave the gate
+          within a few counter ticks of each other rather than with the skew
+          of their wake-up from WFE.
+          1. Caller       - Test payloads on each PE taking part
+          2. Prerequisite - val_sync_gate_init
+
+  @param  gate  Gate to wait at
+
+  @return ACS_STATUS_PASS, or ACS_STATUS_FAIL if the other PEs did not
+          arrive within TIMEOUT_LARGE_US
+ **/
+uint32_t
+val_sync_gate_wait(val_sync_gate_t *gate)
+{
+  val_deadline_t deadline;
+  uint64_t release;
+  uint64_t ctl;
+
+  if (val_sync_atomic_add32(&gate->count, 1) == gate->num_pe - 1) {
+      release = virtualcounter_read() + gate->lead_ticks;
+      sync_store_release64(&gate->release, release);
+      dsbish();
+      sev();
+  } else {
+      release = sync_load_acquire64(&gate->release);
+      if (release == 0) {
+          val_deadline_start(&deadline, TIMEOUT_LARGE_US);
+          ctl = val_wait_event_stream_enable();
+          while ((release = sync_load_acquire64(&gate->release)) == 0 &&
+                 !val_deadline_wait_event(&deadline))
+              ;
+          val_wait_event_stream_restore(ctl);
+
+          if (release == 0)
+              return ACS_STATUS_FAIL;
+      }
+  }
+
+  while (virtualcounter_read() < release)
+      ;
+
+  return ACS_STATUS_PASS;
+}
+
+/* Shared by the PEs of val_sync_benchmark */
+static struct {
+  val_sync_barrier_t barrier;
+  val_sync_gate_t    gate;
+  val_sync_reduce_t  skew;
+  uint32_t           rounds;
+} g_sync_bench;
+
+/**
+  @brief  Part of val_sync_benchmark run by every PE: the barrier rounds,
+          then the gate, then a maximum reduction of how late each PE saw
+          the release.
+
+  @param  skew  Latest exit from the gate, in counter ticks after the release
+
+  @return ACS_STATUS_PASS, or ACS_STATUS_FAIL on a timeout
+ **/
+static uint32_t
+sync_bench_run(uint64_t *skew)
+{
+  uint32_t round;
+
+  for (round = 0; round < g_sync_bench.rounds; round++) {
+      if (val_sync_barrier_wait(&g_sync_bench.barrier) != ACS_STATUS_PASS)
+          return ACS_STATUS_FAIL;
+  }
+
+  if (val_sync_gate_wait(&g_sync_bench.gate) != ACS_STATUS_PASS)
+      return ACS_STATUS_FAIL;
+
+  return val_sync_reduce(&g_sync_bench.skew,
+                         virtualcounter_read() - g_sync_bench.gate.release, skew);
+}
+
+static void
+sync_bench_payload(void)
+{
+  uint32_t index = val_pe_get_index_mpid(val_pe_get_mpid());
+  uint64_t skew;
+
+  if (sync_bench_run(&skew) == ACS_STATUS_PASS)
+      val_set_status(index, RESULT_PASS);
+  else
+      val_set_status(index, RESULT_FAIL(1));
+}
+
+static uint64_t
+sync_ticks_to_ns(uint64_t ticks, uint64_t freq)
+{
+  return (freq != 0) ? (ticks / freq) * 1000000000 + ((ticks % freq) * 1000000000) / freq : 0;
+}
+
+/**
+  @brief  Measures the barrier latency and the start gate skew with 2, 4, 8..
+          PEs up to max_pe, and prints them. The primary PE takes part and
+          the secondary PEs are woken with val_execute_on_pe.
+          1. Caller       - Orchestrator, with ACS_SYNC_BENCHMARK
+          2. Prerequisite - val_allocate_shared_mem, val_create_peinfo_table
+
+  @param  max_pe  Largest number of PEs to measure with
+
+  @return None
+ **/
+void
+val_sync_benchmark(uint32_t max_pe)
+{
+  uint32_t primary = val_pe_get_index_mpid(val_pe_get_mpid());
+  uint32_t num_pe = val_pe_get_num();
+  uint64_t freq = read_cntfrq_el0();
+  val_deadline_t deadline;
+  uint32_t status;
+  uint32_t woken;
+  uint32_t index;
+  uint32_t round;
+  uint32_t n;
+  uint64_t start;
+  uint64_t ticks;
+  uint64_t skew;
+
+  if (max_pe > num_pe)
+      max_pe = num_pe;
+  if (max_pe < 2)
+      return;
+
+  val_print(INFO, "\n Multi-PE synchronization latency (%s atomics)",
+            val_pe_has_lse_atomics() ? "LSE" : "exclusive");
+
+  for (n = 2; ; n *= 2) {
+      /* Powers of two, and max_pe last */
+      if (n > max_pe)
+          n = max_pe;
+
+      g_sync_bench.rounds = SYNC_BENCH_ROUNDS;
+      val_pe_cache_clean_invalidate_range((uint64_t)(uintptr_t)&g_sync_bench.rounds,
+                                          sizeof(g_sync_bench.rounds));
+      val_sync_barrier_init(&g_sync_bench.barrier, n);
+      val_sync_gate_init(&g_sync_bench.gate, n, 0);
+      val_sync_reduce_init(&g_sync_bench.skew, n, VAL_SYNC_REDUCE_MAX);
+
+      woken = 0;
+      for (index = 0; index < num_pe && woken < n - 1; index++) {
+          if (index == primary)
+              continue;
+          val_set_status(index, RESULT_PENDING(0));
+          val_execute_on_pe(index, sync_bench_payload, 0);
+          woken++;
+      }
+
+      /* The first round waits for the wake-ups, time the others */
+      status = val_sync_barrier_wait(&g_sync_bench.barrier);
+      start = virtualcounter_read();
+      for (round = 1; round < SYNC_BENCH_ROUNDS && status == ACS_STATUS_PASS; round++)
+          status = val_sync_barrier_wait(&g_sync_bench.barrier);
+      ticks = virtualcounter_read() - start;
+
+      if (status == ACS_STATUS_PASS)
+          status = val_sync_gate_wait(&g_sync_bench.gate);
+      if (status == ACS_STATUS_PASS)
+          status = val_sync_reduce(&g_sync_bench.skew,
+                                   virtualcounter_read() - g_sync_bench.gate.release, &skew);
+
+      /* Wait for the secondary PEs to finish before reusing the objects */
+      val_deadline_start(&deadline, TIMEOUT_LARGE_US);
+      woken = 0;
+      for (index = 0; index < num_pe && woken < n - 1; index++) {
+          if (index == primary)
+              continue;
+          while (IS_RESULT_PENDING(val_get_status(index)) && !val_deadline_expired(&deadline))
+              ;
+          woken++;
+      }
+
+      if (status != ACS_STATUS_PASS || val_deadline_timed_out(&deadline)) {
+          val_print(WARN, "\n   %4d PEs : timed out, stopping the measurement", n);
+          return;
+      }
+
+      val_print(INFO, "\n   %4d PEs : barrier %6ld ns", n,
+                sync_ticks_to_ns(ticks, freq) / (SYNC_BENCH_ROUNDS - 1));
+      val_print(INFO, ", start gate skew %6ld ns", sync_ticks_to_ns(skew, freq));
+
+      if (n == max_pe)
+          break;
+  }
+}
+
+#endif /* TARGET_LINUX */
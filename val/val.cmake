@@ -58,6 +58,23 @@ function(acs_add_val_library)
     # Apply only the per-ACS compile definitions that were collected upstream.
     target_compile_definitions(${VAL_LIB} PRIVATE ${VAL_EXTRA_DEFS})
 
+    # Fail the build if rule_registry_gen.c no longer matches the rule sources,
+    # rather than falling back to the linear rule name scan at run time.
+    list(FIND VAL_SRC "${ROOT_DIR}/val/src/rule_registry_gen.c" _registry_index)
+    if(NOT _registry_index EQUAL -1)
+        find_package(Python3 COMPONENTS Interpreter)
+        if(Python3_Interpreter_FOUND)
+            add_custom_target(${VAL_LIB}_rule_registry_check
+                COMMAND ${Python3_EXECUTABLE} tools/scripts/gen_rule_registry.py --check
+                WORKING_DIRECTORY ${ROOT_DIR}
+                COMMENT "Checking val/src/rule_registry_gen.c is up to date"
+            )
+            add_dependencies(${VAL_LIB} ${VAL_LIB}_rule_registry_check)
+        else()
+            message(WARNING "[ACS] : Python3 not found, rule registry not checked")
+        endif()
+    endif()
+
     target_include_directories(${VAL_LIB} PRIVATE
         ${CMAKE_CURRENT_BINARY_DIR}
         ${ROOT_DIR}/
@@ -135,8 +152,14 @@ function(acs_add_val_library_for_acs ACS_NAME)
             "${ROOT_DIR}/val/src/rule_based_execution_helpers.c"
             "${ROOT_DIR}/val/src/rule_based_orchestrator.c"
             "${ROOT_DIR}/val/src/rule_enum_string_map.c"
+            "${ROOT_DIR}/val/src/rule_registry.c"
+            "${ROOT_DIR}/val/src/rule_registry_gen.c"
             "${ROOT_DIR}/val/src/rule_lookup.c"
             "${ROOT_DIR}/val/src/rule_metadata.c"
+            "${ROOT_DIR}/val/src/rule_budget.c"
+            "${ROOT_DIR}/val/src/rule_checkpoint.c"
+            "${ROOT_DIR}/val/src/rule_profile.c"
+            "${ROOT_DIR}/val/src/rule_result_sink.c"
             "${ROOT_DIR}/val/src/acs_exerciser.c"
             "${ROOT_DIR}/val/src/rule_based_execution_enum.h"
         )